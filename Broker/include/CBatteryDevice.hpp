@@ -32,7 +32,7 @@
 #ifndef CBATTERYDEVICE_HPP
 #define CBATTERYDEVICE_HPP
 
-#include "CLineClient.hpp"
+#include "CLineClientPool.hpp"
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
@@ -47,7 +47,7 @@ namespace freedm {
 		class CBatteryDevice : public CPSCADDevice { 
 		public:
 			//constructor
-			CBatteryDevice(CLineClient::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid);
+			CBatteryDevice(CLineClientPool::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid);
 
 			typedef boost::shared_ptr<CBatteryDevice> BatteryDevicePtr;
 
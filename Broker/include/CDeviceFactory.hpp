@@ -57,7 +57,8 @@ public:
     /// Creates an instance of a device factory
     CDeviceFactory( CPhysicalDeviceManager & p_devman,
         boost::asio::io_service & p_ios, const std::string & p_host,
-        const std::string & p_port );
+        const std::string & p_port, size_t p_connections = 1,
+        long p_stepTimeout = 0 );
 
     /// Delegates the creation of a device to the managed device factory
     virtual void CreateDevice( const std::string & p_type,
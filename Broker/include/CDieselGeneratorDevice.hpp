@@ -32,7 +32,7 @@
 #ifndef CDIESELGENERATORDEVICE_HPP
 #define CDIESELGENERATORDEVICE_HPP
 
-#include "CLineClient.hpp"
+#include "CLineClientPool.hpp"
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
@@ -47,7 +47,7 @@ namespace freedm {
 		class CDieselGeneratorDevice : public CPSCADDevice { 
 		public:
 			//constructor
-			CDieselGeneratorDevice(CLineClient::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid);
+			CDieselGeneratorDevice(CLineClientPool::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid);
       
 			typedef boost::shared_ptr<CDieselGeneratorDevice> DieselGeneratorDevicePtr;
 
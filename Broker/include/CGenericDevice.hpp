@@ -36,6 +36,8 @@
 #include "IPhysicalDevice.hpp"
 #include "PhysicalDeviceTypes.hpp"
 
+#include <vector>
+
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
@@ -56,14 +58,17 @@ class CGenericDevice
         CGenericDevice(CPhysicalDeviceManager& phymanager, Identifier deviceid, DeviceType devType);
 
         /// Pulls the setting of some key from the inside.
-        SettingValue Get(SettingKey key);
+        SettingValue Get(SettingKeyId key);
 
         /// Sets the value of some key to the input value.
-        void Set(SettingKey key, SettingValue value);
+        void Set(SettingKeyId key, SettingValue value);
+
+        using IPhysicalDevice::Get;
+        using IPhysicalDevice::Set;
         
     private:
-        /// The Settings Register
-        std::map<SettingKey,SettingValue> m_register;
+        /// The Settings Register, indexed by interned key
+        std::vector<SettingValue> m_register;
 };
 
     } // Namespace broker
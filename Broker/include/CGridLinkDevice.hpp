@@ -32,7 +32,7 @@
 #ifndef CGRIDLINKDEVICE_HPP
 #define CGRIDLINKDEVICE_HPP
 
-#include "CLineClient.hpp"
+#include "CLineClientPool.hpp"
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
@@ -48,7 +48,7 @@ namespace freedm {
 		class CGridLinkDevice : public CPSCADDevice { 
 		public:
 			//constructor
-			CGridLinkDevice(CLineClient::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid);
+			CGridLinkDevice(CLineClientPool::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid);
       
 			typedef boost::shared_ptr<CGridLinkDevice> GridLinkDevicePtr;
 
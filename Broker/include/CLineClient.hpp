@@ -16,6 +16,8 @@
 ///     CLineClient::Set( const string &, const string &, const string & )
 ///     CLineClient::Get( const string &, const string & )
 ///     CLineClient::Quit()
+///     CLineClient::Close()
+///     CLineClient::IsOpen() const
 ///
 /// These source code files were created at the Missouri University of Science
 /// and Technology, and are intended for use in teaching or research. They may
@@ -35,11 +37,17 @@
 #ifndef C_LINE_CLIENT
 #define C_LINE_CLIENT
 
+#include <map>
 #include <string>
+#include <vector>
+#include <cstring>
+#include <utility>
 #include <iostream>
 #include <stdexcept>
 
 #include <boost/asio.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/utility.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -54,8 +62,14 @@ namespace freedm{
 ///     the unique identifier of some physical hardware and Key is the variable
 ///     name of that hardware to be manipulated.
 ///
+///     On connect the client requests binary framing from the server. When the
+///     server accepts, each (Device,Key) pair is resolved to a handle once and
+///     values cross the wire as raw IEEE-754 doubles in fixed-size frames. An
+///     older server that rejects the request is driven in text mode instead.
+///
 /// @limitations
-///     none
+///     A client carries one request at a time and is not safe to share across
+///     threads. Use CLineClientPool to share clients between devices.
 ///
 ////////////////////////////////////////////////////////////////////////////////
 class CLineClient : private boost::noncopyable
@@ -158,6 +172,135 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     std::string Get( const std::string p_device, const std::string p_key );
     
+    ////////////////////////////////////////////////////////////////////////////
+    /// SetValue( const string &, const string &, double )
+    ///
+    /// @description
+    ///     Sends a set request to the line server with a numeric set value.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Throws an exception if the server does not acknowledge the request.
+    ///
+    /// @pre
+    ///     The socket connection has been established with a call to Connect
+    ///
+    /// @post
+    ///     Resolves (p_device,p_key) to a handle if not yet resolved
+    ///     Writes a set frame to m_socket and reads its acknowledgement
+    ///
+    /// @param
+    ///     p_device is the unique identifier of the target device
+    ///     p_key is the variable of the target device to modify
+    ///     p_value is the value to set for p_device's p_key
+    ///
+    /// @limitations
+    ///     Falls back to a text request if binary framing was not negotiated.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void SetValue( const std::string & p_device, const std::string & p_key, double p_value );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// GetValue( const string &, const string & )
+    ///
+    /// @description
+    ///     Sends a get request to the line server and returns a numeric value.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Throws an exception if the server does not respond to the request.
+    ///
+    /// @pre
+    ///     The socket connection has been established with a call to Connect
+    ///
+    /// @post
+    ///     Resolves (p_device,p_key) to a handle if not yet resolved
+    ///     Writes a get frame to m_socket and reads its response
+    ///
+    /// @param
+    ///     p_device is the unique identifier of the target device
+    ///     p_key is the variable of the target device to access
+    ///
+    /// @return
+    ///     p_device's p_key as determined by the line server response
+    ///
+    /// @limitations
+    ///     Falls back to a text request if binary framing was not negotiated.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    double GetValue( const std::string & p_device, const std::string & p_key );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// WaitForStep( uint64_t, long )
+    ///
+    /// @description
+    ///     Blocks until the line server has a simulation step newer than the
+    ///     given version, or until the timeout expires. The server still holds
+    ///     a request that expired, so the socket is closed to discard its late
+    ///     response and the client reconnects on its next lease.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Throws an exception if the server does not respond to the request.
+    ///
+    /// @pre
+    ///     The socket connection has been established with a call to Connect
+    ///
+    /// @post
+    ///     Writes a wait request to m_socket and reads its response
+    ///     Closes m_socket if the timeout expires
+    ///
+    /// @param
+    ///     p_version is the last step version seen by the caller, or 0
+    ///     p_timeout is the longest wait in milliseconds
+    ///
+    /// @return
+    ///     the step version of the server, or p_version if the wait expired
+    ///
+    /// @limitations
+    ///     Falls back to a text request if binary framing was not negotiated.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    boost::uint64_t WaitForStep( boost::uint64_t p_version, long p_timeout );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// FinishStep( uint64_t )
+    ///
+    /// @description
+    ///     Tells the line server that this broker has issued its commands for
+    ///     a simulation step. A server in lockstep mode holds the next step
+    ///     until every broker has finished the current one.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Throws an exception if the server does not respond to the request.
+    ///
+    /// @pre
+    ///     The socket connection has been established with a call to Connect
+    ///
+    /// @post
+    ///     Writes a done request to m_socket and reads its response
+    ///
+    /// @param
+    ///     p_version is the step version returned by WaitForStep
+    ///
+    /// @limitations
+    ///     Falls back to a text request if binary framing was not negotiated.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void FinishStep( boost::uint64_t p_version );
+    
+    /// true if the server accepted binary framing
+    bool IsBinary() const { return m_binary; }
+    
     ////////////////////////////////////////////////////////////////////////////
     /// Quit
     ///
@@ -184,6 +327,33 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     void Quit();
     
+    ////////////////////////////////////////////////////////////////////////////
+    /// Close
+    ///
+    /// @description
+    ///     Closes the socket without notifying the line server.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     m_socket is closed
+    ///
+    /// @limitations
+    ///     Used to discard a connection whose stream state is unknown.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void Close();
+    
+    /// true if the socket is connected
+    bool IsOpen() const { return m_socket.is_open(); }
+    
     ////////////////////////////////////////////////////////////////////////////
     /// ~CLineClient
     ///
@@ -235,8 +405,43 @@ private:
     ////////////////////////////////////////////////////////////////////////////
     CLineClient( boost::asio::io_service & p_service );
     
+    /// size in bytes of a binary frame header
+    static const size_t FRAME_SIZE = 16;
+    
+    /// binary frame types, must match the line server
+    enum EOpcode { OP_RESOLVE = 1, OP_GET = 2, OP_SET = 3, OP_QUIT = 4, OP_WAIT = 5, OP_DONE = 6 };
+    
+    /// binary frame status codes, must match the line server
+    enum EStatus { STATUS_OK = 0, STATUS_NOTFOUND = 1, STATUS_BADREQUEST = 2 };
+    
+    /// requests binary framing from the server after a connect
+    void Negotiate();
+    
+    /// returns the server handle for (p_device,p_key), resolving if needed
+    boost::uint32_t Resolve( const std::string & p_device, const std::string & p_key );
+    
+    /// sends one binary frame, returns the response value and stores its handle
+    double Exchange( unsigned char p_opcode, boost::uint32_t & p_handle,
+        double p_value, const std::string & p_payload = std::string() );
+    
+    /// writes one binary request frame followed by its payload
+    void SendFrame( unsigned char p_opcode, boost::uint32_t p_handle,
+        double p_value, const std::string & p_payload );
+    
+    /// reads one binary response frame, returns its value and stores its handle
+    double ReceiveFrame( boost::uint32_t & p_handle );
+    
+    /// waits up to p_timeout milliseconds for a response, false on expiry
+    bool WaitReadable( long p_timeout );
+    
     /// socket to line protocol server
     boost::asio::ip::tcp::socket m_socket;
+    
+    /// true if the server accepted binary framing
+    bool m_binary;
+    
+    /// handles resolved on the current connection
+    std::map<std::pair<std::string,std::string>, boost::uint32_t> m_handles;
 };
 
   }//namespace broker
@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CLineClientPool.hpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @description
+///     Pool of line protocol clients shared by the PSCAD devices.
+///
+/// @functions
+///     CLineClientPool::Create( io_service &, const string &, const string &, size_t )
+///     CLineClientPool::CLease::CLease( CLineClientPool & )
+///     CLineClientPool::CLease::operator->() const
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_LINE_CLIENT_POOL
+#define C_LINE_CLIENT_POOL
+
+#include <string>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/utility.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include "CLineClient.hpp"
+
+namespace freedm{
+  namespace broker{
+////////////////////////////////////////////////////////////////////////////////
+/// CLineClientPool
+///
+/// @description
+///     A fixed set of line clients connected to the same line server. A
+///     CLineClient carries one request at a time on its socket, so each
+///     request checks out a client with a CLease and returns it when the
+///     lease is destroyed. Requests from different threads run in parallel
+///     up to the pool size and never interleave on one socket.
+///
+/// @limitations
+///     The line server must serve concurrent connections for a pool size
+///     greater than one to make progress.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CLineClientPool : private boost::noncopyable
+{
+public:
+    typedef boost::shared_ptr<CLineClientPool> TPointer;
+    static TPointer Create( boost::asio::io_service & p_service,
+        const std::string p_hostname, const std::string p_port, size_t p_size );
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// CLease
+    ///
+    /// @description
+    ///     Exclusive use of one pooled client for the lifetime of the lease.
+    ///
+    /// @limitations
+    ///     A lease must not outlive its pool.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    class CLease : private boost::noncopyable
+    {
+    public:
+        ////////////////////////////////////////////////////////////////////////
+        /// CLease( CLineClientPool & )
+        ///
+        /// @description
+        ///     Checks out an idle client, blocking until one is available.
+        ///
+        /// @Shared_Memory
+        ///     the idle list of p_pool is modified
+        ///
+        /// @Error_Handling
+        ///     Throws an exception if a closed client fails to reconnect.
+        ///
+        /// @pre
+        ///     none
+        ///
+        /// @post
+        ///     the leased client is connected and removed from the idle list
+        ///
+        /// @param
+        ///     p_pool is the pool to check out a client from
+        ///
+        /// @limitations
+        ///     none
+        ///
+        ////////////////////////////////////////////////////////////////////////
+        explicit CLease( CLineClientPool & p_pool );
+
+        ////////////////////////////////////////////////////////////////////////
+        /// ~CLease
+        ///
+        /// @description
+        ///     Returns the client to the pool. If the lease ends because of an
+        ///     exception the client is closed, since its socket may hold part
+        ///     of an unfinished exchange, and it reconnects on its next lease.
+        ///
+        /// @Shared_Memory
+        ///     the idle list of the pool is modified
+        ///
+        /// @Error_Handling
+        ///     none
+        ///
+        /// @pre
+        ///     none
+        ///
+        /// @post
+        ///     the client is idle and one waiting lease is woken
+        ///
+        /// @limitations
+        ///     none
+        ///
+        ////////////////////////////////////////////////////////////////////////
+        ~CLease();
+
+        /// access to the leased client
+        CLineClient * operator->() const { return m_client.get(); }
+    private:
+        /// pool the client is returned to
+        CLineClientPool & m_pool;
+
+        /// client checked out for this lease
+        CLineClient::TPointer m_client;
+    };
+
+    /// number of clients in the pool
+    size_t Size() const { return m_clients.size(); }
+private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// CLineClientPool( io_service &, const string &, const string &, size_t )
+    ///
+    /// @description
+    ///     Creates and connects p_size clients to the given endpoint.
+    ///
+    /// @Shared_Memory
+    ///     Uses the passed io_service until destroyed.
+    ///
+    /// @Error_Handling
+    ///     Throws std::invalid_argument if p_size is zero, since every lease
+    ///     would wait forever, or an exception if a client cannot connect.
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     every client is connected and idle
+    ///
+    /// @param
+    ///     p_service is the io_service the sockets run on
+    ///     p_hostname is the hostname of the line server
+    ///     p_port is the port number of the line server
+    ///     p_size is the number of clients to create
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    CLineClientPool( boost::asio::io_service & p_service,
+        const std::string p_hostname, const std::string p_port, size_t p_size );
+
+    /// removes an idle client from the pool, waiting for one if necessary
+    CLineClient::TPointer Checkout();
+
+    /// returns a client to the idle list
+    void Return( CLineClient::TPointer p_client, bool p_broken );
+
+    /// hostname of the line server for reconnects
+    std::string m_hostname;
+
+    /// port of the line server for reconnects
+    std::string m_port;
+
+    /// every client owned by the pool
+    std::vector<CLineClient::TPointer> m_clients;
+
+    /// clients that are not leased
+    std::vector<CLineClient::TPointer> m_idle;
+
+    /// protects m_idle
+    boost::mutex m_mutex;
+
+    /// signalled when a client is returned to m_idle
+    boost::condition_variable m_available;
+};
+
+  }//namespace broker
+}//namespace freedm
+
+#endif // C_LINE_CLIENT_POOL
@@ -32,7 +32,7 @@
 #ifndef CLOADDEVICE_HPP
 #define CLOADDEVICE_HPP
 
-#include "CLineClient.hpp"
+#include "CLineClientPool.hpp"
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
@@ -47,7 +47,7 @@ namespace freedm {
 		class CLoadDevice : public CPSCADDevice { 
 		public:
 			//constructor
-			CLoadDevice(CLineClient::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid);
+			CLoadDevice(CLineClientPool::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid);
       
 			typedef boost::shared_ptr<CLoadDevice> LoadDevicePtr;
 
@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////////////
+/// @file      CLogWriter.hpp
+///
+/// @author    Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler  C++
+///
+/// @project   FREEDM DGI
+///
+/// @description Background writer that batches the output of the standard logs
+///
+/// @license
+/// These source code files were created at as part of the
+/// FREEDM DGI Subthrust, and are
+/// intended for use in teaching or research.  They may be
+/// freely copied, modified and redistributed as long
+/// as modified versions are clearly marked as such and
+/// this notice is not removed.
+///
+/// Neither the authors nor the FREEDM Project nor the
+/// National Science Foundation
+/// make any warranty, express or implied, nor assumes
+/// any legal responsibility for the accuracy,
+/// completeness or usefulness of these codes or any
+/// information distributed with these codes.
+///
+/// Suggested modifications or questions about these codes
+/// can be directed to Dr. Bruce McMillin, Department of
+/// Computer Science, Missour University of Science and
+/// Technology, Rolla, /// MO  65409 (ff@mst.edu).
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_LOG_WRITER_HPP
+#define C_LOG_WRITER_HPP
+
+#include <fstream>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/tss.hpp>
+
+namespace freedm {
+namespace broker {
+
+/// Writes the standard logs from a background thread. While a writer exists,
+/// a message that passes the log filter is copied into a ring owned by the
+/// thread that logged it, and the writer thread formats the rings and writes
+/// them in batches. A logging thread never takes a lock or waits on the
+/// output: when its ring is full the message is dropped and counted.
+class CLogWriter
+    : private boost::noncopyable
+{
+public:
+    /// Starts writing the logs to p_file, or to std::clog if it is empty
+    explicit CLogWriter(const std::string & p_file = "",
+        size_t p_capacity = DEFAULT_CAPACITY);
+
+    /// Writes the queued messages and returns the logs to direct output
+    ~CLogWriter();
+
+    /// Gets the number of messages dropped because a ring was full
+    boost::uint64_t Dropped() const
+        { return m_dropped.load(boost::memory_order_relaxed); };
+
+    /// Log sink that queues a message on the ring of the calling thread
+    static void Append(int p_level, const char * p_name, const char * p_text,
+        std::streamsize p_length);
+
+    /// Records per thread of a writer created with the default capacity
+    static const size_t DEFAULT_CAPACITY = 1024;
+
+    /// Characters of message text held by a single record
+    static const size_t RECORD_TEXT = 232;
+private:
+    /// Fixed-size piece of a message; long messages span several records
+    struct Record
+    {
+        /// Microseconds since the epoch, local time
+        boost::int64_t m_time;
+        /// The name of the log, which outlives the writer
+        const char * m_name;
+        /// The level of the log
+        boost::int16_t m_level;
+        /// The number of characters of m_text in use
+        boost::uint16_t m_length;
+        /// True if this record continues the text of the previous one
+        bool m_continued;
+        /// The message text
+        char m_text[RECORD_TEXT];
+    };
+
+    /// Records of one logging thread, written only by that thread
+    struct Ring
+    {
+        /// Creates an empty ring of p_capacity records, a power of two
+        explicit Ring(size_t p_capacity);
+
+        /// Slots indexed by record number modulo the capacity
+        boost::scoped_array<Record> m_records;
+        /// Capacity minus one
+        size_t m_mask;
+        /// The number of records the owning thread has queued
+        boost::atomic<boost::uint64_t> m_head;
+        /// The number of records the writer thread has taken
+        boost::atomic<boost::uint64_t> m_tail;
+    };
+
+    /// Orders records by the time they were logged
+    static bool Earlier(const Record & p_first, const Record & p_second);
+
+    /// Leaves a ring to m_rings when its thread exits
+    static void KeepRing(Ring * p_ring);
+
+    /// Gets the ring of the calling thread, creating it on first use
+    Ring & GetRing();
+
+    /// Queues a message on the ring of the calling thread
+    void Push(int p_level, const char * p_name, const char * p_text,
+        std::streamsize p_length);
+
+    /// Writes batches until the writer is destroyed
+    void Run();
+
+    /// Takes the queued records of every ring and writes them
+    size_t Flush();
+
+    /// The writer that Append forwards to, or NULL
+    static CLogWriter * s_instance;
+
+    /// The file opened for the output, if any
+    std::ofstream m_file;
+
+    /// The destination of the formatted messages
+    std::ostream * m_output;
+
+    /// Records per ring
+    size_t m_capacity;
+
+    /// Every ring created, guarded by m_ringMutex
+    std::vector<boost::shared_ptr<Ring> > m_rings;
+
+    /// Taken only to create a ring or to list them
+    boost::mutex m_ringMutex;
+
+    /// The ring of each thread, owned by m_rings
+    boost::thread_specific_ptr<Ring> m_localRing;
+
+    /// Records taken by the last flush, kept to reuse the storage
+    std::vector<Record> m_batch;
+
+    /// The messages dropped because a ring was full
+    boost::atomic<boost::uint64_t> m_dropped;
+
+    /// The drops already reported in the output
+    boost::uint64_t m_reported;
+
+    /// Set to make the writer thread exit after its next flush
+    boost::atomic<bool> m_stop;
+
+    /// The thread that formats and writes the records
+    boost::thread m_thread;
+};
+
+} // namespace broker
+} // namespace freedm
+
+#endif // C_LOG_WRITER_HPP
@@ -116,7 +116,7 @@ public:
     CMessage( CMessage::StatusType p_stat = CMessage::OK ) :
         m_status ( p_stat )
     {
-        Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+        LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     };
 
     /// Copy Constructor
@@ -127,7 +127,7 @@ public:
         m_hostname( p_m.m_hostname ),
         m_sequenceno( p_m.m_sequenceno )
     {
-        Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+        LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     };
 
     /// Cmessage Equals operator
@@ -151,7 +151,7 @@ public:
     /// A Generic reply CMessage
     static CMessage StockReply( StatusType p_status )
     {
-        Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+        LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
         CMessage reply_;
         reply_.m_status = p_status;
 
@@ -37,7 +37,7 @@
 #include <boost/noncopyable.hpp>
 #include "IPhysicalDevice.hpp"
 #include "CPhysicalDeviceManager.hpp"
-#include "CLineClient.hpp"
+#include "CLineClientPool.hpp"
 #include "PhysicalDeviceTypes.hpp"
 
 namespace freedm {
@@ -48,13 +48,16 @@ namespace freedm {
 		{
 		protected:
 			/// Constructor
-			CPSCADDevice(CLineClient::TPointer lineClient, CPhysicalDeviceManager& phymanager, Identifier deviceid = "pscad", DeviceType devtype =  physicaldevices::FREEDM_GENERIC);  
+			CPSCADDevice(CLineClientPool::TPointer lineClient, CPhysicalDeviceManager& phymanager, Identifier deviceid = "pscad", DeviceType devtype =  physicaldevices::FREEDM_GENERIC);  
          
 			/// Pulls the setting of some key from PSCAD.
-			SettingValue Get(SettingKey key);
+			SettingValue Get(SettingKeyId key);
 
 			/// Sets the value of some key to PSCAD.
-			void Set(SettingKey key, SettingValue value);
+			void Set(SettingKeyId key, SettingValue value);
+
+			using IPhysicalDevice::Get;
+			using IPhysicalDevice::Set;
 
 		        //turn the device on
 		        virtual void turnOn() = 0;
@@ -66,8 +69,8 @@ namespace freedm {
 		        virtual SettingValue get_powerLevel() = 0;
         
 		private:
-			///pointer to lineClient
-			CLineClient::TPointer m_lineClient;
+			///pool of line clients shared with the other PSCAD devices
+			CLineClientPool::TPointer m_lineClient;
 		};
 
 	} // namespace broker
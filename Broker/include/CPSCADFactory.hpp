@@ -35,11 +35,12 @@
 
 #include <string>
 
+#include <boost/cstdint.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/asio/io_service.hpp>
 
 #include "logger.hpp"
-#include "CLineClient.hpp"
+#include "CLineClientPool.hpp"
 #include "ICreateDevice.hpp"
 #include "IPhysicalDevice.hpp"
 #include "CPhysicalDeviceManager.hpp"
@@ -62,7 +63,7 @@ public:
     /// Creates an instance of a PSCAD device factory
     CPSCADFactory( CPhysicalDeviceManager & p_devman,
         boost::asio::io_service & p_ios, const std::string & p_host,
-        const std::string & p_port );
+        const std::string & p_port, size_t p_connections, long p_stepTimeout );
 
     /// Creates the family of PSCAD-enabled devices
     virtual void CreateDevice( const std::string & p_type,
@@ -71,11 +72,23 @@ private:
     /// Convenience type for device pointers
     typedef IPhysicalDevice::DevicePtr DevicePtr;
     
+    /// Waits until the simulation has a step newer than m_step, false if none
+    bool WaitForStep();
+    
+    /// Tells the simulation that the commands for m_step have been issued
+    void FinishStep();
+    
     /// Device manager to store created devices
     CPhysicalDeviceManager & m_manager;
     
-    /// Client to the PSCAD simulation server
-    CLineClient::TPointer m_client;
+    /// Clients to the PSCAD simulation server shared by every device
+    CLineClientPool::TPointer m_client;
+    
+    /// The last simulation step returned by the server, or 0
+    boost::uint64_t m_step;
+    
+    /// Milliseconds to wait for each simulation step, 0 if not in lockstep
+    long m_stepTimeout;
 };
 
 } // namespace broker
@@ -32,7 +32,7 @@
 #ifndef CPVDEVICE_HPP
 #define CPVDEVICE_HPP
 
-#include "CLineClient.hpp"
+#include "CLineClientPool.hpp"
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
@@ -47,7 +47,7 @@ namespace freedm {
 		class CPVDevice : public CPSCADDevice { 
 		public:
 			//constructor
-			CPVDevice(CLineClient::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid);
+			CPVDevice(CLineClientPool::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid);
       
 			typedef boost::shared_ptr<CPVDevice> PVDevicePtr;
 
@@ -37,6 +37,8 @@
 
 #include <string>
 #include <map>
+#include <vector>
+#include <boost/function.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
@@ -55,6 +57,12 @@ public:
                      IPhysicalDevice::DevicePtr> PhysicalDeviceSet;
     /// A typedef providing and iertaror for this object
     typedef PhysicalDeviceSet::iterator iterator;
+    /// A typedef for the contiguous list of devices that share a type
+    typedef std::vector<IPhysicalDevice::DevicePtr> DeviceList;
+    /// A typedef for the call that waits for a simulation step, false if none
+    typedef boost::function<bool ()> BeginHook;
+    /// A typedef for the call that ends a simulation step
+    typedef boost::function<void ()> StepHook;
     /// Initialize the physical device manger
     CPhysicalDeviceManager();
 
@@ -77,9 +85,52 @@ public:
     /// Gives a count of connected devices
     size_t DeviceCount() const;
 
+    /// Gives a count of connected devices of the given type
+    size_t DeviceCount(IPhysicalDevice::DeviceType type) const;
+
+    /// Gets the devices of the given type
+    const DeviceList & GetDevicesOfType(IPhysicalDevice::DeviceType type) const;
+
+    /// Reads the current power level of every device into the cache
+    void RefreshPowerLevels();
+
+    /// Sums the cached power levels of the devices of the given type
+    IPhysicalDevice::SettingValue GetNetPowerLevel(
+        IPhysicalDevice::DeviceType type) const;
+
+    /// Sets the calls made at the start and the end of each control cycle
+    void SetStepHooks(BeginHook begin, StepHook finish);
+
+    /// Waits for the next simulation step before the devices are read
+    bool BeginStep();
+
+    /// Reports that the commands of the current step have been issued
+    void FinishStep();
+
 private:
+    /// Devices of one type with their cached power levels in parallel arrays
+    struct TypeIndex
+    {
+        /// The devices of this type
+        DeviceList m_devices;
+        /// The last power level read from each device in m_devices
+        std::vector<IPhysicalDevice::SettingValue> m_powerLevels;
+    };
+
+    /// Removes a device from the index of its type
+    void RemoveFromTypeIndex(IPhysicalDevice::DevicePtr resource);
+
     /// Mapping From Identifer To Device Set
     PhysicalDeviceSet m_devices;
+
+    /// Per-type device lists, indexed by device type
+    TypeIndex m_types[physicaldevices::DEVICE_TYPE_COUNT];
+
+    /// Called by BeginStep, if set
+    BeginHook m_beginStep;
+
+    /// Called by FinishStep, if set
+    StepHook m_finishStep;
 };
 
     } // namespace broker
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+/// @file      CSettingKeyTable.hpp
+///
+/// @author    Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler  C++
+///
+/// @project   FREEDM DGI
+///
+/// @description Interns device setting keys into compact integer identifiers
+///
+/// @license
+/// These source code files were created at as part of the
+/// FREEDM DGI Subthrust, and are
+/// intended for use in teaching or research.  They may be
+/// freely copied, modified and redistributed as long
+/// as modified versions are clearly marked as such and
+/// this notice is not removed.
+///
+/// Neither the authors nor the FREEDM Project nor the
+/// National Science Foundation
+/// make any warranty, express or implied, nor assumes
+/// any legal responsibility for the accuracy,
+/// completeness or usefulness of these codes or any
+/// information distributed with these codes.
+///
+/// Suggested modifications or questions about these codes
+/// can be directed to Dr. Bruce McMillin, Department of
+/// Computer Science, Missour University of Science and
+/// Technology, Rolla, /// MO  65409 (ff@mst.edu).
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_SETTING_KEY_TABLE_HPP
+#define C_SETTING_KEY_TABLE_HPP
+
+#include <map>
+#include <deque>
+#include <string>
+
+#include <boost/thread/shared_mutex.hpp>
+
+#include "Utility.hpp"
+#include "PhysicalDeviceTypes.hpp"
+
+namespace freedm {
+namespace broker {
+
+/// Process-wide table that maps setting key names to compact identifiers.
+/// The identifiers of physicaldevices::KnownSettingKey are fixed, all other
+/// keys are numbered in the order they are first interned.
+class CSettingKeyTable : public Templates::Singleton<CSettingKeyTable>
+{
+    friend class Templates::Singleton<CSettingKeyTable>;
+public:
+    /// Returns the identifier of a key name, registering it if it is new
+    physicaldevices::SettingKeyId Intern(const std::string & p_name);
+
+    /// Returns the key name of a registered identifier
+    std::string GetName(physicaldevices::SettingKeyId p_id) const;
+
+    /// Returns the number of registered keys
+    size_t Size() const;
+private:
+    /// Registers the known setting keys
+    CSettingKeyTable();
+
+    /// Protects the tables against concurrent registration
+    mutable boost::shared_mutex m_mutex;
+
+    /// Mapping from key name to identifier
+    std::map<std::string, physicaldevices::SettingKeyId> m_ids;
+
+    /// Key names indexed by identifier
+    std::deque<std::string> m_names;
+};
+
+} // namespace broker
+} // namespace freedm
+
+#endif // C_SETTING_KEY_TABLE_HPP
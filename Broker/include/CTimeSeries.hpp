@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////
+/// @file      CTimeSeries.hpp
+///
+/// @author    Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler  C++
+///
+/// @project   FREEDM DGI
+///
+/// @description Fixed-size lock-free history of timestamped device readings
+///
+/// @license
+/// These source code files were created at as part of the
+/// FREEDM DGI Subthrust, and are
+/// intended for use in teaching or research.  They may be
+/// freely copied, modified and redistributed as long
+/// as modified versions are clearly marked as such and
+/// this notice is not removed.
+///
+/// Neither the authors nor the FREEDM Project nor the
+/// National Science Foundation
+/// make any warranty, express or implied, nor assumes
+/// any legal responsibility for the accuracy,
+/// completeness or usefulness of these codes or any
+/// information distributed with these codes.
+///
+/// Suggested modifications or questions about these codes
+/// can be directed to Dr. Bruce McMillin, Department of
+/// Computer Science, Missour University of Science and
+/// Technology, Rolla, /// MO  65409 (ff@mst.edu).
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_TIME_SERIES_HPP
+#define C_TIME_SERIES_HPP
+
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace freedm {
+namespace broker {
+
+/// Ring buffer of the most recent timestamped readings of a single value.
+/// One thread records samples while any number of threads query them. Readers
+/// never block the writer: each slot carries a sequence number and a reader
+/// discards any slot that was overwritten while it was being read.
+class CTimeSeries
+    : private boost::noncopyable
+{
+public:
+    /// A single timestamped reading
+    struct Sample
+    {
+        /// The time the reading was taken
+        boost::posix_time::ptime m_time;
+        /// The value that was read
+        double m_value;
+    };
+
+    /// Aggregates over the samples of a time window
+    struct Summary
+    {
+        /// The number of samples in the window
+        size_t m_count;
+        /// The arithmetic mean of the samples
+        double m_mean;
+        /// The smallest sample
+        double m_min;
+        /// The largest sample
+        double m_max;
+        /// The least-squares rate of change, in units per second
+        double m_slope;
+    };
+
+    /// Creates a buffer that holds at least the given number of samples
+    explicit CTimeSeries(size_t p_capacity = DEFAULT_CAPACITY);
+
+    /// Records a reading taken now
+    void Record(double p_value);
+
+    /// Records a reading taken at the given time
+    void Record(const boost::posix_time::ptime & p_time, double p_value);
+
+    /// Gets the samples of the last p_seconds, oldest first
+    std::vector<Sample> GetWindow(double p_seconds) const;
+
+    /// Gets the samples of the p_seconds before p_now, oldest first
+    std::vector<Sample> GetWindow(double p_seconds,
+        const boost::posix_time::ptime & p_now) const;
+
+    /// Aggregates the samples of the last p_seconds
+    Summary Summarize(double p_seconds) const;
+
+    /// Aggregates the samples of the p_seconds before p_now
+    Summary Summarize(double p_seconds,
+        const boost::posix_time::ptime & p_now) const;
+
+    /// Mean of the samples of the last p_seconds
+    double Mean(double p_seconds) const { return Summarize(p_seconds).m_mean; };
+
+    /// Smallest sample of the last p_seconds
+    double Min(double p_seconds) const { return Summarize(p_seconds).m_min; };
+
+    /// Largest sample of the last p_seconds
+    double Max(double p_seconds) const { return Summarize(p_seconds).m_max; };
+
+    /// Rate of change over the last p_seconds, in units per second
+    double Slope(double p_seconds) const { return Summarize(p_seconds).m_slope; };
+
+    /// Gets the number of samples the buffer can hold
+    size_t Capacity() const { return m_mask + 1; };
+
+    /// Gets the number of samples recorded since construction
+    boost::uint64_t Recorded() const { return m_head.load(boost::memory_order_acquire); };
+
+    /// Samples held by a buffer created with the default constructor
+    static const size_t DEFAULT_CAPACITY = 256;
+private:
+    /// Storage for one sample; fields are atomic so readers may race the writer
+    struct Slot
+    {
+        /// 2n+1 while sample n is being written, 2n+2 once it is complete
+        boost::atomic<boost::uint64_t> m_sequence;
+        /// Microseconds since the epoch
+        boost::atomic<boost::int64_t> m_time;
+        /// Bit pattern of the value
+        boost::atomic<boost::uint64_t> m_value;
+    };
+
+    /// Copies the samples taken after p_since into p_samples, newest first
+    void Collect(boost::int64_t p_since, std::vector<Sample> & p_samples) const;
+
+    /// Slots indexed by sample number modulo the capacity
+    boost::scoped_array<Slot> m_slots;
+
+    /// Capacity minus one; the capacity is a power of two
+    size_t m_mask;
+
+    /// The number of samples recorded
+    boost::atomic<boost::uint64_t> m_head;
+};
+
+} // namespace broker
+} // namespace freedm
+
+#endif // C_TIME_SERIES_HPP
@@ -34,6 +34,8 @@
 #define IPHYSICALDEVICE_HPP
 
 #include "PhysicalDeviceTypes.hpp"
+#include "CSettingKeyTable.hpp"
+#include "CTimeSeries.hpp"
 
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
@@ -53,6 +55,9 @@ class IPhysicalDevice
     public:
         /// The type used for the settings key
         typedef std::string SettingKey;
+
+        /// The type used for an interned settings key
+        typedef physicaldevices::SettingKeyId SettingKeyId;
         
         /// The type used for the value of the setting
         typedef double SettingValue;
@@ -73,11 +78,23 @@ class IPhysicalDevice
               m_devid(deviceid),
               m_devtype(devtype) {};
 
-        /// Pulls the setting of some key from the inside.
-        virtual SettingValue Get(SettingKey key) = 0;
+        /// Pulls the setting of some interned key from the inside.
+        virtual SettingValue Get(SettingKeyId key) = 0;
+
+        /// Sets the value of some interned key to the input value.
+        virtual void Set(SettingKeyId key, SettingValue value) = 0;
+
+        /// Pulls the setting of some key by name (interns the key).
+        SettingValue Get(const SettingKey & key)
+            { return Get(InternKey(key)); };
+
+        /// Sets the value of some key by name (interns the key).
+        void Set(const SettingKey & key, SettingValue value)
+            { Set(InternKey(key), value); };
 
-        /// Sets the value of some key to the input value.
-        virtual void Set(SettingKey key, SettingValue value) = 0;
+        /// Gets the interned identifier of a key name.
+        static SettingKeyId InternKey(const SettingKey & key)
+            { return CSettingKeyTable::instance().Intern(key); };
 
         //turn the device on
         virtual void turnOn() = 0;
@@ -105,6 +122,12 @@ class IPhysicalDevice
         
         /// Gets the manager associated with this device.
         CPhysicalDeviceManager& GetManager() { return m_manager; }; 
+
+        /// Gets the power levels recorded by the manager.
+        CTimeSeries& GetHistory() { return m_history; };
+
+        /// Gets the power levels recorded by the manager.
+        const CTimeSeries& GetHistory() const { return m_history; };
     protected:
         /// The manager who is tracking this device.
         CPhysicalDeviceManager& m_manager;
@@ -117,6 +140,9 @@ class IPhysicalDevice
     
         /// The type of device
         physicaldevices::DeviceType m_devtype;
+
+        /// Recent power levels, recorded on each refresh by the manager
+        CTimeSeries m_history;
 };
 
     } // Namespace broker
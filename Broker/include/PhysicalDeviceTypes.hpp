@@ -45,7 +45,20 @@ enum DeviceType {
     DESD,
     LOAD,
     GRID,
-    DG
+    DG,
+    /// Number of device types, must remain the last enumerator
+    DEVICE_TYPE_COUNT
+};
+
+/// Compact identifier of an interned setting key.
+typedef unsigned int SettingKeyId;
+
+/// Setting keys interned before any device is created, in this order.
+enum KnownSettingKey {
+    POWER_LEVEL,
+    ON_OFF_SWITCH,
+    /// Number of known setting keys, must remain the last enumerator
+    KNOWN_SETTING_KEY_COUNT
 };
 
         } // namespace physicaldevices
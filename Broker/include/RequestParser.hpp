@@ -36,7 +36,7 @@ template <typename InputIterator>
 boost::tuple<boost::tribool, InputIterator> Parse(CMessage &req,
         InputIterator begin, InputIterator end)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
     std::stringstream ss_;
     std::ostreambuf_iterator<char> ss_buf( ss_ );
@@ -45,14 +45,14 @@ boost::tuple<boost::tribool, InputIterator> Parse(CMessage &req,
 
     try 
     {
-        Logger::Debug << "Loading xml: " << std::endl
+        LOG_DEBUG << "Loading xml: " << std::endl
                 << ss_.str() << std::endl;
         result = req.Load( ss_ );
     }
     catch ( std::exception &e )
     {
         // Perhaps incomplete message.
-        Logger::Error << "Exception: " << e.what() << std::endl;
+        LOG_ERROR << "Exception: " << e.what() << std::endl;
     }
 
     return boost::make_tuple(result, begin);
@@ -62,7 +62,7 @@ template <typename OutputIterator>
 boost::tuple< boost::tribool, OutputIterator> Synthesize( CMessage &msg,
     OutputIterator begin, size_t p_outMaxLength )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     std::stringstream ss_;
     std::string str_;
     boost::tribool result = boost::indeterminate;
@@ -71,13 +71,13 @@ boost::tuple< boost::tribool, OutputIterator> Synthesize( CMessage &msg,
     try
     {
         msg.Save( ss_ );
-        Logger::Debug << "Saved xml: " << std::endl
+        LOG_DEBUG << "Saved xml: " << std::endl
                 << ss_.str() << std::endl;
         result = true;
     }
     catch( std::exception &e )
     {
-        Logger::Error
+        LOG_ERROR
             << "Exception: " << e.what() << std::endl;
     }
 
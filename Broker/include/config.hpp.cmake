@@ -33,5 +33,8 @@
 #cmakedefine CUSTOMNETWORK
 #cmakedefine USE_DEVICE_PSCAD
 
+// log statements above this level are removed at compile time
+#define LOG_MAX_LEVEL @LOG_MAX_LEVEL@
+
 #endif // CONFIG_HPP
 
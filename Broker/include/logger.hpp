@@ -6,8 +6,16 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 #include <iostream>
+#include <sstream>
 #include <string>
 
+#include "config.hpp"
+
+// log statements above this level are removed at compile time
+#ifndef LOG_MAX_LEVEL
+#define LOG_MAX_LEVEL 7
+#endif
+
 using namespace boost::posix_time;
 
 namespace Logger {
@@ -15,6 +23,10 @@ namespace Logger {
 class Log : public boost::iostreams::sink
 {
 public:
+    // receives the messages that pass the filter in place of the stream
+    typedef void (*TSink)( int p_level, const char * p_name,
+            const char * p_text, std::streamsize p_length );
+
     Log( int level_, const char * name_, std::ostream *out_= &std::clog ) :
         m_level(level_), m_name( name_ ), m_ostream( out_ )
     {
@@ -22,7 +34,10 @@ public:
 
     std::streamsize write( const char* s, std::streamsize n)
     {
-        if( m_filter >= m_level ){
+        if( m_filter >= m_level && m_sink != 0 ){
+            m_sink( m_level, m_name.c_str(), s, n );
+        }
+        else if( m_filter >= m_level ){
             *m_ostream << microsec_clock::local_time() << " : "
                 << m_name << "(" << m_level << "):\t";
                        
@@ -36,14 +51,71 @@ public:
     {
         m_filter = p_level;
     }
+    
+    static bool isEnabled( const int p_level )
+    {
+        return m_filter >= p_level;
+    }
+    
+    static void setSink( TSink p_sink )
+    {
+        m_sink = p_sink;
+    }
 
 private:
     static int m_filter;
+    static TSink m_sink;
     const int m_level;
     const std::string m_name;
     std::ostream *m_ostream;
 };
 
+// formats one log statement in a buffer of its own and hands the finished
+// message to the log when the statement ends, so that threads logging at the
+// same time never share a stream buffer
+class Message
+{
+public:
+    explicit Message( boost::iostreams::stream<Log> & log_ ) : m_log( log_ )
+    {
+    };
+
+    ~Message()
+    {
+        std::string text = m_buffer.str();
+
+        if( !text.empty() ){
+            if( text[text.size()-1] != '\n' ){
+                text += '\n';
+            }
+            m_log->write( text.data(), text.size() );
+        }
+    };
+
+    template <typename T>
+    Message & operator<<( const T & value_ )
+    {
+        m_buffer << value_;
+        return *this;
+    }
+
+    Message & operator<<( std::ostream & (*manip_)( std::ostream & ) )
+    {
+        manip_( m_buffer );
+        return *this;
+    };
+
+    Message & operator<<( std::ios_base & (*manip_)( std::ios_base & ) )
+    {
+        manip_( m_buffer );
+        return *this;
+    };
+
+private:
+    boost::iostreams::stream<Log> & m_log;
+    std::ostringstream m_buffer;
+};
+
 }
 
 #define CREATE_LOG( level, name ) \
@@ -52,6 +124,22 @@ private:
 #define CREATE_EXTERN_LOG( level, name ) \
     boost::iostreams::stream<Logger::Log> name
 
+// formats a message for a standard log only if its level is compiled in and
+// passes the filter, so that the operands of a filtered message are never
+// evaluated
+#define LOG_IF( level, name ) \
+    if( (level) > LOG_MAX_LEVEL || !Logger::Log::isEnabled(level) ) {} \
+    else Logger::Message( Logger::name )
+
+#define LOG_DEBUG       LOG_IF( 7, Debug )
+#define LOG_INFO        LOG_IF( 6, Info )
+#define LOG_NOTICE      LOG_IF( 5, Notice )
+#define LOG_WARN        LOG_IF( 4, Warn )
+#define LOG_ERROR       LOG_IF( 3, Error )
+#define LOG_CRITICAL    LOG_IF( 2, Critical )
+#define LOG_ALERT       LOG_IF( 1, Alert )
+#define LOG_FATAL       LOG_IF( 0, Fatal )
+
 #define CREATE_STD_LOGS() \
 	namespace Logger { \
 	CREATE_LOG(7, Debug); \
@@ -63,6 +151,7 @@ private:
 	CREATE_LOG(1, Alert); \
 	CREATE_LOG(0, Fatal); \
 	int Log::m_filter=0; \
+	Log::TSink Log::m_sink=0; \
 	}
 
 #ifndef CREATE_EXTERN_STD_LOGS
@@ -40,9 +40,9 @@ namespace freedm {
 		/// @brief  constructor. The device type is always DESD (distributed energy storage device).
 		/// @param phymanager The related physical device manager.
 		/// @param deviceid The identifier for this generic device.
-		/// @param lineClient  the client that connects to the PSCAD interface
+		/// @param lineClient  the client pool that connects to the PSCAD interface
 		///////////////////////////////////////////////////////////////////////////////
-		CBatteryDevice::CBatteryDevice(CLineClient::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid)  
+		CBatteryDevice::CBatteryDevice(CLineClientPool::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid)  
 			: CPSCADDevice(lineClient, phymanager, deviceid, physicaldevices::DESD)
 		{};
 
@@ -54,7 +54,7 @@ namespace freedm {
 		///////////////////////////////////////////////////////////////////////////////
 		CBatteryDevice:: SettingValue CBatteryDevice::get_powerLevel()
 		{
-			return CPSCADDevice::Get("powerLevel");
+			return CPSCADDevice::Get(physicaldevices::POWER_LEVEL);
 		}
 
 		/////////////////////////////////////////////////////////////////////////////
@@ -63,7 +63,7 @@ namespace freedm {
 		///////////////////////////////////////////////////////////////////////////////
 		void CBatteryDevice::turnOn()
 		{
-			CPSCADDevice::Set("onOffSwitch", 0);
+			CPSCADDevice::Set(physicaldevices::ON_OFF_SWITCH, 0);
 		}
 
 		/////////////////////////////////////////////////////////////////////////////
@@ -72,7 +72,7 @@ namespace freedm {
 		///////////////////////////////////////////////////////////////////////////////
 		void CBatteryDevice::turnOff()
 		{
-			CPSCADDevice::Set("onOffSwitch", 1);
+			CPSCADDevice::Set(physicaldevices::ON_OFF_SWITCH, 1);
 		}
 
     } // namespace broker
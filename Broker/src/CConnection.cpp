@@ -67,7 +67,7 @@ CConnection::CConnection(boost::asio::io_service& p_ioService,
   : CReliableConnection(p_ioService,p_manager,p_dispatch,uuid),
     m_timeout( p_ioService)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     m_outsequenceno = 0;
     m_timeouts = 0;
     m_synched = false;
@@ -82,7 +82,7 @@ CConnection::CConnection(boost::asio::io_service& p_ioService,
 ///////////////////////////////////////////////////////////////////////////////
 void CConnection::Start()
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -96,7 +96,7 @@ void CConnection::Start()
 ///////////////////////////////////////////////////////////////////////////////
 void CConnection::Stop()
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     m_timeout.cancel();
     GetSocket().close();
 }
@@ -118,7 +118,7 @@ void CConnection::Stop()
 ///////////////////////////////////////////////////////////////////////////////
 void CConnection::Send(CMessage p_mesg, bool sequence)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
     #ifdef DATAGRAM
     sequence = false;
@@ -181,7 +181,7 @@ void CConnection::Send(CMessage p_mesg, bool sequence)
 ///////////////////////////////////////////////////////////////////////////////
 void CConnection::HandleSend(CMessage msg)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     boost::tribool result_;
     boost::array<char, 8192>::iterator it_;
 
@@ -191,7 +191,7 @@ void CConnection::HandleSend(CMessage msg)
     #ifdef CUSTOMNETWORK
     if((rand()%100) >= GetReliability()) 
     {
-        Logger::Info<<"Outgoing Packet Dropped ("<<GetReliability()
+        LOG_INFO<<"Outgoing Packet Dropped ("<<GetReliability()
                       <<") -> "<<GetUUID()<<std::endl;
         return;
     }
@@ -216,10 +216,10 @@ void CConnection::HandleSend(CMessage msg)
 ///////////////////////////////////////////////////////////////////////////////
 void CConnection::Resend(const boost::system::error_code& err)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     if(!err)
     {
-        Logger::Debug << "Firing Resend"<<std::endl;
+        LOG_DEBUG << "Firing Resend"<<std::endl;
         if(!m_queue.IsEmpty())
         {
             m_timeouts++;
@@ -243,7 +243,7 @@ void CConnection::Resend(const boost::system::error_code& err)
 ///////////////////////////////////////////////////////////////////////////////
 void CConnection::HandleResend()
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     SlidingWindow<QueueItem>::iterator sit;
     sit = m_queue.begin();   
  
@@ -263,10 +263,10 @@ void CConnection::HandleResend()
 ///////////////////////////////////////////////////////////////////////////////
 void CConnection::SendSYN()
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     freedm::broker::CMessage m_;
     m_.SetStatus(freedm::broker::CMessage::Created);
-    Logger::Info<<"Sending SYN"<<std::endl;
+    LOG_INFO<<"Sending SYN"<<std::endl;
     Send(m_);
 }
 
@@ -281,15 +281,15 @@ void CConnection::SendSYN()
 ///////////////////////////////////////////////////////////////////////////////
 void CConnection::RecieveACK(unsigned int sequenceno)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     while(!m_queue.IsEmpty())
     {
         unsigned int bounda = m_queue.front().first;
         unsigned int boundb = (m_queue.front().first+(GetWindowSize()))%GetSequenceModulo();
-        Logger::Debug<<"ACK, bounda:"<<bounda<<" boundb:"<<boundb<<"input: "<<sequenceno<<std::endl;
+        LOG_DEBUG<<"ACK, bounda:"<<bounda<<" boundb:"<<boundb<<"input: "<<sequenceno<<std::endl;
         if(bounda <= sequenceno || (sequenceno < boundb && boundb < bounda))
         {
-            Logger::Info<<"ACK handled for "<<m_queue.front().first<<std::endl;
+            LOG_INFO<<"ACK handled for "<<m_queue.front().first<<std::endl;
             m_queue.pop();
             m_timeouts = 0;
         }
@@ -314,7 +314,7 @@ void CConnection::RecieveACK(unsigned int sequenceno)
 ///////////////////////////////////////////////////////////////////////////////
 void CConnection::HandleWrite(const boost::system::error_code& e)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
     if (!e)
     {
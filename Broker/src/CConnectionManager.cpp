@@ -71,7 +71,7 @@ CConnectionManager::CConnectionManager(freedm::uuid uuid, std::string hostname)
 ///////////////////////////////////////////////////////////////////////////////
 void CConnectionManager::Start (CListener::ConnectionPtr c)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     c->Start();
     m_inchannel = c; 
 }
@@ -86,7 +86,7 @@ void CConnectionManager::Start (CListener::ConnectionPtr c)
 ///////////////////////////////////////////////////////////////////////////////
 void CConnectionManager::PutConnection(std::string uuid, ConnectionPtr c)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     {  
         boost::lock_guard< boost::mutex > scopedLock_( m_Mutex );
         m_connections.insert(connectionmap::value_type(uuid,c));
@@ -103,7 +103,7 @@ void CConnectionManager::PutConnection(std::string uuid, ConnectionPtr c)
 ///////////////////////////////////////////////////////////////////////////////
 void CConnectionManager::PutHostname(std::string u_, std::string host_)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;  
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;  
     {
         boost::lock_guard< boost::mutex > scopedLock_( m_Mutex );
         m_hostnames.insert(std::pair<std::string, std::string>(u_, host_));  
@@ -120,7 +120,7 @@ void CConnectionManager::PutHostname(std::string u_, std::string host_)
 ///////////////////////////////////////////////////////////////////////////////
 void CConnectionManager::Stop (CConnection::ConnectionPtr c)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     if(m_connections.right.count(c))
     {
         m_connections.right.erase(c);
@@ -137,7 +137,7 @@ void CConnectionManager::Stop (CConnection::ConnectionPtr c)
 ///////////////////////////////////////////////////////////////////////////////
 void CConnectionManager::Stop (CListener::ConnectionPtr c)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     c->Stop();
     //TODO: Make the whole thing terminate if the listner says stop.
 }
@@ -152,14 +152,14 @@ void CConnectionManager::Stop (CListener::ConnectionPtr c)
 ///////////////////////////////////////////////////////////////////////////////
 void CConnectionManager::StopAll ()
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     while(m_connections.size() > 0)
     {
       Stop((*m_connections.left.begin()).second); //Side effect of stop should make this map smaller
     }
     m_connections.clear();
     Stop(m_inchannel);
-    Logger::Debug << "All Connections Closed" << std::endl;
+    LOG_DEBUG << "All Connections Closed" << std::endl;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -200,7 +200,7 @@ std::string CConnectionManager::GetHostnameByUUID(std::string uuid) const
 ConnectionPtr CConnectionManager::GetConnectionByUUID
     (std::string uuid_, boost::asio::io_service& ios,  CDispatcher &dispatch_)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
     ConnectionPtr c_;  
     std::string s_;
@@ -210,7 +210,7 @@ ConnectionPtr CConnectionManager::GetConnectionByUUID
     {
         if(m_connections.left.at(uuid_)->GetSocket().is_open())
         {
-            Logger::Info << "Recycling connection to " << uuid_ << std::endl;
+            LOG_INFO << "Recycling connection to " << uuid_ << std::endl;
             #ifdef CUSTOMNETWORK
             LoadNetworkConfig();
             #endif
@@ -218,14 +218,14 @@ ConnectionPtr CConnectionManager::GetConnectionByUUID
         }
         else
         {
-            Logger::Info <<" Connection to " << uuid_ << " has gone stale " << std::endl;
+            LOG_INFO <<" Connection to " << uuid_ << " has gone stale " << std::endl;
             //The socket is not marked as open anymore, we
             //should stop it.
             Stop(m_connections.left.at(uuid_));
         }
     }  
 
-    Logger::Info << "Making Fresh Connection to " << uuid_ << std::endl;
+    LOG_INFO << "Making Fresh Connection to " << uuid_ << std::endl;
 
     // Find the requested host from the list of known hosts
     std::map<std::string, std::string>::iterator mapIt_;
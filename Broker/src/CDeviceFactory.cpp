@@ -39,15 +39,16 @@ namespace broker {
 /// Creates an instance of a device factory
 CDeviceFactory::CDeviceFactory( CPhysicalDeviceManager & p_devman,
     boost::asio::io_service & p_ios, const std::string & p_host,
-    const std::string & p_port )
+    const std::string & p_port, size_t p_connections, long p_stepTimeout )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     
 #if defined USE_DEVICE_PSCAD
-    Logger::Info << "Initialized to use PSCAD devices" << std::endl;
-    m_factory.reset(new CPSCADFactory( p_devman, p_ios, p_host, p_port ));
+    LOG_INFO << "Initialized to use PSCAD devices" << std::endl;
+    m_factory.reset(new CPSCADFactory( p_devman, p_ios, p_host, p_port,
+        p_connections, p_stepTimeout ));
 #else
-    Logger::Info << "Initialized to use generic devices" << std::endl;
+    LOG_INFO << "Initialized to use generic devices" << std::endl;
     m_factory.reset(new CGenericFactory( p_devman ));
 #endif
 }
@@ -56,7 +57,7 @@ CDeviceFactory::CDeviceFactory( CPhysicalDeviceManager & p_devman,
 void CDeviceFactory::CreateDevice( const std::string & p_type,
         const IPhysicalDevice::Identifier & p_devid )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
     // delegate creation to the factory
     m_factory->CreateDevice( p_type, p_devid );
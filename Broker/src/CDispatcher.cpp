@@ -52,7 +52,7 @@ namespace freedm {
 ///////////////////////////////////////////////////////////////////////////////
 CDispatcher::CDispatcher()
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
 }
 
@@ -67,7 +67,7 @@ CDispatcher::CDispatcher()
 ///////////////////////////////////////////////////////////////////////////////
 void CDispatcher::HandleRequest( const ptree &p_mesg )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     ptree sub_;
     ptree::const_iterator it_;
     std::map< std::string, IReadHandler *>::const_iterator mapIt_;
@@ -92,7 +92,7 @@ void CDispatcher::HandleRequest( const ptree &p_mesg )
         ptree sub_ = p_mesg.get_child("message.submessages");
         for( it_ = sub_.begin(); it_ != sub_.end(); ++it_ )
         {
-            Logger::Debug << "Processing " << it_->first
+            LOG_DEBUG << "Processing " << it_->first
                     << std::endl;
 
             // Retrieve current key and iterate through all matching
@@ -111,7 +111,7 @@ void CDispatcher::HandleRequest( const ptree &p_mesg )
                 m_readHandlers.upper_bound( key_)     )
             {
                 // Just log this for now
-                Logger::Debug << "Submessage '" << key_ << "' had no read handlers.";
+                LOG_DEBUG << "Submessage '" << key_ << "' had no read handlers.";
             }
 
         }
@@ -120,12 +120,12 @@ void CDispatcher::HandleRequest( const ptree &p_mesg )
         if( sub_.begin() == sub_.end() )
         {
             // Just log this for now
-            Logger::Debug << "Message had no submessages.";
+            LOG_DEBUG << "Message had no submessages.";
         }
     }
     catch( boost::property_tree::ptree_bad_path &e )
     {
-        Logger::Error
+        LOG_ERROR
             << __PRETTY_FUNCTION__ << " (" << __LINE__ << "): "
             << "Malformed message. Does not contain 'submessages'."
             << std::endl << "\t" << e.what() << std::endl;
@@ -143,7 +143,7 @@ void CDispatcher::HandleRequest( const ptree &p_mesg )
 ///////////////////////////////////////////////////////////////////////////////
 void CDispatcher::HandleWrite( ptree &p_mesg )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     ptree sub_;
     ptree::const_iterator it_;
     std::map< std::string, IWriteHandler *>::const_iterator mapIt_;
@@ -162,7 +162,7 @@ void CDispatcher::HandleWrite( ptree &p_mesg )
                 mapIt_ != m_writeHandlers.upper_bound( "any" );
                 ++mapIt_ )
         {
-           Logger::Debug << "Processing 'any'" << std::endl;  
+           LOG_DEBUG << "Processing 'any'" << std::endl;  
 	  (mapIt_->second)->HandleWrite( p_mesg );
         }
 
@@ -171,7 +171,7 @@ void CDispatcher::HandleWrite( ptree &p_mesg )
         ptree sub_ = p_mesg.get_child("message.submessages");
         for( it_ = sub_.begin(); it_ != sub_.end(); ++it_ )
         {
-            Logger::Debug << "Processing " << it_->first
+            LOG_DEBUG << "Processing " << it_->first
                     << std::endl;
 
             // Retrieve current key and iterate through all matching
@@ -191,7 +191,7 @@ void CDispatcher::HandleWrite( ptree &p_mesg )
                 m_writeHandlers.upper_bound( key_)     )
             {
                 // Just log this for now
-                Logger::Debug << "Submessage '" << key_ << "' had no write handlers.";
+                LOG_DEBUG << "Submessage '" << key_ << "' had no write handlers.";
             }
         }
 
@@ -199,7 +199,7 @@ void CDispatcher::HandleWrite( ptree &p_mesg )
     }
     catch( boost::property_tree::ptree_bad_path &e )
     {
-        Logger::Error
+        LOG_ERROR
             << __PRETTY_FUNCTION__ << " (" << __LINE__ << "): "
             << "Malformed message. Does not contain 'submessages'."
             << std::endl << "\t" << e.what() << std::endl;
@@ -219,7 +219,7 @@ void CDispatcher::HandleWrite( ptree &p_mesg )
 void CDispatcher::RegisterReadHandler( const std::string &p_type,
         IReadHandler *p_handler )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
     {
         // Scoped lock, will release mutex at end of {}
@@ -245,7 +245,7 @@ void CDispatcher::RegisterReadHandler( const std::string &p_type,
 void CDispatcher::RegisterWriteHandler( const std::string &p_type,
         IWriteHandler *p_handler )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
     {
         // Scoped lock, will release mutex at end of {}
@@ -74,11 +74,10 @@ CGenericDevice::CGenericDevice(CPhysicalDeviceManager& phymanager, Identifier de
 /// @param key The key to retrieve from the register.
 /// @return The value in the register or 0.0 if the key hasn't been defined.
 ///////////////////////////////////////////////////////////////////////////////
-CGenericDevice::SettingValue CGenericDevice::Get(SettingKey key)
+CGenericDevice::SettingValue CGenericDevice::Get(SettingKeyId key)
 {
-    std::map<SettingKey,SettingValue>::iterator ri = m_register.find(key);
-    if(ri != m_register.end())
-        return ri->second;
+    if(key < m_register.size())
+        return m_register[key];
     return 0.0;
 };
 ///////////////////////////////////////////////////////////////////////////////
@@ -87,8 +86,10 @@ CGenericDevice::SettingValue CGenericDevice::Get(SettingKey key)
 /// @param key The key to change.
 /// @param value The value to set the key to.
 ///////////////////////////////////////////////////////////////////////////////
-void CGenericDevice::Set(SettingKey key, SettingValue value)
+void CGenericDevice::Set(SettingKeyId key, SettingValue value)
 {
+    if(key >= m_register.size())
+        m_register.resize(key+1, 0.0);
     m_register[key] = value;
 };
 
@@ -39,14 +39,14 @@ namespace broker {
 CGenericFactory::CGenericFactory( CPhysicalDeviceManager & p_devman )
     : m_manager(p_devman)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 }
 
 /// Creates the family of generic devices
 void CGenericFactory::CreateDevice( const std::string & p_type,
     const IPhysicalDevice::Identifier & p_devid )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     DevicePtr device;
     
     // uncomment this when IPhysicalDevice is fixed . . .
@@ -56,12 +56,12 @@ void CGenericFactory::CreateDevice( const std::string & p_type,
     }
     else
     {
-        Logger::Error << "Cannot add " << p_type << " device" << std::endl;
+        LOG_ERROR << "Cannot add " << p_type << " device" << std::endl;
         return;
     }
     //m_manager.AddDevice(device);
     
-    Logger::Debug << "Added " << p_type << " device " << p_devid << std::endl;
+    LOG_DEBUG << "Added " << p_type << " device " << p_devid << std::endl;
 }
 
 } // namespace broker
@@ -41,9 +41,9 @@ namespace freedm {
         ///         Its type is always GRID.
 		/// @param phymanager The related physical device manager.
 		/// @param deviceid The identifier for this generic device.
-		/// @param lineClient  the client that connects to the PSCAD interface
+		/// @param lineClient  the client pool that connects to the PSCAD interface
 		///////////////////////////////////////////////////////////////////////////////
-		CGridLinkDevice::CGridLinkDevice(CLineClient::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid)  
+		CGridLinkDevice::CGridLinkDevice(CLineClientPool::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid)  
 			: CPSCADDevice(lineClient, phymanager, deviceid, physicaldevices::GRID)
 		{};
 
@@ -54,7 +54,7 @@ namespace freedm {
 		///////////////////////////////////////////////////////////////////////////////
 		CGridLinkDevice:: SettingValue CGridLinkDevice::get_powerLevel()
 		{
-			return CPSCADDevice::Get("powerLevel");
+			return CPSCADDevice::Get(physicaldevices::POWER_LEVEL);
 		}
 
 		/////////////////////////////////////////////////////////////////////////////
@@ -63,7 +63,7 @@ namespace freedm {
 		///////////////////////////////////////////////////////////////////////////////
 		void CGridLinkDevice::turnOn()
 		{
-			CPSCADDevice::Set("onOffSwitch", 0);
+			CPSCADDevice::Set(physicaldevices::ON_OFF_SWITCH, 0);
 		}
 
 		/////////////////////////////////////////////////////////////////////////////
@@ -72,7 +72,7 @@ namespace freedm {
 		///////////////////////////////////////////////////////////////////////////////
 		void CGridLinkDevice::turnOff()
 		{
-			CPSCADDevice::Set("onOffSwitch", 1);
+			CPSCADDevice::Set(physicaldevices::ON_OFF_SWITCH, 1);
 		}
 
 	} // namespace broker
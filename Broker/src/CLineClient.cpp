@@ -26,6 +26,9 @@
 
 #include "CLineClient.hpp"
 
+#include <cerrno>
+#include <poll.h>
+
 namespace freedm{
   namespace broker{
 
@@ -36,6 +39,7 @@ CLineClient::TPointer CLineClient::Create( boost::asio::io_service & p_service )
 
 CLineClient::CLineClient( boost::asio::io_service & p_service )
     : m_socket(p_service)
+    , m_binary(false)
 {
     // skip
 }
@@ -60,12 +64,43 @@ bool CLineClient::Connect( const std::string p_hostname, const std::string p_por
         throw boost::system::system_error(error);
     }
     
+    // handles belong to the previous connection
+    m_handles.clear();
+    Negotiate();
+    
     return( it != end );
 }
 
+void CLineClient::Negotiate()
+{
+    boost::asio::streambuf request;
+    std::ostream request_stream( &request );
+    
+    boost::asio::streambuf response;
+    std::istream response_stream( &response );
+    std::string response_code;
+    
+    // format and send the request stream
+    request_stream << "BINARY\r\n";
+    boost::asio::write( m_socket, request );
+    
+    // receive and split the response stream
+    boost::asio::read_until( m_socket, response, "\r\n" );
+    response_stream >> response_code;
+    
+    // a server without binary support stays in text mode
+    m_binary = ( response_code == "200" );
+}
+
 void CLineClient::Set( const std::string p_device, const std::string p_key,
     const std::string p_value )
 {
+    if( m_binary )
+    {
+        SetValue( p_device, p_key, boost::lexical_cast<double>(p_value) );
+        return;
+    }
+    
     boost::asio::streambuf request;
     std::ostream request_stream( &request );
     
@@ -90,6 +125,11 @@ void CLineClient::Set( const std::string p_device, const std::string p_key,
 
 std::string CLineClient::Get( const std::string p_device, const std::string p_key )
 {
+    if( m_binary )
+    {
+        return boost::lexical_cast<std::string>( GetValue(p_device, p_key) );
+    }
+    
     boost::asio::streambuf request;
     std::ostream request_stream( &request );
     
@@ -114,8 +154,229 @@ std::string CLineClient::Get( const std::string p_device, const std::string p_ke
     return value;
 }
 
+void CLineClient::SetValue( const std::string & p_device, const std::string & p_key,
+    double p_value )
+{
+    if( !m_binary )
+    {
+        Set( p_device, p_key, boost::lexical_cast<std::string>(p_value) );
+        return;
+    }
+    
+    boost::uint32_t handle = Resolve( p_device, p_key );
+    Exchange( OP_SET, handle, p_value );
+}
+
+double CLineClient::GetValue( const std::string & p_device, const std::string & p_key )
+{
+    if( !m_binary )
+    {
+        return boost::lexical_cast<double>( Get(p_device, p_key) );
+    }
+    
+    boost::uint32_t handle = Resolve( p_device, p_key );
+    return Exchange( OP_GET, handle, 0.0 );
+}
+
+boost::uint64_t CLineClient::WaitForStep( boost::uint64_t p_version, long p_timeout )
+{
+    if( m_binary )
+    {
+        boost::uint32_t handle = 0;
+        SendFrame( OP_WAIT, handle, static_cast<double>(p_version), std::string() );
+        if( !WaitReadable(p_timeout) )
+        {
+            Close();
+            return p_version;
+        }
+        return static_cast<boost::uint64_t>( ReceiveFrame(handle) );
+    }
+    
+    boost::asio::streambuf request;
+    std::ostream request_stream( &request );
+    
+    boost::asio::streambuf response;
+    std::istream response_stream( &response );
+    std::string response_code, response_message;
+    boost::uint64_t version;
+    
+    // format and send the request stream
+    request_stream << "WAIT " << p_version << "\r\n";
+    boost::asio::write( m_socket, request );
+    
+    // the server answers once it has a newer step, which may be never
+    if( !WaitReadable(p_timeout) )
+    {
+        Close();
+        return p_version;
+    }
+    
+    // receive and split the response stream
+    boost::asio::read_until( m_socket, response, "\r\n" );
+    response_stream >> response_code >> response_message >> version;
+    
+    // handle bad responses
+    if( response_code != "200" )
+    {
+        throw std::runtime_error(response_message);
+    }
+    
+    return version;
+}
+
+void CLineClient::FinishStep( boost::uint64_t p_version )
+{
+    if( m_binary )
+    {
+        boost::uint32_t handle = 0;
+        Exchange( OP_DONE, handle, static_cast<double>(p_version) );
+        return;
+    }
+    
+    boost::asio::streambuf request;
+    std::ostream request_stream( &request );
+    
+    boost::asio::streambuf response;
+    std::istream response_stream( &response );
+    std::string response_code, response_message;
+    
+    // format and send the request stream
+    request_stream << "DONE " << p_version << "\r\n";
+    boost::asio::write( m_socket, request );
+    
+    // receive and split the response stream
+    boost::asio::read_until( m_socket, response, "\r\n" );
+    response_stream >> response_code >> response_message;
+    
+    // handle bad responses
+    if( response_code != "200" )
+    {
+        throw std::runtime_error(response_message);
+    }
+}
+
+boost::uint32_t CLineClient::Resolve( const std::string & p_device, const std::string & p_key )
+{
+    std::pair<std::string,std::string> name( p_device, p_key );
+    std::map<std::pair<std::string,std::string>, boost::uint32_t>::iterator it;
+    
+    it = m_handles.find( name );
+    if( it == m_handles.end() )
+    {
+        // the server writes the new handle into the response frame
+        boost::uint32_t handle = 0;
+        Exchange( OP_RESOLVE, handle, 0.0, p_device + ' ' + p_key );
+        it = m_handles.insert( std::make_pair(name, handle) ).first;
+    }
+    
+    return it->second;
+}
+
+double CLineClient::Exchange( unsigned char p_opcode, boost::uint32_t & p_handle,
+    double p_value, const std::string & p_payload )
+{
+    SendFrame( p_opcode, p_handle, p_value, p_payload );
+    return ReceiveFrame( p_handle );
+}
+
+void CLineClient::SendFrame( unsigned char p_opcode, boost::uint32_t p_handle,
+    double p_value, const std::string & p_payload )
+{
+    unsigned char frame[FRAME_SIZE];
+    boost::uint64_t bits;
+    
+    std::memcpy( &bits, &p_value, sizeof(bits) );
+    
+    // header fields are big-endian
+    frame[0] = p_opcode;
+    frame[1] = STATUS_OK;
+    frame[2] = static_cast<unsigned char>( p_payload.size() >> 8 );
+    frame[3] = static_cast<unsigned char>( p_payload.size() );
+    for( int i = 0; i < 4; i++ )
+    {
+        frame[4+i] = static_cast<unsigned char>( p_handle >> (24 - 8*i) );
+    }
+    for( int i = 0; i < 8; i++ )
+    {
+        frame[8+i] = static_cast<unsigned char>( bits >> (56 - 8*i) );
+    }
+    
+    // send the header and payload together
+    std::vector<boost::asio::const_buffer> request;
+    request.push_back( boost::asio::buffer(frame) );
+    request.push_back( boost::asio::buffer(p_payload) );
+    boost::asio::write( m_socket, request );
+}
+
+double CLineClient::ReceiveFrame( boost::uint32_t & p_handle )
+{
+    unsigned char frame[FRAME_SIZE];
+    boost::uint64_t bits;
+    double value;
+    
+    // receive the response frame
+    boost::asio::read( m_socket, boost::asio::buffer(frame) );
+    
+    // handle bad responses
+    if( frame[1] == STATUS_NOTFOUND )
+    {
+        throw std::runtime_error("NOTFOUND");
+    }
+    else if( frame[1] != STATUS_OK )
+    {
+        throw std::runtime_error("BADREQUEST");
+    }
+    
+    p_handle = 0;
+    bits = 0;
+    for( int i = 0; i < 4; i++ )
+    {
+        p_handle = (p_handle << 8) | frame[4+i];
+    }
+    for( int i = 0; i < 8; i++ )
+    {
+        bits = (bits << 8) | frame[8+i];
+    }
+    std::memcpy( &value, &bits, sizeof(value) );
+    
+    return value;
+}
+
+bool CLineClient::WaitReadable( long p_timeout )
+{
+    pollfd descriptor;
+    int result;
+    
+    descriptor.fd = m_socket.native_handle();
+    descriptor.events = POLLIN;
+    descriptor.revents = 0;
+    
+    do
+    {
+        result = poll( &descriptor, 1, static_cast<int>(p_timeout) );
+    }
+    while( result < 0 && errno == EINTR );
+    
+    if( result < 0 )
+    {
+        throw boost::system::system_error( errno, boost::system::system_category() );
+    }
+    
+    // a hang up or error is readable, the read that follows reports it
+    return result > 0;
+}
+
 void CLineClient::Quit()
 {
+    if( m_binary )
+    {
+        boost::uint32_t handle = 0;
+        Exchange( OP_QUIT, handle, 0.0 );
+        m_binary = false;
+        m_socket.close();
+        return;
+    }
+    
     boost::asio::streambuf request;
     std::ostream request_stream( &request );
     
@@ -141,6 +402,14 @@ void CLineClient::Quit()
     m_socket.close();
 }
 
+void CLineClient::Close()
+{
+    boost::system::error_code error;
+    
+    // ignore errors from a socket that is already broken
+    m_socket.close(error);
+}
+
 CLineClient::~CLineClient()
 {
     //  perform teardown
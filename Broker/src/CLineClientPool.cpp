@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CLineClientPool.cpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @see            CLineClientPool.hpp
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CLineClientPool.hpp"
+
+#include <exception>
+#include <stdexcept>
+
+namespace freedm{
+  namespace broker{
+
+CLineClientPool::TPointer CLineClientPool::Create( boost::asio::io_service & p_service,
+    const std::string p_hostname, const std::string p_port, size_t p_size )
+{
+    return CLineClientPool::TPointer(
+        new CLineClientPool(p_service, p_hostname, p_port, p_size) );
+}
+
+CLineClientPool::CLineClientPool( boost::asio::io_service & p_service,
+    const std::string p_hostname, const std::string p_port, size_t p_size )
+    : m_hostname(p_hostname), m_port(p_port)
+{
+    if( p_size == 0 )
+    {
+        throw std::invalid_argument(
+            "the line client pool needs at least one connection");
+    }
+
+    for( size_t i = 0; i < p_size; i++ )
+    {
+        CLineClient::TPointer client = CLineClient::Create(p_service);
+        client->Connect(m_hostname, m_port);
+        m_clients.push_back(client);
+        m_idle.push_back(client);
+    }
+}
+
+CLineClient::TPointer CLineClientPool::Checkout()
+{
+    CLineClient::TPointer client;
+
+    {
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+        while( m_idle.empty() )
+        {
+            m_available.wait(lock);
+        }
+        client = m_idle.back();
+        m_idle.pop_back();
+    }
+
+    if( !client->IsOpen() )
+    {
+        try
+        {
+            client->Connect(m_hostname, m_port);
+        }
+        catch( ... )
+        {
+            // keep the client in the pool for a later attempt
+            Return(client, true);
+            throw;
+        }
+    }
+
+    return client;
+}
+
+void CLineClientPool::Return( CLineClient::TPointer p_client, bool p_broken )
+{
+    if( p_broken )
+    {
+        p_client->Close();
+    }
+
+    {
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+        m_idle.push_back(p_client);
+    }
+    m_available.notify_one();
+}
+
+CLineClientPool::CLease::CLease( CLineClientPool & p_pool )
+    : m_pool(p_pool), m_client(p_pool.Checkout())
+{
+    // skip
+}
+
+CLineClientPool::CLease::~CLease()
+{
+    m_pool.Return(m_client, std::uncaught_exception());
+}
+
+  }//namespace broker
+}//namespace freedm
@@ -66,7 +66,7 @@ CListener::CListener(boost::asio::io_service& p_ioService,
   CConnectionManager& p_manager, CDispatcher& p_dispatch, std::string uuid)
   : CReliableConnection(p_ioService,p_manager,p_dispatch,uuid)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -78,7 +78,7 @@ CListener::CListener(boost::asio::io_service& p_ioService,
 ///////////////////////////////////////////////////////////////////////////////
 void CListener::Start()
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     GetSocket().async_receive_from(boost::asio::buffer(m_buffer, 8192), m_endpoint,
         boost::bind(&CListener::HandleRead, this,
             boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred));
@@ -95,7 +95,7 @@ void CListener::Start()
 ///////////////////////////////////////////////////////////////////////////////
 void CListener::Stop()
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 }
  
 ///////////////////////////////////////////////////////////////////////////////
@@ -110,13 +110,13 @@ void CListener::Stop()
 //////////////////////////////////////////////////////////////////////////////
 void CListener::SendACK(std::string uuid, std:: string hostname, unsigned int sequenceno)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     freedm::broker::CMessage m_;
     // Make sure the connection is registered:
     GetConnectionManager().PutHostname(uuid,hostname);
     m_.SetStatus(freedm::broker::CMessage::Accepted);
     m_.SetSequenceNumber(sequenceno);
-    Logger::Info<<"Send ACK #"<<sequenceno<<std::endl;
+    LOG_INFO<<"Send ACK #"<<sequenceno<<std::endl;
     GetConnectionManager().GetConnectionByUUID(uuid, GetSocket().get_io_service(), GetDispatcher())->Send(m_,false);
 }
 
@@ -134,10 +134,10 @@ void CListener::SendACK(std::string uuid, std:: string hostname, unsigned int se
 ///////////////////////////////////////////////////////////////////////////////
 void CListener::HandleRead(const boost::system::error_code& e, std::size_t bytes_transferred)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;       
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;       
     if (!e)
     {
-        Logger::Info << "Handled some message." << std::endl;
+        LOG_INFO << "Handled some message." << std::endl;
         boost::tribool result_;
         boost::tie(result_, boost::tuples::ignore) = Parse(
             m_message, m_buffer.data(),
@@ -155,7 +155,7 @@ void CListener::HandleRead(const boost::system::error_code& e, std::size_t bytes
             #ifdef CUSTOMNETWORK
             if((rand()%100) >= GetReliability())
             {
-                Logger::Info<<"Incoming Packet Dropped ("<<GetReliability()
+                LOG_INFO<<"Incoming Packet Dropped ("<<GetReliability()
                               <<") -> "<<uuid<<std::endl;
                 goto listen;
             }
@@ -168,19 +168,19 @@ void CListener::HandleRead(const boost::system::error_code& e, std::size_t bytes
             #endif
             if(m_message.GetStatus() == freedm::broker::CMessage::Accepted)
             {
-                Logger::Info << "Got ACK #" << sequenceno << std::endl;
+                LOG_INFO << "Got ACK #" << sequenceno << std::endl;
                 GetConnectionManager().PutHostname(uuid,hostname);
                 GetConnectionManager().GetConnectionByUUID(uuid, GetSocket().get_io_service(), GetDispatcher())->RecieveACK(sequenceno);
             }
             else if(m_message.GetStatus() == freedm::broker::CMessage::Created)
             {
-                Logger::Info << "Got SYN #" << sequenceno << std::endl;
+                LOG_INFO << "Got SYN #" << sequenceno << std::endl;
                 m_insequenceno[uuid] = sequenceno;
                 SendACK(uuid,hostname,m_insequenceno[uuid]);
             }
             else if(m_insequenceno.find(uuid) != m_insequenceno.end())
             {
-                Logger::Info << "Got Message #" << sequenceno << " expected " 
+                LOG_INFO << "Got Message #" << sequenceno << " expected " 
                                << m_insequenceno[uuid]+1 % GetSequenceModulo() << std::endl;
                 if(sequenceno == (m_insequenceno[uuid]+1) % GetSequenceModulo())
                 {
@@ -40,9 +40,9 @@ namespace freedm {
 		/// @brief  constructor. The device type is always LOAD.
 		/// @param phymanager The related physical device manager.
 		/// @param deviceid The identifier for this generic device.
-		/// @param lineClient  the client that connects to the PSCAD interface
+		/// @param lineClient  the client pool that connects to the PSCAD interface
 		///////////////////////////////////////////////////////////////////////////////
-		CLoadDevice::CLoadDevice(CLineClient::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid)  
+		CLoadDevice::CLoadDevice(CLineClientPool::TPointer lineClient, CPhysicalDeviceManager& phymanager, IPhysicalDevice::Identifier deviceid)  
 			: CPSCADDevice(lineClient, phymanager, deviceid, physicaldevices::LOAD)
 		{};
 
@@ -53,7 +53,7 @@ namespace freedm {
 		///////////////////////////////////////////////////////////////////////////////
 		CLoadDevice:: SettingValue CLoadDevice::get_powerLevel()
 		{
-			return CPSCADDevice::Get("powerLevel");
+			return CPSCADDevice::Get(physicaldevices::POWER_LEVEL);
 		}
 
 		/////////////////////////////////////////////////////////////////////////////
@@ -62,7 +62,7 @@ namespace freedm {
 		///////////////////////////////////////////////////////////////////////////////
 		void CLoadDevice::turnOn()
 		{
-			CPSCADDevice::Set("onOffSwitch", 0);
+			CPSCADDevice::Set(physicaldevices::ON_OFF_SWITCH, 0);
 		}
 
 		/////////////////////////////////////////////////////////////////////////////
@@ -71,7 +71,7 @@ namespace freedm {
 		///////////////////////////////////////////////////////////////////////////////
 		void CLoadDevice::turnOff()
 		{
-			CPSCADDevice::Set("onOffSwitch", 1);
+			CPSCADDevice::Set(physicaldevices::ON_OFF_SWITCH, 1);
 		}
 
     } // namespace broker
@@ -0,0 +1,327 @@
+///////////////////////////////////////////////////////////////////////////////
+/// @file      CLogWriter.cpp
+///
+/// @author    Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler  C++
+///
+/// @project   FREEDM DGI
+///
+/// @description Background writer that batches the output of the standard logs
+///
+/// @license
+/// These source code files were created at as part of the
+/// FREEDM DGI Subthrust, and are
+/// intended for use in teaching or research.  They may be
+/// freely copied, modified and redistributed as long
+/// as modified versions are clearly marked as such and
+/// this notice is not removed.
+///
+/// Neither the authors nor the FREEDM Project nor the
+/// National Science Foundation
+/// make any warranty, express or implied, nor assumes
+/// any legal responsibility for the accuracy,
+/// completeness or usefulness of these codes or any
+/// information distributed with these codes.
+///
+/// Suggested modifications or questions about these codes
+/// can be directed to Dr. Bruce McMillin, Department of
+/// Computer Science, Missour University of Science and
+/// Technology, Rolla, /// MO  65409 (ff@mst.edu).
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CLogWriter.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+namespace freedm {
+namespace broker {
+
+namespace {
+
+/// The reference point for the stored timestamps
+const boost::posix_time::ptime EPOCH(boost::gregorian::date(1970, 1, 1));
+
+/// Milliseconds the writer thread sleeps when every ring is empty
+const long POLL_INTERVAL = 10;
+
+/// Rounds p_capacity up to a power of two
+size_t RoundCapacity(size_t p_capacity)
+{
+    size_t capacity = 2;
+    while(capacity < p_capacity)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+} // unnamed namespace
+
+const size_t CLogWriter::DEFAULT_CAPACITY;
+const size_t CLogWriter::RECORD_TEXT;
+
+CLogWriter * CLogWriter::s_instance = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CLogWriter::Ring::Ring
+/// @brief Creates an empty ring.
+/// @param p_capacity The number of records, a power of two.
+///////////////////////////////////////////////////////////////////////////////
+CLogWriter::Ring::Ring(size_t p_capacity)
+    : m_records(new Record[p_capacity])
+    , m_mask(p_capacity - 1)
+    , m_head(0)
+    , m_tail(0)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CLogWriter
+/// @brief Opens the output and routes the standard logs through the writer.
+/// @pre No other writer exists. No other thread is logging.
+/// @post The standard logs queue their messages until the writer is
+///       destroyed.
+/// @param p_file The file the logs are appended to, or empty for std::clog.
+/// @param p_capacity The minimum number of records in each thread's ring.
+/// @limitations Throws std::runtime_error if the file cannot be opened.
+///////////////////////////////////////////////////////////////////////////////
+CLogWriter::CLogWriter(const std::string & p_file, size_t p_capacity)
+    : m_output(&std::clog)
+    , m_capacity(RoundCapacity(p_capacity))
+    , m_localRing(&CLogWriter::KeepRing)
+    , m_dropped(0)
+    , m_reported(0)
+    , m_stop(false)
+{
+    if(!p_file.empty())
+    {
+        m_file.open(p_file.c_str(), std::ios::out | std::ios::app);
+        if(!m_file)
+        {
+            throw std::runtime_error("Unable to open log file " + p_file);
+        }
+        m_output = &m_file;
+    }
+
+    m_thread = boost::thread(boost::bind(&CLogWriter::Run, this));
+    s_instance = this;
+    Logger::Log::setSink(&CLogWriter::Append);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CLogWriter::~CLogWriter
+/// @brief Stops the writer thread once it has written every queued message.
+/// @pre No other thread is logging.
+/// @post The standard logs write directly to their streams again.
+///////////////////////////////////////////////////////////////////////////////
+CLogWriter::~CLogWriter()
+{
+    Logger::Log::setSink(0);
+    s_instance = 0;
+
+    m_stop.store(true, boost::memory_order_release);
+    m_thread.join();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CLogWriter::Append
+/// @brief Queues a log message on the current writer.
+/// @param p_level The level of the log.
+/// @param p_name The name of the log.
+/// @param p_text The message text, not terminated.
+/// @param p_length The number of characters in p_text.
+///////////////////////////////////////////////////////////////////////////////
+void CLogWriter::Append(int p_level, const char * p_name, const char * p_text,
+    std::streamsize p_length)
+{
+    CLogWriter * writer = s_instance;
+
+    if(writer != 0)
+    {
+        writer->Push(p_level, p_name, p_text, p_length);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CLogWriter::Earlier
+/// @brief Orders records by the time they were logged.
+/// @return True if p_first was logged before p_second.
+///////////////////////////////////////////////////////////////////////////////
+bool CLogWriter::Earlier(const Record & p_first, const Record & p_second)
+{
+    return p_first.m_time < p_second.m_time;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CLogWriter::KeepRing
+/// @brief Cleanup of the thread-specific pointer; m_rings owns the ring and
+///        the writer may still have records of the exited thread to write.
+///////////////////////////////////////////////////////////////////////////////
+void CLogWriter::KeepRing(Ring *)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CLogWriter::GetRing
+/// @brief Gets the ring of the calling thread. The first call from a thread
+///        allocates its ring and registers it with the writer thread.
+/// @return The ring of the calling thread.
+///////////////////////////////////////////////////////////////////////////////
+CLogWriter::Ring & CLogWriter::GetRing()
+{
+    Ring * ring = m_localRing.get();
+
+    if(ring == 0)
+    {
+        boost::shared_ptr<Ring> created(new Ring(m_capacity));
+        {
+            boost::mutex::scoped_lock lock(m_ringMutex);
+            m_rings.push_back(created);
+        }
+        m_localRing.reset(created.get());
+        ring = created.get();
+    }
+
+    return *ring;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CLogWriter::Push
+/// @brief Copies a message into consecutive records of the calling thread's
+///        ring. The message is dropped whole if the ring lacks the room.
+/// @post The records are visible to the writer thread, or m_dropped is
+///       incremented.
+/// @param p_level The level of the log.
+/// @param p_name The name of the log.
+/// @param p_text The message text, not terminated.
+/// @param p_length The number of characters in p_text.
+///////////////////////////////////////////////////////////////////////////////
+void CLogWriter::Push(int p_level, const char * p_name, const char * p_text,
+    std::streamsize p_length)
+{
+    Ring & ring = GetRing();
+    size_t length = p_length > 0 ? static_cast<size_t>(p_length) : 0;
+    size_t count = std::max<size_t>((length + RECORD_TEXT - 1) / RECORD_TEXT, 1);
+    boost::uint64_t head = ring.m_head.load(boost::memory_order_relaxed);
+    boost::uint64_t tail = ring.m_tail.load(boost::memory_order_acquire);
+    boost::int64_t time;
+
+    if(count > m_capacity - (head - tail))
+    {
+        m_dropped.fetch_add(1, boost::memory_order_relaxed);
+        return;
+    }
+
+    time = (boost::posix_time::microsec_clock::local_time() - EPOCH)
+        .total_microseconds();
+    for(size_t i = 0; i < count; i++)
+    {
+        Record & record = ring.m_records[(head + i) & ring.m_mask];
+        size_t offset = i * RECORD_TEXT;
+
+        record.m_time = time;
+        record.m_name = p_name;
+        record.m_level = p_level;
+        record.m_length = std::min(RECORD_TEXT, length - offset);
+        record.m_continued = (i > 0);
+        std::memcpy(record.m_text, p_text + offset, record.m_length);
+    }
+    ring.m_head.store(head + count, boost::memory_order_release);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CLogWriter::Run
+/// @brief Writes batches until the writer is destroyed, sleeping while every
+///        ring is empty.
+/// @post Every record queued before m_stop was set has been written.
+///////////////////////////////////////////////////////////////////////////////
+void CLogWriter::Run()
+{
+    while(!m_stop.load(boost::memory_order_acquire))
+    {
+        if(Flush() == 0)
+        {
+            boost::this_thread::sleep(
+                boost::posix_time::milliseconds(POLL_INTERVAL));
+        }
+    }
+    Flush();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CLogWriter::Flush
+/// @brief Takes the queued records of every ring, orders them by time and
+///        writes them with a single call on the output. A message about the
+///        records dropped since the last flush follows them.
+/// @return The number of records written.
+///////////////////////////////////////////////////////////////////////////////
+size_t CLogWriter::Flush()
+{
+    std::vector<boost::shared_ptr<Ring> > rings;
+    std::ostringstream out;
+    boost::uint64_t dropped;
+
+    {
+        boost::mutex::scoped_lock lock(m_ringMutex);
+        rings = m_rings;
+    }
+
+    m_batch.clear();
+    for(size_t i = 0; i < rings.size(); i++)
+    {
+        Ring & ring = *rings[i];
+        boost::uint64_t head = ring.m_head.load(boost::memory_order_acquire);
+        boost::uint64_t tail = ring.m_tail.load(boost::memory_order_relaxed);
+
+        for(boost::uint64_t n = tail; n < head; n++)
+        {
+            m_batch.push_back(ring.m_records[n & ring.m_mask]);
+        }
+        ring.m_tail.store(head, boost::memory_order_release);
+    }
+
+    // the records of one message share a time, so a stable sort keeps them
+    // together and in order
+    std::stable_sort(m_batch.begin(), m_batch.end(), &CLogWriter::Earlier);
+
+    for(size_t i = 0; i < m_batch.size(); i++)
+    {
+        const Record & record = m_batch[i];
+
+        if(!record.m_continued)
+        {
+            out << EPOCH + boost::posix_time::microseconds(record.m_time)
+                << " : " << record.m_name << "(" << record.m_level << "):\t";
+        }
+        out.write(record.m_text, record.m_length);
+    }
+
+    dropped = m_dropped.load(boost::memory_order_relaxed);
+    if(dropped != m_reported)
+    {
+        out << boost::posix_time::microsec_clock::local_time() << " : "
+            << "Logger:\t" << dropped - m_reported
+            << " messages dropped on full log buffers" << std::endl;
+        m_reported = dropped;
+    }
+
+    if(out.tellp() > 0)
+    {
+        *m_output << out.str();
+        m_output->flush();
+    }
+
+    return m_batch.size();
+}
+
+} // namespace broker
+} // namespace freedm
@@ -133,7 +133,7 @@ namespace status_strings {
 bool CMessage::Load( std::istream &p_is )
     throw ( boost::property_tree::file_parser_error )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     using boost::property_tree::ptree;
     ptree pt;
     bool result;
@@ -152,9 +152,9 @@ bool CMessage::Load( std::istream &p_is )
     // return false;
     try 
     {
-        Logger::Debug << "Loading pt." << std::endl;
+        LOG_DEBUG << "Loading pt." << std::endl;
         *this = CMessage( pt );
-        Logger::Debug << "UUID: " << m_srcUUID << std::endl
+        LOG_DEBUG << "UUID: " << m_srcUUID << std::endl
                 << "Status: "
                 << status_strings::toString( m_status )
         << std::endl;
@@ -180,7 +180,7 @@ bool CMessage::Load( std::istream &p_is )
 ///////////////////////////////////////////////////////////////////////////////
 void CMessage::Save( std::ostream &p_os )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     using boost::property_tree::ptree;
     ptree pt;
 
@@ -198,7 +198,7 @@ void CMessage::Save( std::ostream &p_os )
 ///////////////////////////////////////////////////////////////////////////////
 CMessage::operator ptree ()
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     // This is basically the same as Save() except it doesn't
     // perform the XML conversion
     using boost::property_tree::ptree;
@@ -221,7 +221,7 @@ CMessage::operator ptree ()
 ///////////////////////////////////////////////////////////////////////////////
 CMessage::CMessage( const ptree &pt )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     try
     {
         // Get the source host's ID and store it in the m_src variable.
@@ -241,7 +241,7 @@ CMessage::CMessage( const ptree &pt )
     }
     catch( boost::property_tree::ptree_error &e )
     {
-         Logger::Error << "Invalid CMessage ptree format:"
+         LOG_ERROR << "Invalid CMessage ptree format:"
                  << e.what() << std::endl;
          throw;
     }
@@ -33,7 +33,6 @@
 #include "CPSCADDevice.hpp"
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
-#include <boost/lexical_cast.hpp>
 
 namespace freedm {
     namespace broker {
@@ -41,10 +40,10 @@ namespace freedm {
         /// @fn CPSCADDevice
         /// @brief constructor
         /// @param phymanager The related physical device manager.
-        /// @param client The LineClient that connectsto PSCAD interface
+        /// @param lineClient The pool of LineClients that connect to PSCAD interface
         /// @param deviceid The identifier for this device.
         ///////////////////////////////////////////////////////////////////////////////
-        CPSCADDevice::CPSCADDevice(CLineClient::TPointer lineClient, CPhysicalDeviceManager& phymanager, Identifier deviceid, DeviceType devtype)
+        CPSCADDevice::CPSCADDevice(CLineClientPool::TPointer lineClient, CPhysicalDeviceManager& phymanager, Identifier deviceid, DeviceType devtype)
             : m_lineClient(lineClient), IPhysicalDevice(phymanager, deviceid, devtype) 
         {};
 
@@ -54,13 +53,11 @@ namespace freedm {
         /// @param key The key to retrieve from PSCAD
         /// @return The value from PSCAD
         ///////////////////////////////////////////////////////////////////////////////
-        CPSCADDevice::SettingValue CPSCADDevice::Get(SettingKey key)
+        CPSCADDevice::SettingValue CPSCADDevice::Get(SettingKeyId key)
         {
-            std::string response = m_lineClient->Get(m_devid, key);
-
-            double anumber =  boost::lexical_cast<double>(response);
- 
-            return anumber;
+            std::string name = CSettingKeyTable::instance().GetName(key);
+            CLineClientPool::CLease client(*m_lineClient);
+            return client->GetValue(m_devid, name);
         };
 
         ///////////////////////////////////////////////////////////////////////////////
@@ -69,10 +66,11 @@ namespace freedm {
         /// @param key The key to change.
         /// @param value The value to set the key to.
         ///////////////////////////////////////////////////////////////////////////////
-        void CPSCADDevice::Set(SettingKey key, SettingValue value)
+        void CPSCADDevice::Set(SettingKeyId key, SettingValue value)
         {
-            std::string valueInString = boost::lexical_cast<std::string>(value);
-            m_lineClient->Set(m_devid, key, valueInString);
+            std::string name = CSettingKeyTable::instance().GetName(key);
+            CLineClientPool::CLease client(*m_lineClient);
+            client->SetValue(m_devid, name, value);
         };
 
     } // namespace broker
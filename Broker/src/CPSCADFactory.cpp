@@ -32,27 +32,90 @@
 
 #include "CPSCADFactory.hpp"
 
+#include <boost/bind.hpp>
+
 namespace freedm {
 namespace broker {
 
 /// Creates an instance of a PSCAD device factory
 CPSCADFactory::CPSCADFactory( CPhysicalDeviceManager & p_devman,
     boost::asio::io_service & p_ios, const std::string & p_host,
-    const std::string & p_port )
+    const std::string & p_port, size_t p_connections, long p_stepTimeout )
     : m_manager(p_devman)
-    , m_client(CLineClient::Create(p_ios))
+    , m_step(0)
+    , m_stepTimeout(p_stepTimeout)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     
     // connect to the simulation server
-    m_client->Connect(p_host,p_port);
+    m_client = CLineClientPool::Create(p_ios,p_host,p_port,p_connections);
+    LOG_INFO << "Opened " << p_connections << " connections to "
+        << p_host << ":" << p_port << std::endl;
+    
+    // keep the control cycle in step with a simulation run in lockstep
+    if( m_stepTimeout > 0 )
+    {
+        m_manager.SetStepHooks( boost::bind(&CPSCADFactory::WaitForStep, this),
+            boost::bind(&CPSCADFactory::FinishStep, this) );
+        LOG_INFO << "Waiting up to " << m_stepTimeout
+            << " ms for each PSCAD step" << std::endl;
+    }
+}
+
+/// Waits until the simulation has a step newer than m_step, false if none
+bool CPSCADFactory::WaitForStep()
+{
+    boost::uint64_t last = m_step;
+    
+    try
+    {
+        // the wait runs on the broker's event loop, so it must be bounded
+        CLineClientPool::CLease client(*m_client);
+        m_step = client->WaitForStep(m_step, m_stepTimeout);
+    }
+    catch( std::exception & e )
+    {
+        // an older server has no steps; the devices read its latest values
+        LOG_WARN << "Cannot wait for a PSCAD step: " << e.what() << std::endl;
+        return true;
+    }
+    
+    if( m_step == last )
+    {
+        LOG_DEBUG << "No PSCAD step after " << last << " within "
+            << m_stepTimeout << " ms" << std::endl;
+        return false;
+    }
+    
+    LOG_DEBUG << "PSCAD step " << m_step << " available" << std::endl;
+    return true;
+}
+
+/// Tells the simulation that the commands for m_step have been issued
+void CPSCADFactory::FinishStep()
+{
+    if( m_step == 0 )
+    {
+        return;
+    }
+    
+    try
+    {
+        CLineClientPool::CLease client(*m_client);
+        client->FinishStep(m_step);
+    }
+    catch( std::exception & e )
+    {
+        LOG_WARN << "Cannot finish PSCAD step " << m_step << ": "
+            << e.what() << std::endl;
+    }
 }
 
 /// Creates the family of PSCAD-enabled devices
 void CPSCADFactory::CreateDevice( const std::string & p_type,
     const IPhysicalDevice::Identifier & p_devid )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     
     DevicePtr device;
     
@@ -79,12 +142,12 @@ void CPSCADFactory::CreateDevice( const std::string & p_type,
     }
     else
     {
-        Logger::Error << "Cannot add " << p_type << " device" << std::endl;
+        LOG_ERROR << "Cannot add " << p_type << " device" << std::endl;
         return;
     }
     m_manager.AddDevice(device);
     
-    Logger::Debug << "Added " << p_type << " device " << p_devid << std::endl;
+    LOG_DEBUG << "Added " << p_type << " device " << p_devid << std::endl;
 }
 
 } // namespace broker
@@ -61,7 +61,16 @@ CPhysicalDeviceManager::CPhysicalDeviceManager()
 ///////////////////////////////////////////////////////////////////////////////
 void CPhysicalDeviceManager::AddDevice(IPhysicalDevice::DevicePtr resource)
 {
+    iterator di = m_devices.find(resource->GetID());
+    if(di != m_devices.end())
+    {
+        RemoveFromTypeIndex(di->second);
+    }
     m_devices[resource->GetID()] = resource;
+
+    TypeIndex & index = m_types[resource->GetType()];
+    index.m_devices.push_back(resource);
+    index.m_powerLevels.push_back(0.0);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -73,7 +82,37 @@ void CPhysicalDeviceManager::AddDevice(IPhysicalDevice::DevicePtr resource)
 ///////////////////////////////////////////////////////////////////////////////
 void CPhysicalDeviceManager::RemoveDevice(IPhysicalDevice::Identifier devid)
 {
-    m_devices.erase(devid);
+    iterator di = m_devices.find(devid);
+    if(di != m_devices.end())
+    {
+        RemoveFromTypeIndex(di->second);
+        m_devices.erase(di);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CPhysicalDeviceManager::RemoveFromTypeIndex
+/// @brief Removes the device from the list of devices that share its type.
+/// @pre The device is in the list for its type.
+/// @post The device and its cached power level are removed. The last device
+///       of the list takes its place, so the list order is not preserved.
+/// @param resource The device to remove from its type index.
+///////////////////////////////////////////////////////////////////////////////
+void CPhysicalDeviceManager::RemoveFromTypeIndex(
+    IPhysicalDevice::DevicePtr resource)
+{
+    TypeIndex & index = m_types[resource->GetType()];
+    for(size_t i = 0; i < index.m_devices.size(); i++)
+    {
+        if(index.m_devices[i] == resource)
+        {
+            index.m_devices[i] = index.m_devices.back();
+            index.m_powerLevels[i] = index.m_powerLevels.back();
+            index.m_devices.pop_back();
+            index.m_powerLevels.pop_back();
+            return;
+        }
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -125,6 +164,140 @@ size_t CPhysicalDeviceManager::DeviceCount() const
     return m_devices.size();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CPhysicalDeviceManager::DeviceCount
+/// @brief returns a count of the tracked devices of a single type
+/// @pre The object is initialized
+/// @post No change.
+/// @param type The device type to count.
+/// @return The number of devices of the given type currently being tracked.
+///////////////////////////////////////////////////////////////////////////////
+size_t CPhysicalDeviceManager::DeviceCount(
+    IPhysicalDevice::DeviceType type) const
+{
+    return m_types[type].m_devices.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CPhysicalDeviceManager::GetDevicesOfType
+/// @brief Returns the list of tracked devices of a single type
+/// @pre The object is initialized
+/// @post No change.
+/// @param type The device type to retrieve.
+/// @return A list of the devices of the given type. The list is invalidated
+///         when a device is added or removed.
+///////////////////////////////////////////////////////////////////////////////
+const CPhysicalDeviceManager::DeviceList &
+CPhysicalDeviceManager::GetDevicesOfType(
+    IPhysicalDevice::DeviceType type) const
+{
+    return m_types[type].m_devices;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CPhysicalDeviceManager::RefreshPowerLevels
+/// @brief Reads the power level of every tracked device into the cache.
+/// @pre The object is initialized
+/// @post The cached power levels match the last reading of each device.
+/// @post Each reading is appended to the history of its device.
+/// @limitations Only one thread may refresh at a time since each device
+///              history accepts a single writer.
+///////////////////////////////////////////////////////////////////////////////
+void CPhysicalDeviceManager::RefreshPowerLevels()
+{
+    for(int type = 0; type < physicaldevices::DEVICE_TYPE_COUNT; type++)
+    {
+        TypeIndex & index = m_types[type];
+        for(size_t i = 0; i < index.m_devices.size(); i++)
+        {
+            index.m_powerLevels[i] = index.m_devices[i]->get_powerLevel();
+            index.m_devices[i]->GetHistory().Record(index.m_powerLevels[i]);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CPhysicalDeviceManager::GetNetPowerLevel
+/// @brief Sums the cached power levels of all devices of a single type.
+/// @pre RefreshPowerLevels has been called since the last device reading of
+///      interest.
+/// @post No change.
+/// @param type The device type to sum.
+/// @return The sum of the cached power levels, or 0.0 if there are none.
+/// @limitations The sum runs over a contiguous array with four independent
+///              accumulators so the compiler is free to use vector registers.
+///////////////////////////////////////////////////////////////////////////////
+IPhysicalDevice::SettingValue CPhysicalDeviceManager::GetNetPowerLevel(
+    IPhysicalDevice::DeviceType type) const
+{
+    const std::vector<IPhysicalDevice::SettingValue> & levels =
+        m_types[type].m_powerLevels;
+    size_t count = levels.size();
+    IPhysicalDevice::SettingValue sum[4] = { 0.0, 0.0, 0.0, 0.0 };
+    size_t i = 0;
+
+    if(count == 0)
+        return 0.0;
+
+    const IPhysicalDevice::SettingValue * data = &levels[0];
+    for(; i + 4 <= count; i += 4)
+    {
+        sum[0] += data[i];
+        sum[1] += data[i+1];
+        sum[2] += data[i+2];
+        sum[3] += data[i+3];
+    }
+    for(; i < count; i++)
+    {
+        sum[0] += data[i];
+    }
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CPhysicalDeviceManager::SetStepHooks
+/// @brief Sets the calls that pace the control cycle to a simulation.
+/// @pre None
+/// @post BeginStep and FinishStep call begin and finish.
+/// @param begin Waits for the next simulation step, false if none arrived.
+/// @param finish Reports that the commands for the step have been issued.
+///////////////////////////////////////////////////////////////////////////////
+void CPhysicalDeviceManager::SetStepHooks(BeginHook begin, StepHook finish)
+{
+    m_beginStep = begin;
+    m_finishStep = finish;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CPhysicalDeviceManager::BeginStep
+/// @brief Starts a control cycle on a new simulation step.
+/// @pre None
+/// @post The begin hook has returned, if one is set.
+/// @return False if the caller should skip this cycle, as no step arrived.
+/// @limitations Without hooks the cycle is paced by its caller alone.
+///////////////////////////////////////////////////////////////////////////////
+bool CPhysicalDeviceManager::BeginStep()
+{
+    if(m_beginStep)
+    {
+        return m_beginStep();
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CPhysicalDeviceManager::FinishStep
+/// @brief Ends a control cycle once its device commands have been issued.
+/// @pre BeginStep was called for this cycle.
+/// @post The finish hook has returned, if one is set.
+///////////////////////////////////////////////////////////////////////////////
+void CPhysicalDeviceManager::FinishStep()
+{
+    if(m_finishStep)
+    {
+        m_finishStep();
+    }
+}
 
 } // namespace broker
 } // namespace freedm
@@ -67,7 +67,7 @@ CReliableConnection::CReliableConnection(boost::asio::io_service& p_ioService,
     m_dispatch(p_dispatch),
     m_uuid(uuid)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     m_reliability = 100;
 }
 
@@ -80,7 +80,7 @@ CReliableConnection::CReliableConnection(boost::asio::io_service& p_ioService,
 ///////////////////////////////////////////////////////////////////////////////
 boost::asio::ip::udp::socket& CReliableConnection::GetSocket()
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
     return m_socket;
 }
@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////
+/// @file      CSettingKeyTable.cpp
+///
+/// @author    Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler  C++
+///
+/// @project   FREEDM DGI
+///
+/// @description Interns device setting keys into compact integer identifiers
+///
+/// @license
+/// These source code files were created at as part of the
+/// FREEDM DGI Subthrust, and are
+/// intended for use in teaching or research.  They may be
+/// freely copied, modified and redistributed as long
+/// as modified versions are clearly marked as such and
+/// this notice is not removed.
+///
+/// Neither the authors nor the FREEDM Project nor the
+/// National Science Foundation
+/// make any warranty, express or implied, nor assumes
+/// any legal responsibility for the accuracy,
+/// completeness or usefulness of these codes or any
+/// information distributed with these codes.
+///
+/// Suggested modifications or questions about these codes
+/// can be directed to Dr. Bruce McMillin, Department of
+/// Computer Science, Missour University of Science and
+/// Technology, Rolla, /// MO  65409 (ff@mst.edu).
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CSettingKeyTable.hpp"
+
+#include <stdexcept>
+
+namespace freedm {
+namespace broker {
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CSettingKeyTable
+/// @brief Creates the key table with the known setting keys registered.
+/// @post Each physicaldevices::KnownSettingKey maps to its key name.
+///////////////////////////////////////////////////////////////////////////////
+CSettingKeyTable::CSettingKeyTable()
+{
+    Intern("powerLevel");
+    Intern("onOffSwitch");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CSettingKeyTable::Intern
+/// @brief Returns the identifier of a key name. An unknown name is assigned
+///        the next free identifier.
+/// @pre None
+/// @post p_name is registered with the table.
+/// @param p_name The key name to intern.
+/// @return The identifier of p_name.
+///////////////////////////////////////////////////////////////////////////////
+physicaldevices::SettingKeyId CSettingKeyTable::Intern(
+    const std::string & p_name)
+{
+    std::map<std::string, physicaldevices::SettingKeyId>::const_iterator it;
+
+    {
+        boost::shared_lock<boost::shared_mutex> lock(m_mutex);
+        it = m_ids.find(p_name);
+        if(it != m_ids.end())
+            return it->second;
+    }
+
+    boost::unique_lock<boost::shared_mutex> lock(m_mutex);
+    // another thread may have registered the key between the locks
+    it = m_ids.find(p_name);
+    if(it != m_ids.end())
+        return it->second;
+
+    physicaldevices::SettingKeyId id = m_names.size();
+    m_names.push_back(p_name);
+    m_ids.insert(std::make_pair(p_name, id));
+    return id;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CSettingKeyTable::GetName
+/// @brief Returns the key name that was interned as the given identifier.
+///        Throws std::out_of_range if the identifier was never registered.
+/// @pre p_id was returned by Intern.
+/// @post No change.
+/// @param p_id The identifier to look up.
+/// @return The key name of p_id.
+///////////////////////////////////////////////////////////////////////////////
+std::string CSettingKeyTable::GetName(physicaldevices::SettingKeyId p_id) const
+{
+    boost::shared_lock<boost::shared_mutex> lock(m_mutex);
+    if(p_id >= m_names.size())
+        throw std::out_of_range("unregistered setting key identifier");
+    return m_names[p_id];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CSettingKeyTable::Size
+/// @brief Returns the number of registered key names.
+/// @post No change.
+/// @return The number of registered key names.
+///////////////////////////////////////////////////////////////////////////////
+size_t CSettingKeyTable::Size() const
+{
+    boost::shared_lock<boost::shared_mutex> lock(m_mutex);
+    return m_names.size();
+}
+
+} // namespace broker
+} // namespace freedm
@@ -0,0 +1,258 @@
+///////////////////////////////////////////////////////////////////////////////
+/// @file      CTimeSeries.cpp
+///
+/// @author    Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler  C++
+///
+/// @project   FREEDM DGI
+///
+/// @description Fixed-size lock-free history of timestamped device readings
+///
+/// @license
+/// These source code files were created at as part of the
+/// FREEDM DGI Subthrust, and are
+/// intended for use in teaching or research.  They may be
+/// freely copied, modified and redistributed as long
+/// as modified versions are clearly marked as such and
+/// this notice is not removed.
+///
+/// Neither the authors nor the FREEDM Project nor the
+/// National Science Foundation
+/// make any warranty, express or implied, nor assumes
+/// any legal responsibility for the accuracy,
+/// completeness or usefulness of these codes or any
+/// information distributed with these codes.
+///
+/// Suggested modifications or questions about these codes
+/// can be directed to Dr. Bruce McMillin, Department of
+/// Computer Science, Missour University of Science and
+/// Technology, Rolla, /// MO  65409 (ff@mst.edu).
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CTimeSeries.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+namespace freedm {
+namespace broker {
+
+namespace {
+
+/// The reference point for the stored timestamps
+const boost::posix_time::ptime EPOCH(boost::gregorian::date(1970, 1, 1));
+
+/// Converts a time to microseconds since EPOCH
+boost::int64_t ToMicroseconds(const boost::posix_time::ptime & p_time)
+{
+    return (p_time - EPOCH).total_microseconds();
+}
+
+/// Converts microseconds since EPOCH to a time
+boost::posix_time::ptime FromMicroseconds(boost::int64_t p_time)
+{
+    return EPOCH + boost::posix_time::microseconds(p_time);
+}
+
+} // unnamed namespace
+
+const size_t CTimeSeries::DEFAULT_CAPACITY;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CTimeSeries
+/// @brief Creates an empty time series.
+/// @post The capacity is p_capacity rounded up to a power of two.
+/// @param p_capacity The minimum number of samples to keep.
+///////////////////////////////////////////////////////////////////////////////
+CTimeSeries::CTimeSeries(size_t p_capacity)
+    : m_head(0)
+{
+    size_t capacity = 2;
+    while(capacity < p_capacity)
+    {
+        capacity <<= 1;
+    }
+    m_slots.reset(new Slot[capacity]);
+    m_mask = capacity - 1;
+
+    for(size_t i = 0; i < capacity; i++)
+    {
+        m_slots[i].m_sequence.store(0, boost::memory_order_relaxed);
+        m_slots[i].m_time.store(0, boost::memory_order_relaxed);
+        m_slots[i].m_value.store(0, boost::memory_order_relaxed);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CTimeSeries::Record
+/// @brief Records a reading with the current time.
+/// @pre No other thread is recording into this series.
+/// @post The oldest sample is overwritten once the buffer is full.
+/// @param p_value The value that was read.
+///////////////////////////////////////////////////////////////////////////////
+void CTimeSeries::Record(double p_value)
+{
+    Record(boost::posix_time::microsec_clock::universal_time(), p_value);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CTimeSeries::Record
+/// @brief Records a reading with the given time.
+/// @pre No other thread is recording into this series. Times are recorded in
+///      nondecreasing order.
+/// @post The oldest sample is overwritten once the buffer is full.
+/// @param p_time The time the reading was taken.
+/// @param p_value The value that was read.
+///////////////////////////////////////////////////////////////////////////////
+void CTimeSeries::Record(const boost::posix_time::ptime & p_time,
+    double p_value)
+{
+    boost::uint64_t n = m_head.load(boost::memory_order_relaxed);
+    Slot & slot = m_slots[n & m_mask];
+    boost::uint64_t bits;
+
+    std::memcpy(&bits, &p_value, sizeof(bits));
+
+    // mark the slot as in progress before any field changes
+    slot.m_sequence.store(2*n + 1, boost::memory_order_relaxed);
+    boost::atomic_thread_fence(boost::memory_order_release);
+    slot.m_time.store(ToMicroseconds(p_time), boost::memory_order_relaxed);
+    slot.m_value.store(bits, boost::memory_order_relaxed);
+    slot.m_sequence.store(2*n + 2, boost::memory_order_release);
+    m_head.store(n + 1, boost::memory_order_release);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CTimeSeries::Collect
+/// @brief Walks back from the newest sample until the window or the buffer
+///        ends. A slot the writer has claimed for a newer sample ends the walk
+///        since every older slot is about to be overwritten as well.
+/// @post p_samples holds the window, newest first.
+/// @param p_since Samples at or before this time are excluded.
+/// @param p_samples The destination for the samples.
+///////////////////////////////////////////////////////////////////////////////
+void CTimeSeries::Collect(boost::int64_t p_since,
+    std::vector<Sample> & p_samples) const
+{
+    boost::uint64_t head = m_head.load(boost::memory_order_acquire);
+    boost::uint64_t count = std::min<boost::uint64_t>(head, m_mask + 1);
+
+    p_samples.clear();
+    for(boost::uint64_t i = 1; i <= count; i++)
+    {
+        boost::uint64_t n = head - i;
+        const Slot & slot = m_slots[n & m_mask];
+
+        if(slot.m_sequence.load(boost::memory_order_acquire) != 2*n + 2)
+            break;
+        boost::int64_t time = slot.m_time.load(boost::memory_order_relaxed);
+        boost::uint64_t bits = slot.m_value.load(boost::memory_order_relaxed);
+        boost::atomic_thread_fence(boost::memory_order_acquire);
+        if(slot.m_sequence.load(boost::memory_order_relaxed) != 2*n + 2)
+            break;
+
+        if(time <= p_since)
+            break;
+
+        Sample sample;
+        sample.m_time = FromMicroseconds(time);
+        std::memcpy(&sample.m_value, &bits, sizeof(bits));
+        p_samples.push_back(sample);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CTimeSeries::GetWindow
+/// @brief Gets the samples recorded in the last p_seconds.
+/// @param p_seconds The length of the window.
+/// @return The samples in the window, oldest first.
+///////////////////////////////////////////////////////////////////////////////
+std::vector<CTimeSeries::Sample> CTimeSeries::GetWindow(double p_seconds) const
+{
+    return GetWindow(p_seconds,
+        boost::posix_time::microsec_clock::universal_time());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CTimeSeries::GetWindow
+/// @brief Gets the samples recorded in the p_seconds before p_now.
+/// @param p_seconds The length of the window.
+/// @param p_now The end of the window.
+/// @return The samples in the window, oldest first.
+///////////////////////////////////////////////////////////////////////////////
+std::vector<CTimeSeries::Sample> CTimeSeries::GetWindow(double p_seconds,
+    const boost::posix_time::ptime & p_now) const
+{
+    std::vector<Sample> samples;
+
+    Collect(ToMicroseconds(p_now) - static_cast<boost::int64_t>(p_seconds*1e6),
+        samples);
+    std::reverse(samples.begin(), samples.end());
+    return samples;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CTimeSeries::Summarize
+/// @brief Aggregates the samples recorded in the last p_seconds.
+/// @param p_seconds The length of the window.
+/// @return The aggregates of the window.
+///////////////////////////////////////////////////////////////////////////////
+CTimeSeries::Summary CTimeSeries::Summarize(double p_seconds) const
+{
+    return Summarize(p_seconds,
+        boost::posix_time::microsec_clock::universal_time());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @fn CTimeSeries::Summarize
+/// @brief Aggregates the samples recorded in the p_seconds before p_now.
+/// @param p_seconds The length of the window.
+/// @param p_now The end of the window.
+/// @return The aggregates of the window. Every field is 0 for an empty
+///         window and the slope is 0 unless two samples differ in time.
+///////////////////////////////////////////////////////////////////////////////
+CTimeSeries::Summary CTimeSeries::Summarize(double p_seconds,
+    const boost::posix_time::ptime & p_now) const
+{
+    std::vector<Sample> samples;
+    Summary summary = { 0, 0.0, 0.0, 0.0, 0.0 };
+
+    Collect(ToMicroseconds(p_now) - static_cast<boost::int64_t>(p_seconds*1e6),
+        samples);
+    if(samples.empty())
+        return summary;
+
+    // times are taken relative to the newest sample to keep them small
+    boost::posix_time::ptime origin = samples.front().m_time;
+    double sumT = 0.0, sumV = 0.0, sumTT = 0.0, sumTV = 0.0;
+
+    summary.m_count = samples.size();
+    summary.m_min = samples.front().m_value;
+    summary.m_max = samples.front().m_value;
+    for(size_t i = 0; i < samples.size(); i++)
+    {
+        double t = (samples[i].m_time - origin).total_microseconds() / 1e6;
+        double v = samples[i].m_value;
+
+        sumT += t;
+        sumV += v;
+        sumTT += t*t;
+        sumTV += t*v;
+        summary.m_min = std::min(summary.m_min, v);
+        summary.m_max = std::max(summary.m_max, v);
+    }
+
+    double n = static_cast<double>(summary.m_count);
+    double denominator = n*sumTT - sumT*sumT;
+
+    summary.m_mean = sumV / n;
+    if(denominator > 0.0)
+    {
+        summary.m_slope = (n*sumTV - sumT*sumV) / denominator;
+    }
+    return summary;
+}
+
+} // namespace broker
+} // namespace freedm
@@ -71,7 +71,7 @@ IPeerNode::IPeerNode(std::string uuid, ConnManagerPtr connmgr,
       m_ios(ios),
       m_dispatch(dispatch)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 }
 
 
@@ -86,7 +86,7 @@ IPeerNode::IPeerNode(std::string uuid, ConnManagerPtr connmgr,
 ////////////////////////////////////////////////////////////
 void IPeerNode::SetStatus(int status)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     m_status = status;
 }
 
@@ -129,16 +129,16 @@ bool IPeerNode::Send(freedm::broker::CMessage msg)
         }
         else
         {
-            Logger::Info << "Couldn't Send Message To Peer (Couldn't make connection)" << std::endl;
+            LOG_INFO << "Couldn't Send Message To Peer (Couldn't make connection)" << std::endl;
             return false;
         }
     }
     catch(boost::system::system_error& e)
     {
-        Logger::Info << "Couldn't Send Message To Peer (Sending Failed)" << std::endl;
+        LOG_INFO << "Couldn't Send Message To Peer (Sending Failed)" << std::endl;
         return false;
     }
-    Logger::Debug << "Sent message to peer" << std::endl;
+    LOG_DEBUG << "Sent message to peer" << std::endl;
     return true;
 }
 
@@ -55,6 +55,7 @@ namespace po = boost::program_options;
 #include "CConnectionManager.hpp"
 #include "CPhysicalDeviceManager.hpp"
 #include "CDeviceFactory.hpp"
+#include "CLogWriter.hpp"
 
 using namespace freedm;
 
@@ -82,7 +83,7 @@ std::string basename( const std::string &s )
 int main (int argc, char* argv[])
 {
     Logger::Log::setLevel( 3 );
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     // Variable Declaration
     po::options_description genOpts_("General Options"),
         configOpts_("Configuration"),
@@ -96,8 +97,11 @@ int main (int argc, char* argv[])
     std::ifstream ifs_;
     std::string cfgFile_, listenIP_, port_, uuid_, hostname_,uuidgenerator;
     // Line Client options
+    std::string logFile_;
     std::string interHost;
     std::string interPort;
+    unsigned int interConnections;
+    long interStepTimeout;
     int verbose_;
     bool cliVerbose_(false); // CLI options override verbosity
     freedm::uuid u_;
@@ -125,6 +129,12 @@ int main (int argc, char* argv[])
              default_value(""),"Hostname to use for the lineclient to connect.")
             ("lineclient-port,q", po::value<std::string>(&interPort)->
              default_value("4003"),"The port to use for the lineclient to connect.")
+            ("lineclient-connections", po::value<unsigned int>(&interConnections)->
+             default_value(1),"Number of lineclient connections shared by the devices.")
+            ("lineclient-lockstep", po::value<long>(&interStepTimeout)->
+             default_value(0),"Milliseconds the load balancer waits for each simulation step, 0 to not wait.")
+            ("log-file", po::value<std::string>(&logFile_)->
+             default_value(""), "file the logs are appended to (default: stderr)")
             ("verbose,v", po::value<int>(&verbose_)->
              implicit_value(5)->default_value(3),
              "enable verbose output (optionally specify level)");
@@ -173,14 +183,14 @@ int main (int argc, char* argv[])
             if( !vm_["config"].defaulted() )
             { // User specified a config file, so we should let
                 // them know that we can't load it
-                Logger::Error << "Unable to load config file: "
+                LOG_ERROR << "Unable to load config file: "
                               << cfgFile_ << std::endl;
                 return -1;
             }
             else
             {
                 // File doesn't exist or couldn't open it for read.
-                Logger::Notice << "Config file doesn't exist. "
+                LOG_NOTICE << "Config file doesn't exist. "
                                << "Skipping." << std::endl;
             }
         }
@@ -189,7 +199,7 @@ int main (int argc, char* argv[])
             // Process the config
             po::store( parse_config_file(ifs_, cfgOpts_), vm_ );
             po::notify(vm_);
-            Logger::Info << "Config file successfully loaded."<< std::endl;
+            LOG_INFO << "Config file successfully loaded."<< std::endl;
         }
         if( cliVerbose_ == false && vm_.count("verbose") )
         {
@@ -223,18 +233,21 @@ int main (int argc, char* argv[])
         if( vm_.count("uuid") )
         {
             u_ = freedm::uuid(uuid_);
-            Logger::Info << "Loaded UUID: " << u_ << std::endl;
+            LOG_INFO << "Loaded UUID: " << u_ << std::endl;
         }
         else
         {
             // Try to resolve the host's dns name
             hostname_ = boost::asio::ip::host_name();
-            Logger::Info << "Hostname: " << hostname_ << std::endl;
+            LOG_INFO << "Hostname: " << hostname_ << std::endl;
             u_ = freedm::uuid::from_dns(hostname_);
-            Logger::Info << "Generated UUID: " << u_ << std::endl;
+            LOG_INFO << "Generated UUID: " << u_ << std::endl;
         }
 
     
+        // Write the logs from a background thread from here on
+        freedm::broker::CLogWriter logWriter_(logFile_);
+
         //constructors for initial mapping
         freedm::broker::CConnectionManager m_conManager(u_,std::string(hostname_));
         freedm::broker::CPhysicalDeviceManager m_phyManager;
@@ -244,8 +257,10 @@ int main (int argc, char* argv[])
         // create the device factory
         // interHost is the hostname of the machine that runs the simulation
         // interPort is the port number this DGI and simulation communicate in
+        // interStepTimeout paces the load balancer to a --lockstep simulation
         freedm::broker::CDeviceFactory factory(
-            m_phyManager, m_ios, interHost, interPort );
+            m_phyManager, m_ios, interHost, interPort, interConnections,
+            interStepTimeout );
 
         // Create Devices
         factory.CreateDevice( "solar", "pv3" );
@@ -329,7 +344,7 @@ int main (int argc, char* argv[])
         } 
         else 
         {
-            Logger::Info << "Not adding any hosts on startup." << std::endl;
+            LOG_INFO << "Not adding any hosts on startup." << std::endl;
         }    
         // Add the local connection to the hostname list
         m_conManager.PutHostname(uuidstr,"localhost");
@@ -339,14 +354,14 @@ int main (int argc, char* argv[])
         sigset_t old_mask;
         pthread_sigmask(SIG_BLOCK, &new_mask, &old_mask);
 
-        Logger::Info << "Starting CBroker thread" << std::endl;
+        LOG_INFO << "Starting CBroker thread" << std::endl;
         boost::thread thread_
             (boost::bind(&freedm::broker::CBroker::Run, &broker_));
 
         // Restore previous signals.
         pthread_sigmask(SIG_SETMASK, &old_mask, 0); 
     
-        Logger::Info << "Starting thread of Modules" << std::endl;
+        LOG_INFO << "Starting thread of Modules" << std::endl;
         boost::thread thread2_( boost::bind(&freedm::GMAgent::Run, &GM_)      
                                 , boost::bind(&freedm::lbAgent::LB, &LB_)
                                 , boost::bind(&freedm::SCAgent::SC, &SC_)
@@ -377,7 +392,7 @@ int main (int argc, char* argv[])
     }
     catch (std::exception& e)
     {
-        Logger::Error << "Exception in main():" << e.what() << "\n";
+        LOG_ERROR << "Exception in main():" << e.what() << "\n";
     }
 
     return 0;
@@ -184,7 +184,7 @@ GMAgent::GMAgent(std::string p_uuid, boost::asio::io_service &p_ios,
   GMPeerNode(p_uuid,p_conManager,p_ios,p_dispatch),
   m_timer(p_ios)
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   AddPeer(GetUUID());
   m_groupsformed = 0;
   m_groupsbroken = 0;
@@ -203,7 +203,7 @@ GMAgent::GMAgent(std::string p_uuid, boost::asio::io_service &p_ios,
 ///////////////////////////////////////////////////////////////////////////////
 GMAgent::~GMAgent()
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     m_UpNodes.clear();
     m_Coordinators.clear();
     m_AllPeers.clear();
@@ -340,9 +340,9 @@ freedm::broker::CMessage GMAgent::PeerList()
 		ss_ << peer_->GetUUID();
 	}
 	m_.m_submessages.put("lb.peers", ss_.str());
-	Logger::Debug << "Group List contains: " << m_.m_submessages.get<std::string>("lb.peers") << std::endl;
+	LOG_DEBUG << "Group List contains: " << m_.m_submessages.get<std::string>("lb.peers") << std::endl;
 	//m_.m_submessages.put("sc.peers", ss_.str());
-	//Logger::Debug << "Group List contains: " << m_.m_submessages.get<std::string>("sc.peers") << std::endl;
+	//LOG_DEBUG << "Group List contains: " << m_.m_submessages.get<std::string>("sc.peers") << std::endl;
   return m_;
 }
 ///////////////////////////////////////////////////////////////////////////////
@@ -383,7 +383,7 @@ void GMAgent::SystemState()
   } 
   nodestatus<<"Groups Elected/Formed: "<<m_groupselection<<"/"<<m_groupsformed<<std::endl;            
   nodestatus<<"Groups Joined/Broken: "<<m_groupsjoined<<"/"<<m_groupsbroken;            
-  Logger::Warn<<nodestatus.str()<<std::endl;
+  LOG_WARN<<nodestatus.str()<<std::endl;
 }
 ///////////////////////////////////////////////////////////////////////////////
 /// PushPeerList
@@ -401,16 +401,16 @@ void GMAgent::SystemState()
 ///////////////////////////////////////////////////////////////////////////////
 void GMAgent::PushPeerList()
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   freedm::broker::CMessage m_ = PeerList();
   foreach( PeerNodePtr peer_, m_UpNodes | boost::adaptors::map_values)
   {
-    Logger::Debug<<"Send group list to all members of this group containing "
+    LOG_DEBUG<<"Send group list to all members of this group containing "
                  << peer_->GetUUID() << std::endl;       
     peer_->AsyncSend(m_);        
   }
   GetPeer(GetUUID())->AsyncSend(m_);
-  Logger::Debug << __PRETTY_FUNCTION__ << "FINISH" <<  std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << "FINISH" <<  std::endl;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -424,23 +424,23 @@ void GMAgent::PushPeerList()
 ///////////////////////////////////////////////////////////////////////////////
 void GMAgent::Recovery()
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   std::stringstream ss_;
   SetStatus(GMPeerNode::ELECTION);
-  Logger::Notice << "+ State Change ELECTION : "<<__LINE__<<std::endl;
+  LOG_NOTICE << "+ State Change ELECTION : "<<__LINE__<<std::endl;
   m_GrpCounter++;
   m_GroupID = m_GrpCounter;
   m_GroupLeader = GetUUID();
-  Logger::Notice << "Changed group: "<< m_GroupID<<" ("<< m_GroupLeader <<")"<<std::endl;
+  LOG_NOTICE << "Changed group: "<< m_GroupID<<" ("<< m_GroupLeader <<")"<<std::endl;
   // Empties the UpList
   m_UpNodes.clear();
   SetStatus(GMPeerNode::REORGANIZATION);
-  Logger::Notice << "+ State Change REORGANIZATION : "<<__LINE__<<std::endl;
+  LOG_NOTICE << "+ State Change REORGANIZATION : "<<__LINE__<<std::endl;
   // Perform work assignments, etc here.
   SetStatus(GMPeerNode::NORMAL);
-  Logger::Notice << "+ State Change NORMAL : "<<__LINE__<<std::endl;
+  LOG_NOTICE << "+ State Change NORMAL : "<<__LINE__<<std::endl;
   // Go to work
-  Logger::Info << "TIMER: Setting CheckTimer (Check): " << __LINE__ << std::endl;
+  LOG_INFO << "TIMER: Setting CheckTimer (Check): " << __LINE__ << std::endl;
   m_timerMutex.lock();
   m_timer.expires_from_now( boost::posix_time::seconds(CHECK_TIMEOUT) );
   m_timer.async_wait( boost::bind(&GMAgent::Check, this, boost::asio::placeholders::error));
@@ -458,8 +458,8 @@ void GMAgent::Recovery()
 ///////////////////////////////////////////////////////////////////////////////
 void GMAgent::Recovery( const boost::system::error_code& err )
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
-  Logger::Info << "RECOVERY CALL" << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
+  LOG_INFO << "RECOVERY CALL" << std::endl;
   if(!err)
   {
     m_groupsbroken++;
@@ -467,10 +467,10 @@ void GMAgent::Recovery( const boost::system::error_code& err )
   }
   else if(boost::asio::error::operation_aborted == err )
   {
-    Logger::Info << "Testing recovery cycle" << std::endl;
+    LOG_INFO << "Testing recovery cycle" << std::endl;
     if(!IsCoordinator())
     {
-      Logger::Info << "TIMER: Setting TimeoutTimer (Timeout):" << __LINE__ << std::endl;
+      LOG_INFO << "TIMER: Setting TimeoutTimer (Timeout):" << __LINE__ << std::endl;
       // We are not the Coordinator, we must run Timeout()
       m_timerMutex.lock();
       m_timer.expires_from_now(boost::posix_time::seconds(TIMEOUT_TIMEOUT));
@@ -481,7 +481,7 @@ void GMAgent::Recovery( const boost::system::error_code& err )
   else
   {
     /* An error occurred or timer was canceled */
-    Logger::Error << err << std::endl;
+    LOG_ERROR << err << std::endl;
     throw boost::system::system_error(err);
   }
 }
@@ -497,7 +497,7 @@ void GMAgent::Recovery( const boost::system::error_code& err )
 ///////////////////////////////////////////////////////////////////////////////
 void GMAgent::Check( const boost::system::error_code& err )
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   if( !err )
   {
     SystemState();
@@ -508,7 +508,7 @@ void GMAgent::Check( const boost::system::error_code& err )
       m_Coordinators.clear();
       m_AYCResponse.clear();
       freedm::broker::CMessage m_ = AreYouCoordinator();
-      Logger::Info <<"SEND: Sending out AYC"<<std::endl;
+      LOG_INFO <<"SEND: Sending out AYC"<<std::endl;
       foreach( PeerNodePtr peer_, m_AllPeers | boost::adaptors::map_values)
       {
         if( peer_->GetUUID() == GetUUID())
@@ -517,7 +517,7 @@ void GMAgent::Check( const boost::system::error_code& err )
         InsertInPeerSet(m_AYCResponse,peer_);
       }
       // Wait for responses
-      Logger::Info << "TIMER: Setting GlobalTimer (Premerge): " << __LINE__ << std::endl;
+      LOG_INFO << "TIMER: Setting GlobalTimer (Premerge): " << __LINE__ << std::endl;
       m_timerMutex.lock();
       m_timer.expires_from_now( boost::posix_time::seconds(GLOBAL_TIMEOUT) );
       m_timer.async_wait(boost::bind(&GMAgent::Premerge, this,
@@ -532,7 +532,7 @@ void GMAgent::Check( const boost::system::error_code& err )
   else
   {
     /* An error occurred or timer was canceled */
-    Logger::Error << err << std::endl;
+    LOG_ERROR << err << std::endl;
     throw boost::system::system_error(err);
   }
 }
@@ -548,7 +548,7 @@ void GMAgent::Check( const boost::system::error_code& err )
 ///////////////////////////////////////////////////////////////////////////////
 void GMAgent::Premerge( const boost::system::error_code &err )
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   if( !err || (boost::asio::error::operation_aborted == err ))
   { 
     // Timer expired
@@ -562,7 +562,7 @@ void GMAgent::Premerge( const boost::system::error_code &err )
       {
         list_change = true;
         EraseInPeerSet(m_UpNodes,peer_);
-        Logger::Info << "No response from peer: "<<peer_->GetUUID()<<std::endl;
+        LOG_INFO << "No response from peer: "<<peer_->GetUUID()<<std::endl;
       }
     }
     if(list_change)
@@ -599,7 +599,7 @@ void GMAgent::Premerge( const boost::system::error_code &err )
       #endif
       boost::posix_time::seconds proportional_Timeout( wait_val_ );
       /* Set deadline timer to call Merge() */
-      Logger::Notice << "TIMER: Waiting for Merge(): " << wait_val_ << " seconds." << std::endl;
+      LOG_NOTICE << "TIMER: Waiting for Merge(): " << wait_val_ << " seconds." << std::endl;
       m_timerMutex.lock();
       m_timer.expires_from_now( proportional_Timeout );
       m_timer.async_wait( boost::bind(&GMAgent::Merge, this, boost::asio::placeholders::error ));
@@ -607,7 +607,7 @@ void GMAgent::Premerge( const boost::system::error_code &err )
     }
     else
     {  // We didn't find any other Coordinators, go back to work
-      Logger::Info << "TIMER: Setting CheckTimer (Check): " << __LINE__ << std::endl;
+      LOG_INFO << "TIMER: Setting CheckTimer (Check): " << __LINE__ << std::endl;
       m_timerMutex.lock();
       m_timer.expires_from_now( boost::posix_time::seconds(CHECK_TIMEOUT) );
       m_timer.async_wait( boost::bind(&GMAgent::Check, this, boost::asio::placeholders::error));
@@ -617,7 +617,7 @@ void GMAgent::Premerge( const boost::system::error_code &err )
   else
   { 
     // Unexpected error
-    Logger::Error << err << std::endl;
+    LOG_ERROR << err << std::endl;
     throw boost::system::system_error(err);
   }
 }
@@ -638,13 +638,13 @@ void GMAgent::Premerge( const boost::system::error_code &err )
 ///////////////////////////////////////////////////////////////////////////////
 void GMAgent::Merge( const boost::system::error_code& err )
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   if(!IsCoordinator())
   {
     // Premerge made me wait. If in the waiting period I accepted someone
     // else's invitation, I am no longer a Coordinator and don't need to worry
     // about performing this anymore.
-    Logger::Notice << "Skipping Merge(): No longer a Coordinator." << std::endl;
+    LOG_NOTICE << "Skipping Merge(): No longer a Coordinator." << std::endl;
     return;
   }
   if( !err )
@@ -652,19 +652,19 @@ void GMAgent::Merge( const boost::system::error_code& err )
     std::stringstream ss_;
     // This proc forms a new group by inviting Coordinators in CoordinatorSet
     SetStatus(GMPeerNode::ELECTION);
-    Logger::Notice << "+ State Change ELECTION : "<<__LINE__<<std::endl;
+    LOG_NOTICE << "+ State Change ELECTION : "<<__LINE__<<std::endl;
     // Update GroupID
     m_GrpCounter++;
     m_GroupID = m_GrpCounter;
     m_GroupLeader = GetUUID();
-    Logger::Notice << "Changed group: " << m_GroupID << " (" << m_GroupLeader << ")" << std::endl;
+    LOG_NOTICE << "Changed group: " << m_GroupID << " (" << m_GroupLeader << ")" << std::endl;
     // m_UpNodes are the members of my group.
     PeerSet tempSet_ = m_UpNodes;
     m_UpNodes.clear();
     // Create new invitation and send it to all Coordinators
     freedm::broker::CMessage m_ = Invitation();
-    Logger::Info <<"SEND: Sending out Invites (Invite Coordinators)"<<std::endl;
-    Logger::Debug <<"Tempset is "<<tempSet_.size()<<" Nodes (IC)"<<std::endl;
+    LOG_INFO <<"SEND: Sending out Invites (Invite Coordinators)"<<std::endl;
+    LOG_DEBUG <<"Tempset is "<<tempSet_.size()<<" Nodes (IC)"<<std::endl;
     foreach( PeerNodePtr peer_, m_Coordinators | boost::adaptors::map_values)
     {
       if( peer_->GetUUID() == GetUUID())
@@ -683,7 +683,7 @@ void GMAgent::Merge( const boost::system::error_code& err )
   }
   else
   {
-    Logger::Error << err << std::endl;
+    LOG_ERROR << err << std::endl;
     throw boost::system::system_error(err);
   }
   //m_CheckTimer.expires_from_now( boost::posix_time::seconds(CHECK_TIMEOUT) );
@@ -703,15 +703,15 @@ void GMAgent::Merge( const boost::system::error_code& err )
 ///////////////////////////////////////////////////////////////////////////////
 void GMAgent::InviteGroupNodes( const boost::system::error_code& err, PeerSet p_tempSet )
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   if( !err || err == boost::asio::error::operation_aborted )
   {
     /* If the timer expired, err should be false, if canceled,
      * second condition is true.  Timer should only be canceled if
      * we are no longer waiting on more replies                       */
     freedm::broker::CMessage m_ = Invitation();
-    Logger::Info <<"SEND: Sending out Invites (Invite Group Nodes):"<<std::endl;
-    Logger::Debug <<"Tempset is "<<p_tempSet.size()<<" Nodes (IGN)"<<std::endl;
+    LOG_INFO <<"SEND: Sending out Invites (Invite Group Nodes):"<<std::endl;
+    LOG_DEBUG <<"Tempset is "<<p_tempSet.size()<<" Nodes (IGN)"<<std::endl;
     foreach( PeerNodePtr peer_, p_tempSet | boost::adaptors::map_values)
     {
       if( peer_->GetUUID() == GetUUID())
@@ -720,7 +720,7 @@ void GMAgent::InviteGroupNodes( const boost::system::error_code& err, PeerSet p_
     }
     if(IsCoordinator())
     {   // We only call Reorganize if we are the new leader
-      Logger::Info << "TIMER: Setting GlobalTimer (Reorganize) : " << __LINE__ << std::endl;
+      LOG_INFO << "TIMER: Setting GlobalTimer (Reorganize) : " << __LINE__ << std::endl;
       m_timerMutex.lock();
       m_timer.expires_from_now(boost::posix_time::seconds(GLOBAL_TIMEOUT));
       m_timer.async_wait(boost::bind(&GMAgent::Reorganize, this, 
@@ -730,7 +730,7 @@ void GMAgent::InviteGroupNodes( const boost::system::error_code& err, PeerSet p_
   }
   else
   {
-    Logger::Error << err << std::endl;
+    LOG_ERROR << err << std::endl;
     throw boost::system::system_error(err);
   }
   return;
@@ -747,14 +747,14 @@ void GMAgent::InviteGroupNodes( const boost::system::error_code& err, PeerSet p_
 /////////////////////////////////////////////////////////////////////////////// 
 void GMAgent::Reorganize( const boost::system::error_code& err )
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   if( !err || err == boost::asio::error::operation_aborted )
   {
     SetStatus(GMPeerNode::REORGANIZATION);
-    Logger::Notice << "+ State change: REORGANIZATION: " << __LINE__  << std::endl; 
+    LOG_NOTICE << "+ State change: REORGANIZATION: " << __LINE__  << std::endl; 
     // Send Ready msg to all up nodes in this group
     freedm::broker::CMessage m_ = Ready();
-    Logger::Info <<"SEND: Sending out Ready from"<<std::endl;
+    LOG_INFO <<"SEND: Sending out Ready from"<<std::endl;
     foreach( PeerNodePtr peer_, m_UpNodes | boost::adaptors::map_values)
     {
       if( peer_->GetUUID() == GetUUID())
@@ -764,14 +764,14 @@ void GMAgent::Reorganize( const boost::system::error_code& err )
 
     // sufficiently_long_Timeout; maybe Reorganize if something blows up
     SetStatus(GMPeerNode::NORMAL);
-    Logger::Notice << "+ State change: NORMAL: " << __LINE__ << std::endl;
+    LOG_NOTICE << "+ State change: NORMAL: " << __LINE__ << std::endl;
     m_groupsformed++;
 
     // Send new membership list to group members 
     PushPeerList();
 
     // Back to work
-    Logger::Info << "TIMER: Setting CheckTimer (Check): " << __LINE__ << std::endl;
+    LOG_INFO << "TIMER: Setting CheckTimer (Check): " << __LINE__ << std::endl;
     m_timerMutex.lock();
     m_timer.expires_from_now( boost::posix_time::seconds(CHECK_TIMEOUT) );
     m_timer.async_wait( boost::bind(&GMAgent::Check, this, boost::asio::placeholders::error));
@@ -779,7 +779,7 @@ void GMAgent::Reorganize( const boost::system::error_code& err )
   }
   else
   {
-    Logger::Error << err << std::endl;
+    LOG_ERROR << err << std::endl;
     throw boost::system::system_error(err);
   }
 }
@@ -794,7 +794,7 @@ void GMAgent::Reorganize( const boost::system::error_code& err )
 ///////////////////////////////////////////////////////////////////////////////
 void GMAgent::Timeout( const boost::system::error_code& err )
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   PeerNodePtr peer_;
   if( !err )
   {
@@ -803,25 +803,25 @@ void GMAgent::Timeout( const boost::system::error_code& err )
     if(!IsCoordinator())
     {
       std::string line_ = Coordinator();
-      Logger::Info << "SEND: Sending AreYouThere messages." << std::endl;
+      LOG_INFO << "SEND: Sending AreYouThere messages." << std::endl;
       freedm::broker::CMessage m_ = AreYouThere();
       peer_ = GetPeer(line_);
       if(peer_ != NULL)
       {
-        Logger::Debug << "Peer already exists. Do Nothing " <<std::endl;
+        LOG_DEBUG << "Peer already exists. Do Nothing " <<std::endl;
       }
       else
       {
-        Logger::Debug << "Peer doesn't exist." <<std::endl;
+        LOG_DEBUG << "Peer doesn't exist." <<std::endl;
         peer_ = AddPeer(line_);
       } 
       if( false != peer_ && peer_->GetUUID() != GetUUID())
       {
         peer_->AsyncSend(m_);
-        Logger::Info << "Expecting response from "<<peer_->GetUUID()<<std::endl;
+        LOG_INFO << "Expecting response from "<<peer_->GetUUID()<<std::endl;
         InsertInPeerSet(m_AYTResponse,peer_);
       }
-      Logger::Info << "TIMER: Setting TimeoutTimer (Recovery):" << __LINE__ << std::endl;
+      LOG_INFO << "TIMER: Setting TimeoutTimer (Recovery):" << __LINE__ << std::endl;
       m_timerMutex.lock();
       m_timer.expires_from_now( boost::posix_time::seconds(TIMEOUT_TIMEOUT));
       m_timer.async_wait(boost::bind(&GMAgent::Recovery, this,
@@ -836,7 +836,7 @@ void GMAgent::Timeout( const boost::system::error_code& err )
   else
   {
     /* An error occurred */
-    Logger::Error << err << std::endl;
+    LOG_ERROR << err << std::endl;
     throw boost::system::system_error(err);
   }
 }
@@ -851,7 +851,7 @@ void GMAgent::HandleRead(const ptree& pt)
 
 void GMAgent::ParseMessage(ptree pt)
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
   PeerSet tempSet_;
   std::string coord_;
@@ -867,11 +867,11 @@ void GMAgent::ParseMessage(ptree pt)
     peer_ = GetPeer(line_);
     if(peer_ != NULL)
     {
-      Logger::Debug << "Peer already exists. Do Nothing " <<std::endl;
+      LOG_DEBUG << "Peer already exists. Do Nothing " <<std::endl;
     }
     else
     {
-      Logger::Debug << "Peer doesn't exist. Add it up to PeerSet" <<std::endl;
+      LOG_DEBUG << "Peer doesn't exist. Add it up to PeerSet" <<std::endl;
       peer_ = AddPeer(line_);
     }
   }
@@ -879,7 +879,7 @@ void GMAgent::ParseMessage(ptree pt)
   if(pt.get<std::string>("gm") == "Accept")
   {
     unsigned int msg_group = pt.get<unsigned int>("gm.groupid");
-    Logger::Info << "RECV: Accept Message from " << msg_source << std::endl;
+    LOG_INFO << "RECV: Accept Message from " << msg_source << std::endl;
     if(GetStatus() == GMPeerNode::ELECTION && msg_group == m_GroupID && IsCoordinator())
     {
       // We are holding an election, the remote peer wants to join
@@ -890,35 +890,35 @@ void GMAgent::ParseMessage(ptree pt)
     }
     else
     {
-      Logger::Warn << "Unexpected Accept message" << std::endl;
+      LOG_WARN << "Unexpected Accept message" << std::endl;
     }
   }
   else if(pt.get<std::string>("gm") == "AreYouCoordinator")
   {
-    Logger::Info << "RECV: AreYouCoordinator message from "<< msg_source << std::endl;
+    LOG_INFO << "RECV: AreYouCoordinator message from "<< msg_source << std::endl;
     if(GetStatus() == GMPeerNode::NORMAL && IsCoordinator())
     {
       // We are the group Coordinator AND we are at normal operation
-      Logger::Info << "SEND: AYC Response (YES) to "<<msg_source<<std::endl;
+      LOG_INFO << "SEND: AYC Response (YES) to "<<msg_source<<std::endl;
       freedm::broker::CMessage m_ = Response("yes","AreYouCoordinator");
       peer_->AsyncSend(m_);
     }
     else
     {
       // We are not the Coordinator OR we are not at normal operation
-      Logger::Info << "SEND: AYC Response (NO) to "<<msg_source<<std::endl;
+      LOG_INFO << "SEND: AYC Response (NO) to "<<msg_source<<std::endl;
       freedm::broker::CMessage m_ = Response("no","AreYouCoordinator");
       peer_->AsyncSend(m_);
     }
   }
   else if(pt.get<std::string>("gm") == "AreYouThere")
   {
-    Logger::Info << "RECV: AreYouThere message from " << msg_source << std::endl;
+    LOG_INFO << "RECV: AreYouThere message from " << msg_source << std::endl;
     unsigned int msg_group = pt.get<unsigned int>("gm.groupid");
     bool ingroup = CountInPeerSet(m_UpNodes,peer_);
     if(IsCoordinator() && msg_group == m_GroupID && ingroup)
     {
-      Logger::Info << "SEND: AYT Response (YES) to "<<msg_source<<std::endl;
+      LOG_INFO << "SEND: AYT Response (YES) to "<<msg_source<<std::endl;
       // We are Coordinator, peer is in our group, and peer is up
       // SCJ: I Don't think thats what the conditional Checks tho.
       freedm::broker::CMessage m_ = Response("yes","AreYouThere");
@@ -926,7 +926,7 @@ void GMAgent::ParseMessage(ptree pt)
     }
     else
     {
-      Logger::Info << "SEND: AYT Response (NO) to "<<msg_source<<std::endl;
+      LOG_INFO << "SEND: AYT Response (NO) to "<<msg_source<<std::endl;
       // We are not Coordinator OR peer is not in our groups OR peer is down
       freedm::broker::CMessage m_ = Response("no","AreYouThere");
       peer_->AsyncSend(m_);
@@ -934,20 +934,20 @@ void GMAgent::ParseMessage(ptree pt)
   }
   else if(pt.get<std::string>("gm") == "Invite")
   {
-    Logger::Info << "RECV: Invite message from " <<msg_source << std::endl;
+    LOG_INFO << "RECV: Invite message from " <<msg_source << std::endl;
     if(GetStatus() == GMPeerNode::NORMAL)
     {
       // STOP ALL JOBS.
       coord_ = Coordinator();
       tempSet_ = m_UpNodes;
       SetStatus(GMPeerNode::ELECTION);
-      Logger::Notice << "+ State Change ELECTION : "<<__LINE__<<std::endl;
+      LOG_NOTICE << "+ State Change ELECTION : "<<__LINE__<<std::endl;
       m_GroupID = pt.get<unsigned int>("gm.groupid");
       m_GroupLeader = pt.get<std::string>("gm.groupleader");
-      Logger::Notice << "Changed group: " << m_GroupID << " (" << m_GroupLeader << ") " << std::endl;
+      LOG_NOTICE << "Changed group: " << m_GroupID << " (" << m_GroupLeader << ") " << std::endl;
       if(coord_ == GetUUID())
       {
-        Logger::Info << "SEND: Sending invitations to former group members" << std::endl;
+        LOG_INFO << "SEND: Sending invitations to former group members" << std::endl;
         // Forward invitation to all members of my group
         freedm::broker::CMessage m_ = Invitation();
         foreach(PeerNodePtr peer_, tempSet_ | boost::adaptors::map_values)
@@ -958,14 +958,14 @@ void GMAgent::ParseMessage(ptree pt)
         }
       }
       freedm::broker::CMessage m_ = Accept();
-      Logger::Info << "SEND: Invitation accept to "<<msg_source<< std::endl;
+      LOG_INFO << "SEND: Invitation accept to "<<msg_source<< std::endl;
       //Send Accept
       //If this is a forwarded invite, the source may not be where I want
       //send my accept to. Instead, we will generate it based on the groupleader
       GetPeer(m_GroupLeader)->AsyncSend(m_);
       SetStatus(GMPeerNode::REORGANIZATION);
-      Logger::Notice << "+ State Change REORGANIZATION : "<<__LINE__<<std::endl;
-      Logger::Info << "TIMER: Setting TimeoutTimer (Recovery) : " << __LINE__ << std::endl;
+      LOG_NOTICE << "+ State Change REORGANIZATION : "<<__LINE__<<std::endl;
+      LOG_INFO << "TIMER: Setting TimeoutTimer (Recovery) : " << __LINE__ << std::endl;
       m_timerMutex.lock();
       m_timer.expires_from_now(boost::posix_time::seconds(TIMEOUT_TIMEOUT));
       m_timer.async_wait(boost::bind(&GMAgent::Recovery, 
@@ -980,14 +980,14 @@ void GMAgent::ParseMessage(ptree pt)
   }
   else if(pt.get<std::string>("gm") == "Ready")
   {
-    Logger::Info << "RECV: Ready message from " <<msg_source << std::endl;
+    LOG_INFO << "RECV: Ready message from " <<msg_source << std::endl;
     if(msg_source == m_GroupLeader && GetStatus() == GMPeerNode::REORGANIZATION)
     {
       SetStatus(GMPeerNode::NORMAL);
-      Logger::Notice << "+ State change: NORMAL: " << __LINE__ << std::endl;
+      LOG_NOTICE << "+ State change: NORMAL: " << __LINE__ << std::endl;
       m_groupsjoined++;
       // We are no longer the Coordinator, we must run Timeout()
-      Logger::Info << "TIMER: Canceling TimeoutTimer : " << __LINE__ << std::endl;
+      LOG_INFO << "TIMER: Canceling TimeoutTimer : " << __LINE__ << std::endl;
       m_timerMutex.lock();
       // We used to set a timeout timer here but cancelling the timer should accomplish the same thing.
       m_timer.expires_from_now(boost::posix_time::seconds(TIMEOUT_TIMEOUT));
@@ -997,7 +997,7 @@ void GMAgent::ParseMessage(ptree pt)
     }
     else
     {
-      Logger::Warn << "Unexpected ready message from "<<msg_source<<std::endl;
+      LOG_WARN << "Unexpected ready message from "<<msg_source<<std::endl;
     }
   }
   else if(pt.get<std::string>("gm") == "Response")
@@ -1005,8 +1005,8 @@ void GMAgent::ParseMessage(ptree pt)
     std::string answer = pt.get<std::string>("gm.payload");
     if(pt.get<std::string>("gm.type") == "AreYouCoordinator")
     {
-      Logger::Info << "RECV: Response (AYC) ("<<answer<<") from " <<msg_source << std::endl;
-      Logger::Debug << "Checking expected responses." << std::endl;
+      LOG_INFO << "RECV: Response (AYC) ("<<answer<<") from " <<msg_source << std::endl;
+      LOG_DEBUG << "Checking expected responses." << std::endl;
       bool expected = CountInPeerSet(m_AYCResponse,peer_);
       EraseInPeerSet(m_AYCResponse,peer_);
       if(expected == true && pt.get<std::string>("gm.payload") == "yes")
@@ -1014,7 +1014,7 @@ void GMAgent::ParseMessage(ptree pt)
         InsertInPeerSet(m_Coordinators,peer_);
         if(m_AYCResponse.size() == 0)
         {
-          Logger::Info << "TIMER: Canceling GlobalTimer : " << __LINE__ << std::endl;
+          LOG_INFO << "TIMER: Canceling GlobalTimer : " << __LINE__ << std::endl;
           m_timerMutex.lock();
           //Before, we just cleared this timer. Now I'm going to set it to start another check cycle
           m_timer.expires_from_now(boost::posix_time::seconds(TIMEOUT_TIMEOUT));
@@ -1029,19 +1029,19 @@ void GMAgent::ParseMessage(ptree pt)
       }
       else
       {
-        Logger::Warn<< "Unsolicited AreYouCoordinator response from "<<msg_source<< std::endl;
+        LOG_WARN<< "Unsolicited AreYouCoordinator response from "<<msg_source<< std::endl;
       }
     }
     else if(pt.get<std::string>("gm.type") == "AreYouThere")
     {
-      Logger::Info << "RECV: Response (AYT) ("<<answer<<") from " <<msg_source << std::endl;
-      Logger::Debug << "Checking expected responses." << std::endl;
+      LOG_INFO << "RECV: Response (AYT) ("<<answer<<") from " <<msg_source << std::endl;
+      LOG_DEBUG << "Checking expected responses." << std::endl;
       bool expected = CountInPeerSet(m_AYTResponse,peer_);
       EraseInPeerSet(m_AYTResponse,peer_);
       if(expected == true && pt.get<std::string>("gm.payload") == "yes")
       {
         m_timerMutex.lock();
-        Logger::Info << "TIMER: Setting TimeoutTimer (Timeout): " << __LINE__ << std::endl;
+        LOG_INFO << "TIMER: Setting TimeoutTimer (Timeout): " << __LINE__ << std::endl;
         m_timer.expires_from_now(boost::posix_time::seconds(TIMEOUT_TIMEOUT));
         m_timer.async_wait(boost::bind(&GMAgent::Timeout, this,
                                     boost::asio::placeholders::error));
@@ -1055,22 +1055,22 @@ void GMAgent::ParseMessage(ptree pt)
       }
       else
       {
-        Logger::Warn<< "Unsolicited AreYouThere response from "<<msg_source<<std::endl;
+        LOG_WARN<< "Unsolicited AreYouThere response from "<<msg_source<<std::endl;
       }
     }
     else
     {
-      Logger::Warn << "Invalid Response Type:" << pt.get<std::string>("gm.type") << std::endl;
+      LOG_WARN << "Invalid Response Type:" << pt.get<std::string>("gm.type") << std::endl;
     }
   }
   else
   {
-    Logger::Warn << "Invalid Message Type" << pt.get<std::string>("gm") << std::endl;
+    LOG_WARN << "Invalid Message Type" << pt.get<std::string>("gm") << std::endl;
   }
 }
 GMAgent::PeerNodePtr GMAgent::AddPeer(std::string uuid)
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   PeerNodePtr tmp_;
   tmp_.reset(new GMPeerNode(uuid,GetConnectionManager(),GetIOService(),GetDispatcher()));
   InsertInPeerSet(m_AllPeers,tmp_);
@@ -1110,7 +1110,7 @@ GMAgent::PeerNodePtr GMAgent::GetPeer(std::string uuid)
 /////////////////////////////////////////////////////////
 int GMAgent::Run()
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
   std::map<std::string, std::string>::iterator mapIt_;
 
@@ -1122,7 +1122,7 @@ int GMAgent::Run()
 
   foreach( PeerNodePtr p_,  m_AllPeers | boost::adaptors::map_values)
   {
-      Logger::Notice << "! " <<p_->GetUUID() << " added to peer set" <<std::endl;
+      LOG_NOTICE << "! " <<p_->GetUUID() << " added to peer set" <<std::endl;
   }
   Recovery();
   //m_localservice.post(boost::bind(&GMAgent::Recovery,this));
@@ -93,7 +93,7 @@ lbAgent::lbAgent(std::string uuid_, boost::asio::io_service &ios,
   m_phyDevManager(m_phyManager),
   m_GlobalTimer(ios)
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   PeerNodePtr self_(this);
   InsertInPeerSet(l_AllPeers, self_);
   demandDuration = 0; //count how many times in a row has been in DEMAND state 
@@ -126,12 +126,23 @@ lbAgent::~lbAgent()
 /////////////////////////////////////////////////////////
 void lbAgent::LoadManage()
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   MessagePtr m_;
+
+  // Wait for a new simulation step before the devices are read, and skip
+  // the cycle if the simulation has not advanced
+  if( !m_phyDevManager.BeginStep() )
+  {
+    m_GlobalTimer.expires_from_now( boost::posix_time::seconds(LOAD_TIMEOUT) );
+    m_GlobalTimer.async_wait( boost::bind(&lbAgent::LoadManage, this,
+                                          boost::asio::placeholders::error));
+    return;
+  }
+
   preLoad = l_Status; // Remember previous load before computing current load
 
   // Physical device information managed by Broker can be obtained as below
-  Logger::Info << "LB module identified "<< m_phyDevManager.DeviceCount()
+  LOG_INFO << "LB module identified "<< m_phyDevManager.DeviceCount()
                << " physical devices on this node" << std::endl;
   freedm::broker::IPhysicalDevice::DevicePtr DevPtr;
   freedm::broker::CPhysicalDeviceManager::PhysicalDeviceSet::iterator it_;
@@ -139,7 +150,7 @@ void lbAgent::LoadManage()
   {
     DevPtr = it_->second;
     DevPtr = m_phyDevManager.GetDevice(it_->first); 
-    Logger::Debug<< "Device ID: " << DevPtr->GetID() << ", Device Type: " 
+    LOG_DEBUG<< "Device ID: " << DevPtr->GetID() << ", Device Type: " 
     		 << DevPtr->GetType()<< ", power level: " << DevPtr->get_powerLevel() << std::endl;                         
   }  
   
@@ -171,7 +182,7 @@ void lbAgent::LoadManage()
       
       
     //Send Demand message to all nodes
-      Logger::Notice <<"Broadcasting Load change: NORM -> DEMAND " <<std::endl;
+      LOG_NOTICE <<"Broadcasting Load change: NORM -> DEMAND " <<std::endl;
       foreach( PeerNodePtr peer_, l_AllPeers | boost::adaptors::map_values)
 	{
 	  if( peer_->GetUUID() == GetUUID())      
@@ -184,7 +195,7 @@ void lbAgent::LoadManage()
 		}
 	      catch (boost::system::system_error& e)
 		{
-		  Logger::Info << "Couldn't Send Message To Peer" << std::endl;
+		  LOG_INFO << "Couldn't Send Message To Peer" << std::endl;
 		}
 	    }
 	}//end foreach
@@ -204,7 +215,7 @@ void lbAgent::LoadManage()
     m_.m_submessages.put("lb", ss_.str());
 
     //Send Normal message to all nodes 
-    Logger::Notice <<"Broadcasting Load change: DEMAND -> NORM " <<std::endl;   
+    LOG_NOTICE <<"Broadcasting Load change: DEMAND -> NORM " <<std::endl;   
     foreach( PeerNodePtr peer_, l_AllPeers | boost::adaptors::map_values)
     {
       if( peer_->GetUUID() == GetUUID())
@@ -218,7 +229,7 @@ void lbAgent::LoadManage()
        
         catch (boost::system::system_error& e)
         {
-          Logger::Info << "Couldn't Send Message To Peer" << std::endl;
+          LOG_INFO << "Couldn't Send Message To Peer" << std::endl;
         }
       }
      }
@@ -237,6 +248,9 @@ void lbAgent::LoadManage()
     demandDuration = 0; //reset demandDuration
   }
 
+  // The device commands of this step have been issued
+  m_phyDevManager.FinishStep();
+
   //Start the timer; on timeout, this function is called again 
   m_GlobalTimer.expires_from_now( boost::posix_time::seconds(LOAD_TIMEOUT) );
   m_GlobalTimer.async_wait( boost::bind(&lbAgent::LoadManage, this,
@@ -254,7 +268,7 @@ void lbAgent::LoadManage()
 /////////////////////////////////////////////////////////
 void lbAgent::LoadManage( const boost::system::error_code& err )
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   
   if(!err)
     {
@@ -262,13 +276,13 @@ void lbAgent::LoadManage( const boost::system::error_code& err )
     }
   else if(boost::asio::error::operation_aborted == err )
     {
-      Logger::Info << "LoadManage(operation_aborted error) " <<
+      LOG_INFO << "LoadManage(operation_aborted error) " <<
 	__LINE__ << std::endl;
     }
   else
     {
       /* An error occurred or timer was canceled */
-      Logger::Error << err << std::endl;
+      LOG_ERROR << err << std::endl;
       throw boost::system::system_error(err);
     }
 }
@@ -287,7 +301,7 @@ void lbAgent::LoadManage( const boost::system::error_code& err )
 
 void lbAgent::SendDraftRequest(){
 
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;  
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;  
   if(LPeerNode::SUPPLY == l_Status)
     {
         //Create new request and send it to all nodes   
@@ -300,7 +314,7 @@ void lbAgent::SendDraftRequest(){
       	ss_.clear();
       	ss_.str("request");
       	m_.m_submessages.put("lb", ss_.str());
-        Logger::Notice << "\nSending DraftRequest from: " << 
+        LOG_NOTICE << "\nSending DraftRequest from: " << 
         	m_.m_submessages.get<std::string>("lb.source") <<std::endl;
         foreach( PeerNodePtr peer_, l_AllPeers | boost::adaptors::map_values)
     	{
@@ -314,7 +328,7 @@ void lbAgent::SendDraftRequest(){
             }
          catch (boost::system::system_error& e)
            {
-            Logger::Info << "Couldn't Send Message To Peer" << std::endl;
+            LOG_INFO << "Couldn't Send Message To Peer" << std::endl;
            }
          }
         }//end foreach
@@ -383,41 +397,24 @@ void lbAgent::LoadTable(){
   int DESD_count = 0;
   int LOAD_count = 0;
 
-freedm::broker::IPhysicalDevice::DevicePtr DevPtr;
-freedm::broker::CPhysicalDeviceManager::PhysicalDeviceSet::iterator it_;
-for( it_ = m_phyDevManager.begin(); it_ != m_phyDevManager.end(); ++it_ )
-    {
-      //Compute Net Generation
-      if ((m_phyDevManager.DeviceExists(it_->first)) && 
-         (it_->second->GetType() == freedm::broker::physicaldevices::DRER))
-	  {       	
-	  net_gen += it_->second->get_powerLevel();   
-	 DRER_count++;          
-      }  
-      //Compute Net Storage
-      if ((m_phyDevManager.DeviceExists(it_->first)) && 
-	 (it_->second->GetType() == freedm::broker::physicaldevices::DESD))
-      {        
-          net_storage += it_->second->get_powerLevel();     
-          DESD_count++;      
-      } 
-      //Compute Net Load
-      if ((m_phyDevManager.DeviceExists(it_->first)) && 
-	 (it_->second->GetType() == freedm::broker::physicaldevices::LOAD))
-      {       	
-          net_load += it_->second->get_powerLevel();   
-          LOAD_count++;        
-      }  
-
-      //Compute net diesel generation
-      if ((m_phyDevManager.DeviceExists(it_->first)) && 
-	 (it_->second->GetType() == freedm::broker::physicaldevices::DG))
-      {       	
-          net_dg += it_->second->get_powerLevel();   
-          LOAD_count++;        
-      }  
+  // Read every device once, then sum the cached readings for each type
+  m_phyDevManager.RefreshPowerLevels();
 
-    }
+  //Compute Net Generation
+  net_gen = m_phyDevManager.GetNetPowerLevel(freedm::broker::physicaldevices::DRER);
+  DRER_count = m_phyDevManager.DeviceCount(freedm::broker::physicaldevices::DRER);
+
+  //Compute Net Storage
+  net_storage = m_phyDevManager.GetNetPowerLevel(freedm::broker::physicaldevices::DESD);
+  DESD_count = m_phyDevManager.DeviceCount(freedm::broker::physicaldevices::DESD);
+
+  //Compute Net Load
+  net_load = m_phyDevManager.GetNetPowerLevel(freedm::broker::physicaldevices::LOAD);
+  LOAD_count = m_phyDevManager.DeviceCount(freedm::broker::physicaldevices::LOAD);
+
+  //Compute net diesel generation
+  net_dg = m_phyDevManager.GetNetPowerLevel(freedm::broker::physicaldevices::DG);
+  LOAD_count += m_phyDevManager.DeviceCount(freedm::broker::physicaldevices::DG);
 
 
 //unit set to kw
@@ -550,30 +547,30 @@ for( it_ = m_phyDevManager.begin(); it_ != m_phyDevManager.end(); ++it_ )
 /////////////////////////////////////////////////////////
 void lbAgent::HandleRead(const ptree& pt )
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   PeerSet tempSet_;
   MessagePtr m_;
   std::string line_;
   std::stringstream ss_;
   PeerNodePtr peer_;   
   line_ = pt.get<std::string>("lb.source");
-  Logger::Debug << "Message '" <<pt.get<std::string>("lb")<<"' received from "<< line_<<std::endl;
+  LOG_DEBUG << "Message '" <<pt.get<std::string>("lb")<<"' received from "<< line_<<std::endl;
 
    // Evaluate the identity of the message source
    if(line_ != GetUUID())
    {
-      Logger::Debug << "Flag " <<std::endl;
+      LOG_DEBUG << "Flag " <<std::endl;
       // Update the peer entry, if needed
       peer_ = get_peer(line_); 
 
        if( peer_ != NULL)
        {
-         Logger::Debug << "Peer already exists. Do Nothing " <<std::endl;
+         LOG_DEBUG << "Peer already exists. Do Nothing " <<std::endl;
        }
        else
        {
          // Add the peer, if an entry wasn`t found
-	 Logger::Debug << "Peer doesn`t exist. Add it up to LBPeerSet" <<std::endl;
+	 LOG_DEBUG << "Peer doesn`t exist. Add it up to LBPeerSet" <<std::endl;
 	 add_peer(line_);
          peer_ = get_peer(line_);
        }
@@ -585,7 +582,7 @@ void lbAgent::HandleRead(const ptree& pt )
    {
       std::string peers_, token;
       peers_ = pt.get<std::string>("lb.peers");
-      Logger::Notice << "\nPeer List < " << peers_ <<
+      LOG_NOTICE << "\nPeer List < " << peers_ <<
 	           " > received from Group Leader: " << line_ <<std::endl;
 
       //Update the PeerNode lists accordingly         
@@ -621,11 +618,11 @@ void lbAgent::HandleRead(const ptree& pt )
       	peer_ = get_peer(token); 
         if( false != peer_ )
 	{
-	  Logger::Debug << "LB knows this peer " <<std::endl;
+	  LOG_DEBUG << "LB knows this peer " <<std::endl;
 	}
         else
 	{
-          Logger::Debug << "LB sees a new member "<< token  
+          LOG_DEBUG << "LB sees a new member "<< token  
                         << " in the group " <<std::endl;
           add_peer(token);
 	}
@@ -635,7 +632,7 @@ void lbAgent::HandleRead(const ptree& pt )
   // You received a draft request    
   else if(pt.get<std::string>("lb") == "request"  && peer_->GetUUID() != GetUUID())
   {
-    Logger::Notice << "\nRequest message received from: " << peer_->GetUUID() << std::endl;               
+    LOG_NOTICE << "\nRequest message received from: " << peer_->GetUUID() << std::endl;               
     // Just not to duplicate the peer, erase the existing entries of it               
 
     EraseInPeerSet(m_LoNodes,peer_);
@@ -679,7 +676,7 @@ void lbAgent::HandleRead(const ptree& pt )
       }
       catch (boost::system::system_error& e)
       {
-   	Logger::Info << "Couldn't Send Message To Peer" << std::endl;
+   	LOG_INFO << "Couldn't Send Message To Peer" << std::endl;
       }
     }
   }//end if("request")
@@ -687,7 +684,7 @@ void lbAgent::HandleRead(const ptree& pt )
   // You received a Demand message from the source. Update list and do nothing. 
   else if(pt.get<std::string>("lb") == "demand"  && peer_->GetUUID() != GetUUID())
   {
-    Logger::Notice << "\nDemand message received from: " 
+    LOG_NOTICE << "\nDemand message received from: " 
                    << pt.get<std::string>("lb.source") <<std::endl;
     EraseInPeerSet(m_HiNodes,peer_);
     EraseInPeerSet(m_NoNodes,peer_);
@@ -699,7 +696,7 @@ void lbAgent::HandleRead(const ptree& pt )
   // You received a Load change of source to Normal state
   else if(pt.get<std::string>("lb") == "normal"  && peer_->GetUUID() != GetUUID())
   {
-    Logger::Notice << "\nNormal message received from: " 
+    LOG_NOTICE << "\nNormal message received from: " 
                    << pt.get<std::string>("lb.source") <<std::endl;
     EraseInPeerSet(m_NoNodes,peer_);
     EraseInPeerSet(m_HiNodes,peer_);
@@ -714,7 +711,7 @@ void lbAgent::HandleRead(const ptree& pt )
     // The response is a 'yes' 
     if(pt.get<std::string>("lb") == "yes")
     {
-      Logger::Notice << "(Yes) from " << peer_->GetUUID() << std::endl;
+      LOG_NOTICE << "(Yes) from " << peer_->GetUUID() << std::endl;
       //Initiate drafting with a message accordingly
       freedm::broker::CMessage m_;
       std::stringstream ss_;   
@@ -733,7 +730,7 @@ void lbAgent::HandleRead(const ptree& pt )
         }
         catch (boost::system::system_error& e)
         {
-          Logger::Info << "Couldn't send Message To Peer" << std::endl;
+          LOG_INFO << "Couldn't send Message To Peer" << std::endl;
         }
        }
     }//endif
@@ -741,7 +738,7 @@ void lbAgent::HandleRead(const ptree& pt )
     // The response is a 'No'; do nothing  
     else
     {
-      Logger::Notice << "(No) from " << peer_->GetUUID() << std::endl;
+      LOG_NOTICE << "(No) from " << peer_->GetUUID() << std::endl;
     }
   }//end if("yes/no from the demand node")
 
@@ -749,7 +746,7 @@ void lbAgent::HandleRead(const ptree& pt )
  //Ackowledge by sending an 'Accept' message
  else if(pt.get<std::string>("lb") == "drafting" && peer_->GetUUID() != GetUUID())
  {
-   Logger::Notice << "\nDrafting message received from: " << peer_->GetUUID() << std::endl;   
+   LOG_NOTICE << "\nDrafting message received from: " << peer_->GetUUID() << std::endl;   
    if( LPeerNode::DEMAND == l_Status )
    {
      freedm::broker::CMessage m_;
@@ -772,7 +769,7 @@ void lbAgent::HandleRead(const ptree& pt )
        }
        catch (boost::system::system_error& e)
        {
-  	 Logger::Info << "Couldn't Send Message To Peer" << std::endl;
+  	 LOG_INFO << "Couldn't Send Message To Peer" << std::endl;
        }
        //Then connect to the main grid to get power
        InitiatePowerMigration(1);
@@ -793,18 +790,18 @@ void lbAgent::HandleRead(const ptree& pt )
    std::stringstream ss_;
    ss_ << pt.get<std::string>("lb.value");
    ss_ >> DemValue;
-   Logger::Notice << " Draft Accept message received from: "
+   LOG_NOTICE << " Draft Accept message received from: "
 		  << peer_->GetUUID()<< "with demand of "<<DemValue << std::endl;	     
    if( LPeerNode::SUPPLY == l_Status )
    {
    // Make necessary power setting accordingly to allow power migration
-      Logger::Notice<<"\nMigrating power on request from: "<< peer_->GetUUID() << std::endl;
+      LOG_NOTICE<<"\nMigrating power on request from: "<< peer_->GetUUID() << std::endl;
       InitiatePowerMigration(DemValue);            
    }
      
    else
    {
-     Logger::Warn << "Unexpected Accept message" << std::endl;
+     LOG_WARN << "Unexpected Accept message" << std::endl;
    }
  }//end if("accept")
 
@@ -813,7 +810,7 @@ void lbAgent::HandleRead(const ptree& pt )
  else if(pt.get<std::string>("lb") == "load")
  {
    peer_ = get_peer(line_);
-   Logger::Notice << "\nCurrent Load State requested by " << peer_->GetUUID() << std::endl;    
+   LOG_NOTICE << "\nCurrent Load State requested by " << peer_->GetUUID() << std::endl;    
      
    freedm::broker::CMessage m_;
    std::stringstream ss_;   
@@ -845,14 +842,14 @@ void lbAgent::HandleRead(const ptree& pt )
    }
    catch (boost::system::system_error& e)
    {
-     Logger::Info << "Couldn't send Message To Peer" << std::endl;
+     LOG_INFO << "Couldn't send Message To Peer" << std::endl;
    }
  }//end if("load")
 
  // Other message type is invalid within lb module
  else
  {
-   Logger::Warn << "Invalid Message Type" << std::endl;
+   LOG_WARN << "Invalid Message Type" << std::endl;
  }
  	
 }//end function
@@ -873,7 +870,7 @@ lbAgent::PeerNodePtr lbAgent::get_peer(std::string uuid)
 
 lbAgent::PeerNodePtr lbAgent::add_peer(std::string uuid)
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   PeerNodePtr tmp_;
   tmp_.reset(new LPeerNode(uuid,GetConnectionManager(),GetIOService(),GetDispatcher()));
   InsertInPeerSet(l_AllPeers,tmp_);
@@ -889,7 +886,7 @@ lbAgent::PeerNodePtr lbAgent::add_peer(std::string uuid)
 /////////////////////////////////////////////////////////
 int lbAgent::LB()
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
    
   // This initializes the algorithm
   LoadManage();
@@ -104,7 +104,7 @@ PDAgent::PDAgent(std::string p_uuid, boost::asio::io_service &p_ios,
     GMPeerNode(p_uuid,p_conManager,p_ios,p_dispatch),
     m_CheckTimer(p_ios)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     PeerNodePtr self_(this);
     AddPeer(self_);
 }
@@ -180,7 +180,7 @@ freedm::broker::CMessage PDAgent::RequestSlice()
 ///////////////////////////////////////////////////////////////////////////////
 void PDAgent::PushHosts( const boost::system::error_code& err )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     PeerNodePtr self_(this);
     //On initialization, the all peers list is empty. The first step then, is
     //to see if we need to add ourselves to the peer list:
@@ -213,7 +213,7 @@ void PDAgent::PushHosts( const boost::system::error_code& err )
 
 void PDAgent::AskWhoAreYou( const boost::system::error_code& err )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     freedm::broker::CMessage m = WhoAreYou();
     //First, make sure we know about as many people as possible!
     PullPeers();
@@ -257,7 +257,7 @@ void PDAgent::GetHosts( const boost::system::error_code& err )
 
 void PDAgent::HandleRead(const ptree& pt )
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
     MessagePtr m_;
     std::string line_;
@@ -271,11 +271,11 @@ void PDAgent::HandleRead(const ptree& pt )
         peer_ = GetPeer(line_);
         if(peer_ != NULL)
         {
-            Logger::Debug << "Peer already exists. Do Nothing " <<std::endl;
+            LOG_DEBUG << "Peer already exists. Do Nothing " <<std::endl;
         }
         else
         {
-            Logger::Debug << "Peer doesn't exist. Add it up to PeerSet" <<std::endl;
+            LOG_DEBUG << "Peer doesn't exist. Add it up to PeerSet" <<std::endl;
             //Add peer makes it go into both all and new. new gets cleared
             //during the PushHosts stage.
             peer_ = AddPeer(line_);
@@ -286,7 +286,7 @@ void PDAgent::HandleRead(const ptree& pt )
     {
         std::string uuid = pt.get<unsigned int>("pd.uuid");
         std::string hostname = pt.get<unsigned int>("pd.hostname");
-        Logger::Info << "RECV: NewPeer Message from " << msg_source << std::endl;
+        LOG_INFO << "RECV: NewPeer Message from " << msg_source << std::endl;
         if(hostname != "")
             GetConnectionManager.PutHostname(uuid,hostname); 
     }
@@ -309,13 +309,13 @@ void PDAgent::HandleRead(const ptree& pt )
     }
     else
     {
-        Logger::Warn << "Invalid Message Type" << pt.get<std::string>("gm") << std::endl;
+        LOG_WARN << "Invalid Message Type" << pt.get<std::string>("gm") << std::endl;
     }
 }
 
 PDAgent::PeerNodePtr PDAgent::AddPeer(std::string uuid)
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
     PeerNodePtr tmp_;
     tmp_.reset(new PDPeerNode(uuid,GetConnectionManager(),GetIOService(),GetDispatcher()));
     InsertInPeerSet(m_AllPeers,tmp_);
@@ -348,7 +348,7 @@ void PDAgent::PullPeers()
         std::string uuid = mapIt_->first;
         PeerNodePtr p_;
         p_ = AddPeer(uuid);
-        Logger::Notice << "! " <<p_->GetUUID() << " added to peer set" <<std::endl;
+        LOG_NOTICE << "! " <<p_->GetUUID() << " added to peer set" <<std::endl;
     }
 }
 ////////////////////////////////////////////////////////////
@@ -368,7 +368,7 @@ void PDAgent::PullPeers()
 /////////////////////////////////////////////////////////
 int PDAgent::Run()
 {
-    Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+    LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
     m_CheckTimer.expires_from_now( boost::posix_time::seconds(CHECK_TIMEOUT) );
     m_CheckTimer.async_wait( boost::bind(&PDAgent::AskWhoAreYou, this, boost::asio::placeholders::error));
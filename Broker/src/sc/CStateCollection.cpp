@@ -109,7 +109,7 @@ SCAgent::SCAgent(std::string uuid, boost::asio::io_service &ios,
   m_curversion("default", 0),
   countstate(0)
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   PeerNodePtr self_(this);
   AddPeer( self_ );
 }
@@ -166,27 +166,27 @@ freedm::broker::CMessage SCAgent::m_state()
 
 void SCAgent::Initiate()
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
   collectstate.clear();
   countstate = 0;
   m_curversion.first = GetUUID();
   m_curversion.second = 0;
 
-  Logger::Notice << " ------------ INITIAL, current peerList : -------------- "<<std::endl;
+  LOG_NOTICE << " ------------ INITIAL, current peerList : -------------- "<<std::endl;
 	foreach(PeerNodePtr peer_, m_AllPeers | boost::adaptors::map_values)
 	{
-		Logger::Notice << peer_->GetUUID() <<std::endl;
+		LOG_NOTICE << peer_->GetUUID() <<std::endl;
 	}	
-  Logger::Notice << " --------------------------------------------- "<<std::endl;
+  LOG_NOTICE << " --------------------------------------------- "<<std::endl;
 
   //collect local state (reach module such as LoadBalance to collect status)
   //send request to LoadBalance
-  Logger::Notice << "TakeSnapshot: send request to load balance module" <<std::endl;
+  LOG_NOTICE << "TakeSnapshot: send request to load balance module" <<std::endl;
   TakeSnapshot();
 
   //prepare marker tagged with UUID + Int
-  Logger::Notice << "maker is ready from " << GetUUID() << std::endl;
+  LOG_NOTICE << "maker is ready from " << GetUUID() << std::endl;
   freedm::broker::CMessage m_ = m_marker();
  	
   //send tagged marker to all other peers
@@ -194,7 +194,7 @@ void SCAgent::Initiate()
   {
 	if (peer_->GetUUID()!= GetUUID())
 	//continue;
-	{Logger::Notice << "Sending marker to " << peer_->GetUUID() << std::endl;
+	{LOG_NOTICE << "Sending marker to " << peer_->GetUUID() << std::endl;
 //	 send_to_uuid(peer_->uuid_, m_);
 	 peer_->AsyncSend(m_);
 	}
@@ -208,7 +208,7 @@ void SCAgent::Initiate()
 
 void SCAgent::Initiate( const boost::system::error_code& err )
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   
   if(!err)
     {
@@ -216,13 +216,13 @@ void SCAgent::Initiate( const boost::system::error_code& err )
     }
   else if(boost::asio::error::operation_aborted == err )
     {
-      Logger::Info << "Initiate(operation_aborted error) " <<
+      LOG_INFO << "Initiate(operation_aborted error) " <<
 	__LINE__ << std::endl;
     }
   else
     {
       /* An error occurred or timer was canceled */
-      Logger::Error << err << std::endl;
+      LOG_ERROR << err << std::endl;
       throw boost::system::system_error(err);
     }
 }
@@ -254,7 +254,7 @@ void SCAgent::TakeSnapshot()
 void SCAgent::StatePrint(std::map< int, ptree >& pt)
 {
 
-	Logger::Notice << "collectstate's size is " << (int) pt.size() << std::endl;
+	LOG_NOTICE << "collectstate's size is " << (int) pt.size() << std::endl;
 	std::cout << "--------------------collectstate-----------------" << std::endl;
 	for (it = pt.begin(); it != pt.end(); it++)
 	{
@@ -279,7 +279,7 @@ void SCAgent::StatePrint(std::map< int, ptree >& pt)
 
 void SCAgent::HandleRead(const ptree& pt )
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
   std::string line_;
   std::stringstream ss_;
@@ -294,11 +294,11 @@ void SCAgent::HandleRead(const ptree& pt )
     peer_ = GetPeer(line_);
     if(peer_ != NULL)
     {
-      Logger::Debug << "Peer already exists. Do Nothing " <<std::endl;
+      LOG_DEBUG << "Peer already exists. Do Nothing " <<std::endl;
     }
     else
     {
-      Logger::Debug << "PeerPeer doesn't exist. Add it up to PeerSet" <<std::endl;
+      LOG_DEBUG << "PeerPeer doesn't exist. Add it up to PeerSet" <<std::endl;
       AddPeer(line_);
       peer_ = GetPeer(line_);
     }//end if
@@ -311,7 +311,7 @@ void SCAgent::HandleRead(const ptree& pt )
   {
   	std::string peers_, token;
 	peers_ = pt.get<std::string>("sc.peers");
-        Logger::Notice << "Peer List: " << peers_ <<
+        LOG_NOTICE << "Peer List: " << peers_ <<
 	           " received from Group Leader: " << line_ <<std::endl;
           std::istringstream iss(peers_);
 
@@ -328,11 +328,11 @@ void SCAgent::HandleRead(const ptree& pt )
         	peer_ = GetPeer(token); 
 	        if( false != peer_ )
 	        {
-	        	Logger::Notice << "SC knows this peer " <<std::endl;
+	        	LOG_NOTICE << "SC knows this peer " <<std::endl;
 	        }
                 else
 	        {
-                	Logger::Notice << "SC sees a new member "<< token  
+                	LOG_NOTICE << "SC sees a new member "<< token  
                                << " in the group " <<std::endl;
                 	AddPeer(token);
 	        }//end if
@@ -344,7 +344,7 @@ void SCAgent::HandleRead(const ptree& pt )
   if (pt.get<std::string>("sc") == "load")
   {	
 	//receive load balance status
-  	Logger::Notice << "receive load balance status from " << pt.get<std::string>("sc.source") << " " << pt.get<std::string>("sc.status") << std::endl;
+  	LOG_NOTICE << "receive load balance status from " << pt.get<std::string>("sc.source") << " " << pt.get<std::string>("sc.status") << std::endl;
 
 	//prepare state message
 
@@ -360,7 +360,7 @@ void SCAgent::HandleRead(const ptree& pt )
 	    }
 	    else
 	    {
-        	Logger::Notice << "Error: couldn't send to " << m_curversion.first << std::endl;			
+        	LOG_NOTICE << "Error: couldn't send to " << m_curversion.first << std::endl;			
 	    }
 	}
 	else
@@ -381,7 +381,7 @@ void SCAgent::HandleRead(const ptree& pt )
   else if (pt.get<std::string>("sc") == "marker")
   {
 	// marker value is present, this initiates a collection request
-  	Logger::Notice << "Received message is a maker! " << std::endl;
+  	LOG_NOTICE << "Received message is a maker! " << std::endl;
 
 	// read the incoming version from marker
 	incomingVer_.first = pt.get<std::string>("sc.source");
@@ -389,7 +389,7 @@ void SCAgent::HandleRead(const ptree& pt )
 	// assign incoming version to current version, this trace the latest marker
 	m_curversion = incomingVer_;
 
- 	Logger::Notice << "marker is " << m_curversion.first << " " << m_curversion.second << std::endl;
+ 	LOG_NOTICE << "marker is " << m_curversion.first << " " << m_curversion.second << std::endl;
 
 	//collect local state (reach module such as LoadBalance to collect status)
 	TakeSnapshot();
@@ -400,7 +400,7 @@ void SCAgent::HandleRead(const ptree& pt )
   else if (pt.get<std::string>("sc") == "state")
   {
 	//message feedback
-	Logger::Notice << "receive status from peer " << pt.get<std::string>("sc.source") << std::endl;
+	LOG_NOTICE << "receive status from peer " << pt.get<std::string>("sc.source") << std::endl;
 	//message save
 	line_ = pt.get<std::string>("sc.lb.status");
 	m_curstate.put("sc.lb.status", line_);
@@ -428,7 +428,7 @@ void SCAgent::HandleRead(const ptree& pt )
   else //message in transit
   {	
 	//save message in transit 
-	Logger::Notice << "receive message in transit: " << pt.get<std::string>("sc") << " from" << pt.get<std::string>("sc.source") << std::endl;
+	LOG_NOTICE << "receive message in transit: " << pt.get<std::string>("sc") << " from" << pt.get<std::string>("sc.source") << std::endl;
 
 
     if (m_curversion.first == "default")
@@ -437,7 +437,7 @@ void SCAgent::HandleRead(const ptree& pt )
      }
     else
     {
-	Logger::Notice << "current version of marker is: " << m_curversion.first << std::endl;
+	LOG_NOTICE << "current version of marker is: " << m_curversion.first << std::endl;
 
 	if (m_curversion.first != GetUUID())
 	{
@@ -453,7 +453,7 @@ void SCAgent::HandleRead(const ptree& pt )
 	    }
 	    else
 	    {
-        	Logger::Notice << "Error: couldn't send back to " << m_curversion.first << std::endl;		
+        	LOG_NOTICE << "Error: couldn't send back to " << m_curversion.first << std::endl;		
 	    }
 	}	
 	else
@@ -506,7 +506,7 @@ void SCAgent::HandleRead(const ptree& pt )
 /////////////////////////////////////////////////////////
 SCAgent::PeerNodePtr SCAgent::AddPeer(std::string uuid)
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
   PeerNodePtr tmp_;
   tmp_.reset(new SCPeerNode(uuid,GetConnectionManager(),GetIOService(),GetDispatcher()));
   InsertInPeerSet(m_AllPeers,tmp_);
@@ -550,7 +550,7 @@ SCAgent::PeerNodePtr SCAgent::GetPeer(std::string uuid)
 /////////////////////////////////////////////////////////
 int SCAgent::SC()
 {
-  Logger::Debug << __PRETTY_FUNCTION__ << std::endl;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << std::endl;
 
  
   Initiate();
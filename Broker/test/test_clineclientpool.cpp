@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////////////
+/// @file      test_clineclientpool.cpp
+///
+/// @author    Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler  C++
+///
+/// @project   FREEDM DGI
+///
+/// @description Unit tests for the CLineClientPool class.
+///
+/// @sa CLineClientPool
+///
+/// @license
+/// These source code files were created at as part of the
+/// FREEDM DGI Subthrust, and are
+/// intended for use in teaching or research.  They may be
+/// freely copied, modified and redistributed as long
+/// as modified versions are clearly marked as such and
+/// this notice is not removed.
+///
+/// Neither the authors nor the FREEDM Project nor the
+/// National Science Foundation
+/// make any warranty, express or implied, nor assumes
+/// any legal responsibility for the accuracy,
+/// completeness or usefulness of these codes or any
+/// information distributed with these codes.
+///
+/// Suggested modifications or questions about these codes
+/// can be directed to Dr. Bruce McMillin, Department of
+/// Computer Science, Missour University of Science and
+/// Technology, Rolla, /// MO  65409 (ff@mst.edu).
+///
+////////////////////////////////////////////////////////////////////
+#include "CLineClientPool.hpp"
+
+#define BOOST_TEST_MAIN
+#include "unit_test.hpp"
+
+#include <istream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+using namespace freedm::broker;
+
+namespace {
+
+/// One client connection of the fake line server
+struct SConnection
+{
+    SConnection(boost::asio::io_service & p_service) : m_socket(p_service) {}
+
+    boost::asio::ip::tcp::socket m_socket;
+    boost::asio::streambuf m_request;
+};
+
+typedef boost::shared_ptr<SConnection> ConnectionPtr;
+
+/// Line server that refuses binary framing, acknowledges every other
+/// request and counts its connections
+class CFakeServer
+{
+public:
+    CFakeServer()
+        : m_acceptor(m_service, boost::asio::ip::tcp::endpoint(
+            boost::asio::ip::address_v4::loopback(), 0))
+        , m_connections(0)
+    {
+        Accept();
+        m_thread = boost::thread(
+            boost::bind(&boost::asio::io_service::run, &m_service));
+    }
+
+    ~CFakeServer()
+    {
+        m_service.stop();
+        m_thread.join();
+    }
+
+    /// The port the server listens on
+    std::string Port() const
+    {
+        return boost::lexical_cast<std::string>(
+            m_acceptor.local_endpoint().port());
+    }
+
+    /// Number of connections accepted so far
+    int Connections()
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        return m_connections;
+    }
+private:
+    /// Waits for the next client
+    void Accept()
+    {
+        ConnectionPtr connection(new SConnection(m_service));
+        m_acceptor.async_accept(connection->m_socket,
+            boost::bind(&CFakeServer::HandleAccept, this, connection,
+                boost::asio::placeholders::error));
+    }
+
+    /// Counts a new client and starts to read its requests
+    void HandleAccept(ConnectionPtr p_connection,
+        const boost::system::error_code & p_error)
+    {
+        if(!p_error)
+        {
+            {
+                boost::mutex::scoped_lock lock(m_mutex);
+                m_connections++;
+            }
+            Read(p_connection);
+        }
+        Accept();
+    }
+
+    /// Waits for the next request of a client
+    void Read(ConnectionPtr p_connection)
+    {
+        boost::asio::async_read_until(p_connection->m_socket,
+            p_connection->m_request, "\r\n",
+            boost::bind(&CFakeServer::HandleRead, this, p_connection,
+                boost::asio::placeholders::error));
+    }
+
+    /// Refuses BINARY so the client stays in text mode, accepts the rest
+    void HandleRead(ConnectionPtr p_connection,
+        const boost::system::error_code & p_error)
+    {
+        std::istream request(&p_connection->m_request);
+        std::string line;
+
+        if(p_error)
+        {
+            return;
+        }
+
+        std::getline(request, line);
+        if(line.compare(0, 6, "BINARY") == 0)
+        {
+            boost::asio::write(p_connection->m_socket,
+                boost::asio::buffer(std::string("400 BADREQUEST\r\n")));
+        }
+        else
+        {
+            boost::asio::write(p_connection->m_socket,
+                boost::asio::buffer(std::string("200 OK\r\n")));
+        }
+        Read(p_connection);
+    }
+
+    boost::asio::io_service m_service;
+    boost::asio::ip::tcp::acceptor m_acceptor;
+    boost::thread m_thread;
+    boost::mutex m_mutex;
+    int m_connections;
+};
+
+/// Holds one lease of p_pool until it is released
+void TakeLease(CLineClientPool * p_pool)
+{
+    CLineClientPool::CLease lease(*p_pool);
+}
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE( CLineClientPoolTests )
+
+BOOST_AUTO_TEST_CASE( EmptyPoolIsRejected )
+{
+    boost::asio::io_service service;
+
+    BOOST_CHECK_THROW( CLineClientPool::Create(service, "localhost", "4003", 0),
+        std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( ClientsConnectOnCreate )
+{
+    CFakeServer server;
+    boost::asio::io_service service;
+    CLineClientPool::TPointer pool =
+        CLineClientPool::Create(service, "127.0.0.1", server.Port(), 2);
+
+    BOOST_CHECK_EQUAL( pool->Size(), 2u );
+    BOOST_CHECK_EQUAL( server.Connections(), 2 );
+
+    CLineClientPool::CLease first(*pool);
+    CLineClientPool::CLease second(*pool);
+    BOOST_CHECK( first->IsOpen() );
+    BOOST_CHECK( second->IsOpen() );
+    BOOST_CHECK( !first->IsBinary() );
+}
+
+BOOST_AUTO_TEST_CASE( LeaseWaitsForReturn )
+{
+    CFakeServer server;
+    boost::asio::io_service service;
+    CLineClientPool::TPointer pool =
+        CLineClientPool::Create(service, "127.0.0.1", server.Port(), 1);
+    boost::thread waiter;
+
+    {
+        CLineClientPool::CLease lease(*pool);
+        waiter = boost::thread(boost::bind(&TakeLease, pool.get()));
+
+        // the only client is leased, so the second lease blocks
+        BOOST_CHECK( !waiter.timed_join(boost::posix_time::milliseconds(100)) );
+    }
+
+    BOOST_CHECK( waiter.timed_join(boost::posix_time::seconds(5)) );
+}
+
+BOOST_AUTO_TEST_CASE( ReturnKeepsConnection )
+{
+    CFakeServer server;
+    boost::asio::io_service service;
+    CLineClientPool::TPointer pool =
+        CLineClientPool::Create(service, "127.0.0.1", server.Port(), 1);
+
+    {
+        CLineClientPool::CLease lease(*pool);
+    }
+
+    CLineClientPool::CLease lease(*pool);
+    BOOST_CHECK( lease->IsOpen() );
+    BOOST_CHECK_EQUAL( server.Connections(), 1 );
+}
+
+BOOST_AUTO_TEST_CASE( UnwindingClosesClient )
+{
+    CFakeServer server;
+    boost::asio::io_service service;
+    CLineClientPool::TPointer pool =
+        CLineClientPool::Create(service, "127.0.0.1", server.Port(), 1);
+
+    try
+    {
+        CLineClientPool::CLease lease(*pool);
+        throw FreedmTestException();
+    }
+    catch(FreedmTestException &)
+    {
+    }
+
+    // the client was closed on return and reconnects for the next lease
+    CLineClientPool::CLease lease(*pool);
+    BOOST_CHECK( lease->IsOpen() );
+    BOOST_CHECK_EQUAL( server.Connections(), 2 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////
+/// @file      test_clogwriter.cpp
+///
+/// @author    Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler  C++
+///
+/// @project   FREEDM DGI
+///
+/// @description Unit tests for the CLogWriter class.
+///
+/// @sa CLogWriter
+///
+/// @license
+/// These source code files were created at as part of the
+/// FREEDM DGI Subthrust, and are
+/// intended for use in teaching or research.  They may be
+/// freely copied, modified and redistributed as long
+/// as modified versions are clearly marked as such and
+/// this notice is not removed.
+///
+/// Neither the authors nor the FREEDM Project nor the
+/// National Science Foundation
+/// make any warranty, express or implied, nor assumes
+/// any legal responsibility for the accuracy,
+/// completeness or usefulness of these codes or any
+/// information distributed with these codes.
+///
+/// Suggested modifications or questions about these codes
+/// can be directed to Dr. Bruce McMillin, Department of
+/// Computer Science, Missour University of Science and
+/// Technology, Rolla, /// MO  65409 (ff@mst.edu).
+///
+////////////////////////////////////////////////////////////////////
+#include "CLogWriter.hpp"
+
+#define BOOST_TEST_MAIN
+#include "unit_test.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+using namespace freedm::broker;
+
+namespace {
+
+const char * LOG_FILE = "test_clogwriter.log";
+
+/// Reads the whole log file and removes it
+std::string ReadLog()
+{
+    std::ifstream file(LOG_FILE);
+    std::stringstream contents;
+
+    contents << file.rdbuf();
+    file.close();
+    std::remove(LOG_FILE);
+    return contents.str();
+}
+
+/// Logs p_count numbered messages from the calling thread
+void LogMessages(const char * p_prefix, int p_count)
+{
+    for(int i = 0; i < p_count; i++)
+    {
+        LOG_NOTICE << p_prefix << " message " << i << std::endl;
+    }
+}
+
+/// Counts the occurrences of p_text in p_log
+size_t Count(const std::string & p_log, const std::string & p_text)
+{
+    size_t count = 0;
+    for(size_t i = p_log.find(p_text); i != std::string::npos;
+        i = p_log.find(p_text, i + 1))
+    {
+        count++;
+    }
+    return count;
+}
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE( CLogWriterTests )
+
+BOOST_AUTO_TEST_CASE( StreamWritesThroughWriter )
+{
+    std::remove(LOG_FILE);
+    {
+        CLogWriter writer(LOG_FILE);
+
+        Logger::Log::setLevel(5);
+        LOG_NOTICE << "through the writer" << std::endl;
+        LOG_INFO << "filtered" << std::endl;
+    }
+
+    std::string log = ReadLog();
+    BOOST_CHECK_EQUAL( Count(log, "Notice(5):\tthrough the writer\n"), 1u );
+    BOOST_CHECK_EQUAL( Count(log, "filtered"), 0u );
+}
+
+BOOST_AUTO_TEST_CASE( ThreadsKeepEveryMessage )
+{
+    std::remove(LOG_FILE);
+    {
+        CLogWriter writer(LOG_FILE, 4096);
+
+        Logger::Log::setLevel(5);
+        boost::thread first(boost::bind(&LogMessages, "first", 500));
+        boost::thread second(boost::bind(&LogMessages, "second", 500));
+        first.join();
+        second.join();
+
+        BOOST_CHECK_EQUAL( writer.Dropped(), 0u );
+    }
+
+    std::string log = ReadLog();
+    BOOST_CHECK_EQUAL( Count(log, "Notice(5):\tfirst message "), 500u );
+    BOOST_CHECK_EQUAL( Count(log, "Notice(5):\tsecond message "), 500u );
+    BOOST_CHECK_EQUAL( Count(log, "\n"), 1000u );
+    BOOST_CHECK_EQUAL( Count(log, "Notice(5):\tfirst message 499\n"), 1u );
+}
+
+BOOST_AUTO_TEST_CASE( LongMessageSpansRecords )
+{
+    std::string text(3*CLogWriter::RECORD_TEXT + 10, 'x');
+
+    std::remove(LOG_FILE);
+    {
+        CLogWriter writer(LOG_FILE);
+        CLogWriter::Append(4, "Long", text.c_str(), text.size());
+    }
+
+    BOOST_CHECK_EQUAL( Count(ReadLog(), "Long(4):\t" + text), 1u );
+}
+
+BOOST_AUTO_TEST_CASE( FullRingDropsMessage )
+{
+    std::string text(3*CLogWriter::RECORD_TEXT, 'x');
+
+    std::remove(LOG_FILE);
+    {
+        CLogWriter writer(LOG_FILE, 2);
+        CLogWriter::Append(4, "Large", text.c_str(), text.size());
+        BOOST_CHECK_EQUAL( writer.Dropped(), 1u );
+    }
+
+    std::string log = ReadLog();
+    BOOST_CHECK_EQUAL( Count(log, "Large"), 0u );
+    BOOST_CHECK_EQUAL( Count(log, "1 messages dropped"), 1u );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////////////
+/// @file      test_cphysicaldevicemanager.cpp
+///
+/// @author    Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler  C++
+///
+/// @project   FREEDM DGI
+///
+/// @description Unit tests for the CPhysicalDeviceManager type index.
+///
+/// @sa CPhysicalDeviceManager
+///
+/// @license
+/// These source code files were created at as part of the
+/// FREEDM DGI Subthrust, and are
+/// intended for use in teaching or research.  They may be
+/// freely copied, modified and redistributed as long
+/// as modified versions are clearly marked as such and
+/// this notice is not removed.
+///
+/// Neither the authors nor the FREEDM Project nor the
+/// National Science Foundation
+/// make any warranty, express or implied, nor assumes
+/// any legal responsibility for the accuracy,
+/// completeness or usefulness of these codes or any
+/// information distributed with these codes.
+///
+/// Suggested modifications or questions about these codes
+/// can be directed to Dr. Bruce McMillin, Department of
+/// Computer Science, Missour University of Science and
+/// Technology, Rolla, /// MO  65409 (ff@mst.edu).
+///
+////////////////////////////////////////////////////////////////////
+#include "CPhysicalDeviceManager.hpp"
+#include "IPhysicalDevice.hpp"
+
+#define BOOST_TEST_MAIN
+#include "unit_test.hpp"
+
+#include <boost/lambda/lambda.hpp>
+
+using namespace freedm::broker;
+
+/// Device with a fixed power level that counts its readings
+struct TestDevice : public IPhysicalDevice
+{
+    TestDevice( CPhysicalDeviceManager & p_manager, Identifier p_id,
+        DeviceType p_type, SettingValue p_power )
+        : IPhysicalDevice(p_manager, p_id, p_type), m_power(p_power), m_reads(0)
+    { }
+
+    virtual SettingValue Get( SettingKeyId key )
+    {
+        UNUSED_ARGUMENT( key );
+        return m_power;
+    }
+
+    virtual void Set( SettingKeyId key, SettingValue value )
+    {
+        UNUSED_ARGUMENT( key );
+        m_power = value;
+    }
+
+    virtual void turnOn() { }
+    virtual void turnOff() { }
+
+    virtual SettingValue get_powerLevel()
+    {
+        m_reads++;
+        return m_power;
+    }
+
+    SettingValue m_power;
+    int m_reads;
+};
+
+struct TestCPhysicalDeviceManager
+{
+    TestCPhysicalDeviceManager()
+    {
+        for( int i = 0; i < 9; i++ )
+        {
+            m_manager.AddDevice( IPhysicalDevice::DevicePtr( new TestDevice(
+                m_manager, "load" + to_id(i), physicaldevices::LOAD, i ) ) );
+        }
+        m_manager.AddDevice( IPhysicalDevice::DevicePtr( new TestDevice(
+            m_manager, "pv", physicaldevices::DRER, 2.5 ) ) );
+    }
+
+    static std::string to_id( int i )
+    {
+        return std::string( 1, static_cast<char>('0' + i) );
+    }
+
+    CPhysicalDeviceManager m_manager;
+};
+
+BOOST_FIXTURE_TEST_SUITE( CPhysicalDeviceManagerTests, TestCPhysicalDeviceManager )
+
+BOOST_AUTO_TEST_CASE( CountByType )
+{
+    BOOST_CHECK_EQUAL( m_manager.DeviceCount(), 10u );
+    BOOST_CHECK_EQUAL( m_manager.DeviceCount(physicaldevices::LOAD), 9u );
+    BOOST_CHECK_EQUAL( m_manager.DeviceCount(physicaldevices::DRER), 1u );
+    BOOST_CHECK_EQUAL( m_manager.DeviceCount(physicaldevices::DG), 0u );
+}
+
+BOOST_AUTO_TEST_CASE( NetPowerLevel )
+{
+    // cache is empty until the first refresh
+    BOOST_CHECK_EQUAL( m_manager.GetNetPowerLevel(physicaldevices::LOAD), 0.0 );
+
+    m_manager.RefreshPowerLevels();
+    BOOST_CHECK_EQUAL( m_manager.GetNetPowerLevel(physicaldevices::LOAD), 36.0 );
+    BOOST_CHECK_EQUAL( m_manager.GetNetPowerLevel(physicaldevices::DRER), 2.5 );
+    BOOST_CHECK_EQUAL( m_manager.GetNetPowerLevel(physicaldevices::DG), 0.0 );
+}
+
+BOOST_AUTO_TEST_CASE( RemoveDevice )
+{
+    m_manager.RefreshPowerLevels();
+    m_manager.RemoveDevice( "load3" );
+
+    BOOST_CHECK( !m_manager.DeviceExists("load3") );
+    BOOST_CHECK_EQUAL( m_manager.DeviceCount(physicaldevices::LOAD), 8u );
+    BOOST_CHECK_EQUAL( m_manager.GetNetPowerLevel(physicaldevices::LOAD), 33.0 );
+}
+
+BOOST_AUTO_TEST_CASE( ReplaceDevice )
+{
+    m_manager.AddDevice( IPhysicalDevice::DevicePtr( new TestDevice(
+        m_manager, "load0", physicaldevices::DG, 4.0 ) ) );
+    m_manager.RefreshPowerLevels();
+
+    BOOST_CHECK_EQUAL( m_manager.DeviceCount(), 10u );
+    BOOST_CHECK_EQUAL( m_manager.DeviceCount(physicaldevices::LOAD), 8u );
+    BOOST_CHECK_EQUAL( m_manager.GetNetPowerLevel(physicaldevices::DG), 4.0 );
+}
+
+BOOST_AUTO_TEST_CASE( StepHooks )
+{
+    int begun = 0;
+    int finished = 0;
+
+    // without hooks a step is a no-op
+    BOOST_CHECK( m_manager.BeginStep() );
+    m_manager.FinishStep();
+
+    m_manager.SetStepHooks( (boost::lambda::var(begun)++, true),
+        boost::lambda::var(finished)++ );
+    BOOST_CHECK( m_manager.BeginStep() );
+    m_manager.FinishStep();
+    BOOST_CHECK( m_manager.BeginStep() );
+
+    BOOST_CHECK_EQUAL( begun, 2 );
+    BOOST_CHECK_EQUAL( finished, 1 );
+
+    // a begin hook without a new step skips the cycle
+    m_manager.SetStepHooks( (boost::lambda::var(begun)++, false),
+        boost::lambda::var(finished)++ );
+    BOOST_CHECK( !m_manager.BeginStep() );
+    BOOST_CHECK_EQUAL( begun, 3 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
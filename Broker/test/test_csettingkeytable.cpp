@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////
+/// @file      test_csettingkeytable.cpp
+///
+/// @author    Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler  C++
+///
+/// @project   FREEDM DGI
+///
+/// @description Unit tests for the CSettingKeyTable class.
+///
+/// @sa CSettingKeyTable
+///
+/// @license
+/// These source code files were created at as part of the
+/// FREEDM DGI Subthrust, and are
+/// intended for use in teaching or research.  They may be
+/// freely copied, modified and redistributed as long
+/// as modified versions are clearly marked as such and
+/// this notice is not removed.
+///
+/// Neither the authors nor the FREEDM Project nor the
+/// National Science Foundation
+/// make any warranty, express or implied, nor assumes
+/// any legal responsibility for the accuracy,
+/// completeness or usefulness of these codes or any
+/// information distributed with these codes.
+///
+/// Suggested modifications or questions about these codes
+/// can be directed to Dr. Bruce McMillin, Department of
+/// Computer Science, Missour University of Science and
+/// Technology, Rolla, /// MO  65409 (ff@mst.edu).
+///
+////////////////////////////////////////////////////////////////////
+#include "CSettingKeyTable.hpp"
+
+#define BOOST_TEST_MAIN
+#include "unit_test.hpp"
+
+#include <stdexcept>
+
+using namespace freedm::broker;
+
+BOOST_AUTO_TEST_SUITE( CSettingKeyTableTests )
+
+BOOST_AUTO_TEST_CASE( KnownKeys )
+{
+    CSettingKeyTable & table = CSettingKeyTable::instance();
+
+    BOOST_CHECK_EQUAL( table.Intern("powerLevel"),
+        static_cast<physicaldevices::SettingKeyId>(physicaldevices::POWER_LEVEL) );
+    BOOST_CHECK_EQUAL( table.Intern("onOffSwitch"),
+        static_cast<physicaldevices::SettingKeyId>(physicaldevices::ON_OFF_SWITCH) );
+    BOOST_CHECK_EQUAL( table.GetName(physicaldevices::POWER_LEVEL), "powerLevel" );
+}
+
+BOOST_AUTO_TEST_CASE( NewKeys )
+{
+    CSettingKeyTable & table = CSettingKeyTable::instance();
+    size_t size = table.Size();
+
+    physicaldevices::SettingKeyId id = table.Intern("stateOfCharge");
+    BOOST_CHECK_EQUAL( id, size );
+    BOOST_CHECK_EQUAL( table.Intern("stateOfCharge"), id );
+    BOOST_CHECK_EQUAL( table.GetName(id), "stateOfCharge" );
+    BOOST_CHECK_EQUAL( table.Size(), size + 1 );
+}
+
+BOOST_AUTO_TEST_CASE( UnknownId )
+{
+    CSettingKeyTable & table = CSettingKeyTable::instance();
+
+    BOOST_CHECK_THROW( table.GetName(table.Size()), std::out_of_range );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////
+/// @file      test_ctimeseries.cpp
+///
+/// @author    Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler  C++
+///
+/// @project   FREEDM DGI
+///
+/// @description Unit tests for the CTimeSeries class.
+///
+/// @sa CTimeSeries
+///
+/// @license
+/// These source code files were created at as part of the
+/// FREEDM DGI Subthrust, and are
+/// intended for use in teaching or research.  They may be
+/// freely copied, modified and redistributed as long
+/// as modified versions are clearly marked as such and
+/// this notice is not removed.
+///
+/// Neither the authors nor the FREEDM Project nor the
+/// National Science Foundation
+/// make any warranty, express or implied, nor assumes
+/// any legal responsibility for the accuracy,
+/// completeness or usefulness of these codes or any
+/// information distributed with these codes.
+///
+/// Suggested modifications or questions about these codes
+/// can be directed to Dr. Bruce McMillin, Department of
+/// Computer Science, Missour University of Science and
+/// Technology, Rolla, /// MO  65409 (ff@mst.edu).
+///
+////////////////////////////////////////////////////////////////////
+#include "CTimeSeries.hpp"
+#include "CTimeSeries.hpp"
+
+#define BOOST_TEST_MAIN
+#include "unit_test.hpp"
+
+#include <boost/thread.hpp>
+
+using namespace freedm::broker;
+using boost::posix_time::ptime;
+using boost::posix_time::seconds;
+using boost::posix_time::time_from_string;
+
+namespace {
+
+const ptime START = time_from_string("2011-06-01 12:00:00.000");
+
+/// Records value = 2t + 1 for t = 0..count-1 seconds after START
+void RecordLine(CTimeSeries & series, int count)
+{
+    for(int t = 0; t < count; t++)
+    {
+        series.Record(START + seconds(t), 2.0*t + 1.0);
+    }
+}
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE( CTimeSeriesTests )
+
+BOOST_AUTO_TEST_CASE( CapacityRoundsUp )
+{
+    CTimeSeries series(100);
+
+    BOOST_CHECK_EQUAL( series.Capacity(), 128u );
+    BOOST_CHECK_EQUAL( series.Recorded(), 0u );
+}
+
+BOOST_AUTO_TEST_CASE( EmptyWindow )
+{
+    CTimeSeries series(8);
+    CTimeSeries::Summary summary = series.Summarize(10.0, START);
+
+    BOOST_CHECK_EQUAL( summary.m_count, 0u );
+    BOOST_CHECK_EQUAL( summary.m_mean, 0.0 );
+    BOOST_CHECK( series.GetWindow(10.0, START).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( WindowIsOldestFirst )
+{
+    CTimeSeries series(16);
+    RecordLine(series, 10);
+
+    // samples at 7, 8 and 9 seconds are inside the last 3 seconds
+    std::vector<CTimeSeries::Sample> window =
+        series.GetWindow(3.0, START + seconds(9));
+
+    BOOST_REQUIRE_EQUAL( window.size(), 3u );
+    BOOST_CHECK( window[0].m_time == START + seconds(7) );
+    BOOST_CHECK_EQUAL( window[0].m_value, 15.0 );
+    BOOST_CHECK_EQUAL( window[2].m_value, 19.0 );
+}
+
+BOOST_AUTO_TEST_CASE( Aggregates )
+{
+    CTimeSeries series(16);
+    RecordLine(series, 10);
+
+    CTimeSeries::Summary summary = series.Summarize(5.0, START + seconds(9));
+
+    BOOST_CHECK_EQUAL( summary.m_count, 5u );
+    BOOST_CHECK_CLOSE( summary.m_mean, 15.0, 1e-9 );
+    BOOST_CHECK_EQUAL( summary.m_min, 11.0 );
+    BOOST_CHECK_EQUAL( summary.m_max, 19.0 );
+    BOOST_CHECK_CLOSE( summary.m_slope, 2.0, 1e-9 );
+}
+
+BOOST_AUTO_TEST_CASE( OverwritesOldest )
+{
+    CTimeSeries series(4);
+    RecordLine(series, 10);
+
+    std::vector<CTimeSeries::Sample> window =
+        series.GetWindow(100.0, START + seconds(9));
+
+    BOOST_CHECK_EQUAL( series.Recorded(), 10u );
+    BOOST_REQUIRE_EQUAL( window.size(), 4u );
+    BOOST_CHECK( window[0].m_time == START + seconds(6) );
+}
+
+BOOST_AUTO_TEST_CASE( ConcurrentReaders )
+{
+    CTimeSeries series(8);
+    boost::thread writer(boost::bind(&RecordLine, boost::ref(series), 100000));
+
+    // every sample a reader sees must lie on the recorded line
+    while(series.Recorded() < 100000)
+    {
+        std::vector<CTimeSeries::Sample> window =
+            series.GetWindow(1e6, START + seconds(100000));
+        for(size_t i = 0; i < window.size(); i++)
+        {
+            double t = (window[i].m_time - START).total_seconds();
+            BOOST_REQUIRE_EQUAL( window[i].m_value, 2.0*t + 1.0 );
+        }
+    }
+    writer.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////
+/// @file      test_logger.cpp
+///
+/// @author    Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler  C++
+///
+/// @project   FREEDM DGI
+///
+/// @description Unit tests for the gated log macros.
+///
+/// @sa logger.hpp
+///
+/// @license
+/// These source code files were created at as part of the
+/// FREEDM DGI Subthrust, and are
+/// intended for use in teaching or research.  They may be
+/// freely copied, modified and redistributed as long
+/// as modified versions are clearly marked as such and
+/// this notice is not removed.
+///
+/// Neither the authors nor the FREEDM Project nor the
+/// National Science Foundation
+/// make any warranty, express or implied, nor assumes
+/// any legal responsibility for the accuracy,
+/// completeness or usefulness of these codes or any
+/// information distributed with these codes.
+///
+/// Suggested modifications or questions about these codes
+/// can be directed to Dr. Bruce McMillin, Department of
+/// Computer Science, Missour University of Science and
+/// Technology, Rolla, /// MO  65409 (ff@mst.edu).
+///
+////////////////////////////////////////////////////////////////////
+#define BOOST_TEST_MAIN
+#include "unit_test.hpp"
+
+#include <sstream>
+#include <string>
+
+namespace {
+
+std::ostringstream captured;
+
+/// Counts its calls so a test can tell whether a log operand was evaluated
+int Evaluate(int & calls)
+{
+    return ++calls;
+}
+
+} // unnamed namespace
+
+namespace Logger {
+/// Notice level log that writes to the captured stream
+boost::iostreams::stream<Log> Capture( 5, "Capture", &captured );
+}
+
+BOOST_AUTO_TEST_SUITE( LoggerTests )
+
+BOOST_AUTO_TEST_CASE( FilteredOperandsAreNotEvaluated )
+{
+    int calls = 0;
+
+    Logger::Log::setLevel(4);
+    LOG_IF(5, Capture) << Evaluate(calls) << std::endl;
+    LOG_DEBUG << Evaluate(calls) << std::endl;
+
+    BOOST_CHECK_EQUAL( calls, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( EnabledMessageIsWritten )
+{
+    int calls = 0;
+
+    captured.str("");
+    Logger::Log::setLevel(5);
+    LOG_IF(5, Capture) << "value " << Evaluate(calls) << std::endl;
+
+    BOOST_CHECK_EQUAL( calls, 1 );
+    BOOST_CHECK( captured.str().find("Capture(5):\tvalue 1") != std::string::npos );
+}
+
+BOOST_AUTO_TEST_CASE( LevelAboveThresholdIsCompiledOut )
+{
+    int calls = 0;
+
+    Logger::Log::setLevel(LOG_MAX_LEVEL + 1);
+    LOG_IF(LOG_MAX_LEVEL + 1, Capture) << Evaluate(calls) << std::endl;
+
+    BOOST_CHECK_EQUAL( calls, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( GatedLogNestsInUnbracedIf )
+{
+    int calls = 0;
+
+    Logger::Log::setLevel(0);
+    if( calls == 0 )
+        LOG_DEBUG << Evaluate(calls) << std::endl;
+    else
+        calls = -1;
+
+    BOOST_CHECK_EQUAL( calls, 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -112,8 +112,8 @@ std::ostream & operator<<( std::ostream & p_os, const CDeviceKey & p_dkey );
 ///     structures.
 ///
 /// @limitations
-///     Because the device key is meant to be used as an index in standard data
-///     structures, it has no accessors for its data members.
+///     The device key is meant to be used as an index in standard data
+///     structures, so its data members can be read but not modified.
 ///
 ////////////////////////////////////////////////////////////////////////////////
 class CDeviceKey
@@ -147,6 +147,12 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     CDeviceKey( const std::string & p_device, const std::string & p_key );
     
+    /// returns the unique device identifier
+    const std::string & GetDevice() const { return m_device; }
+    
+    /// returns the device variable of interest
+    const std::string & GetKey() const { return m_key; }
+    
     friend bool operator<( const CDeviceKey & p_lhs, const CDeviceKey & p_rhs );
     friend std::ostream & operator<<( std::ostream & p_os, const CDeviceKey & p_dkey );
 private:
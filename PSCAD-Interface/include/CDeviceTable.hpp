@@ -12,6 +12,7 @@
 ///
 /// @functions
 ///     CDeviceTable::CDeviceTable( const string &, const string & )
+///     CDeviceTable::CDeviceTable( const CTableLayout &, const string & )
 ///     CDeviceTable::SetValue( const CDeviceKey &, size_t, double )
 ///     CDeviceTable::GetValue( const CDeviceKey &, size_t )
 ///
@@ -34,14 +35,22 @@
 #define C_DEVICE_TABLE_HPP
 
 #include <string>
+#include <vector>
 #include <sstream>
 #include <iostream>
 #include <stdexcept>
 
+#include <boost/cstdint.hpp>
+#include <boost/function.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/thread/shared_mutex.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 
 #include "logger.hpp"
+#include "CMetrics.hpp"
 #include "CDeviceKey.hpp"
+#include "CTraceRing.hpp"
 #include "CTableStructure.hpp"
 
 CREATE_EXTERN_STD_LOGS()
@@ -58,13 +67,36 @@ class CSimulationServer;
 ///     The device table class stores a set of data indexed by device key. Its
 ///     internal structure is defined by an XML file passed to the constructor.
 ///
+///     The table is double-buffered for the simulation server. A bulk update
+///     is written into a back buffer without holding a table lock and
+///     published with a pointer swap, so readers never wait on network I/O and
+///     always see a complete simulation step.
+///
+///     The entries are partitioned by their parent SST when the table is
+///     loaded. Each partition has its own lock, and entries shared by several
+///     SST or owned by none are locked in a common partition. The interfaces
+///     of different SST therefore never contend with each other for a single
+///     entry. Only whole-table operations take every partition lock.
+///
+///     A bulk update may also be a delta that lists only the changed entries.
+///     The back buffer is brought up to date by copying the entries changed
+///     by the previous delta, so a delta costs time in proportion to the
+///     entries that change rather than to the table size.
+///
+///     Each publish increments the step version of the table. A reader can
+///     register a callback with AsyncWait to learn of the next step instead
+///     of polling the table for changes.
+///
 /// @limitations
-///     none
+///     A bulk update replaces every entry of the table. Entries set through
+///     SetValue while a bulk update is in progress are overwritten.
 ///
 ////////////////////////////////////////////////////////////////////////////////
 class CDeviceTable
 {
 public:
+    typedef boost::function< void ( boost::uint64_t ) > TWaitCallback;
+    
     ////////////////////////////////////////////////////////////////////////////
     /// CDeviceTable( const string &, const string & )
     ///
@@ -81,7 +113,7 @@ public:
     ///     p_xml has the correct format
     ///
     /// @post
-    ///     m_data is allocated
+    ///     m_data and m_back are allocated
     ///
     /// @param
     ///     p_xml is the filename of the XML input file
@@ -94,6 +126,37 @@ public:
     ///
     ////////////////////////////////////////////////////////////////////////////
     CDeviceTable( const std::string & p_xml, const std::string & p_tag );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// CDeviceTable( const CTableLayout &, const string & )
+    ///
+    /// @description
+    ///     Creates an instance of CDeviceTable from a table of a layout that
+    ///     has already been read.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Throws an exception if the layout has no table with p_tag.
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     m_data and m_back are allocated
+    ///
+    /// @param
+    ///     p_layout holds the parsed XML input file
+    ///     p_tag is the XML tag of the table specification
+    ///
+    /// @limitations
+    ///     none
+    ///
+    /// @see CTableStructure::CTableStructure( const CTableLayout &, const string & )
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    CDeviceTable( const CTableLayout & p_layout, const std::string & p_tag );
 
     ////////////////////////////////////////////////////////////////////////////
     /// SetValue( const CDeviceKey &, size_t, double )
@@ -114,7 +177,7 @@ public:
     ///     p_index has access to p_dkey in m_structure
     ///
     /// @post
-    ///     m_mutex is obtained with unique access
+    ///     the partition lock of the entry is obtained with unique access
     ///     one element of m_data is modified
     ///
     /// @param
@@ -149,7 +212,7 @@ public:
     ///     p_index has access to p_dkey in m_structure
     ///
     /// @post
-    ///     m_mutex is obtained with shared access
+    ///     the partition lock of the entry is obtained with shared access
     ///
     /// @param
     ///     p_dkey is the index for the value in the table
@@ -166,6 +229,107 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     double GetValue( const CDeviceKey & p_dkey, size_t p_index );
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// SetEntry( size_t, double )
+    ///
+    /// @description
+    ///     Modifies the table entry at the given position.
+    ///
+    /// @Shared_Memory
+    ///     m_data can be modified outside of the class
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     p_entry is less than m_length
+    ///     the caller has checked access to p_entry against m_structure
+    ///
+    /// @post
+    ///     the partition lock of the entry is obtained with unique access
+    ///     one element of m_data is modified
+    ///
+    /// @param
+    ///     p_entry is the position of the table entry
+    ///     p_value is the new value for the table entry
+    ///
+    /// @limitations
+    ///     Neither precondition is checked.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void SetEntry( size_t p_entry, double p_value );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// GetEntry( size_t )
+    ///
+    /// @description
+    ///     Returns the table entry at the given position.
+    ///
+    /// @Shared_Memory
+    ///     m_data can be modified outside of the class
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     p_entry is less than m_length
+    ///     the caller has checked access to p_entry against m_structure
+    ///
+    /// @post
+    ///     the partition lock of the entry is obtained with shared access
+    ///
+    /// @param
+    ///     p_entry is the position of the table entry
+    ///
+    /// @return
+    ///     m_data element at p_entry
+    ///
+    /// @limitations
+    ///     Neither precondition is checked.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    double GetEntry( size_t p_entry );
+    
+    /// returns the structure of the table
+    const CTableStructure & GetStructure() const { return m_structure; }
+    
+    /// returns the number of bulk updates published to the table
+    boost::uint64_t GetVersion();
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// AsyncWait( uint64_t, TWaitCallback )
+    ///
+    /// @description
+    ///     Calls p_callback once the step version exceeds p_version.
+    ///
+    /// @Shared_Memory
+    ///     m_waiters can be modified outside of the class
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     m_waiting is obtained for the version check
+    ///     p_callback has been called or is stored in m_waiters
+    ///
+    /// @param
+    ///     p_version is the last step version seen by the caller
+    ///     p_callback receives the step version that satisfied the wait
+    ///
+    /// @limitations
+    ///     p_callback runs on the thread that publishes the step, or on the
+    ///     calling thread if the step has already been published. Callers that
+    ///     need a particular thread must post the work from p_callback.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void AsyncWait( boost::uint64_t p_version, TWaitCallback p_callback );
+    
+    /// names the metrics of the table with the given prefix
+    void AddMetrics( CMetrics & p_metrics, const std::string & p_prefix ) const;
+    
     ////////////////////////////////////////////////////////////////////////////
     /// ~CDeviceTable
     ///
@@ -182,7 +346,7 @@ public:
     ///     none
     ///
     /// @post
-    ///     m_data is deallocated
+    ///     m_data and m_back are deallocated
     ///
     /// @limitations
     ///     none
@@ -192,17 +356,180 @@ public:
     
     friend class CSimulationServer;
 private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// Publish
+    ///
+    /// @description
+    ///     Makes the back buffer the visible table after a bulk update.
+    ///
+    /// @Shared_Memory
+    ///     m_data and m_back are swapped
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     m_writer is held by the caller
+    ///     every element of m_back has been written, or ApplyDelta was called
+    ///
+    /// @post
+    ///     every partition lock is obtained with unique access for the swap only
+    ///     m_back holds the previous contents of m_data
+    ///     m_version is incremented and every stored waiter is called
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void Publish();
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// BeginFullUpdate
+    ///
+    /// @description
+    ///     Marks the back buffer as stale before a bulk update overwrites it,
+    ///     so that a partial update is never mistaken for a delta base.
+    ///
+    /// @Shared_Memory
+    ///     m_backStale and m_deltaApplied are modified
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     m_writer is held by the caller
+    ///
+    /// @post
+    ///     the next ApplyDelta copies the whole visible table into m_back
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void BeginFullUpdate();
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// ApplyDelta( const vector<uint32_t> &, const vector<double> & )
+    ///
+    /// @description
+    ///     Prepares the back buffer for a bulk update that changes only the
+    ///     listed entries of the visible table.
+    ///
+    /// @Shared_Memory
+    ///     m_back is modified and m_data is read
+    ///
+    /// @Error_Handling
+    ///     Throws std::out_of_range if an index is outside the table, before
+    ///     any entry is modified.
+    ///
+    /// @pre
+    ///     m_writer is held by the caller
+    ///     p_index and p_value have the same length
+    ///
+    /// @post
+    ///     every partition lock is obtained with shared access to bring m_back
+    ///     up to date
+    ///     m_back holds m_data with the listed entries replaced
+    ///     the next Publish keeps m_lastDelta for the following delta
+    ///
+    /// @param
+    ///     p_index lists the table entries that changed
+    ///     p_value lists the new value of each entry in p_index
+    ///
+    /// @limitations
+    ///     The first delta after a full update copies the whole table.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void ApplyDelta( const std::vector<boost::uint32_t> & p_index,
+        const std::vector<double> & p_value );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// Snapshot( vector<double> & )
+    ///
+    /// @description
+    ///     Copies the visible table so it can be sent without holding a lock.
+    ///
+    /// @Shared_Memory
+    ///     m_data is read
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     every partition lock is obtained with shared access for the copy only
+    ///     p_copy holds the m_length elements of m_data
+    ///
+    /// @param
+    ///     p_copy is the destination of the copy
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void Snapshot( std::vector<double> & p_copy );
+    
+    /// allocates the buffers and partitions once m_structure is built
+    void Initialize();
+    
+    /// obtains one partition lock and measures the wait if it is contended
+    void LockPartition( size_t p_partition, bool p_unique );
+    
+    /// obtains every partition lock in order, with unique or shared access
+    void LockPartitions( bool p_unique );
+    
+    /// releases every partition lock obtained by LockPartitions
+    void UnlockPartitions( bool p_unique );
+    
     /// manages the XML specification
     CTableStructure m_structure;
     
-    /// read-write mutex for m_data
-    boost::shared_mutex m_mutex;
+    /// read-write mutex for the entries of each partition, common one first
+    boost::scoped_array<boost::shared_mutex> m_partitions;
+    
+    /// number of m_partitions elements
+    size_t m_partitionCount;
+    
+    /// partition of each table entry
+    std::vector<size_t> m_partitionOf;
+    
+    /// microseconds waited for each contended partition lock
+    CHistogram m_lockWait;
+    
+    /// microseconds a publish holds every partition lock
+    CHistogram m_publishHold;
+    
+    /// serializes bulk updates of m_back
+    boost::mutex m_writer;
     
     /// stored device variables
     double * m_data;
     
+    /// destination of the next bulk update
+    double * m_back;
+    
     /// number of m_data elements
     size_t m_length;
+    
+    /// entries of m_back older than m_data, unless m_backStale is set
+    std::vector<boost::uint32_t> m_lastDelta;
+    
+    /// true if every entry of m_back may be older than m_data
+    bool m_backStale;
+    
+    /// true if the bulk update in m_back was prepared by ApplyDelta
+    bool m_deltaApplied;
+    
+    /// protects m_version and m_waiters
+    boost::mutex m_waiting;
+    
+    /// number of bulk updates published
+    boost::uint64_t m_version;
+    
+    /// callbacks to run when the next step is published
+    std::vector<TWaitCallback> m_waiters;
 };
 
 } // namespace simulation
@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CExchangeLog.hpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @description
+///     Binary log of the tables exchanged with the simulation.
+///
+/// @functions
+///     CExchangeLog( const string &, size_t, size_t )
+///     CExchangeReplay( const string &, size_t, size_t )
+///
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_EXCHANGE_LOG_HPP
+#define C_EXCHANGE_LOG_HPP
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/cstdint.hpp>
+#include <boost/utility.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include "logger.hpp"
+
+CREATE_EXTERN_STD_LOGS()
+
+namespace freedm {
+namespace simulation {
+
+////////////////////////////////////////////////////////////////////////////////
+/// CExchangeLog
+///
+/// @description
+///     Records every state table received from the simulation and every
+///     command table sent to it, so a run can be replayed without the
+///     simulation. The log starts with a header of four 32-bit fields: the
+///     magic "FXLG", the format version, and the lengths of the state and
+///     command tables. Each record that follows holds a one byte type, the
+///     microseconds since the log was opened as a 64-bit integer, and the
+///     table as doubles.
+///
+/// @limitations
+///     Fields are written in host byte order, so a log is replayed on a host
+///     of the same architecture. Records are flushed every FLUSH_PERIOD, so a
+///     process killed by a signal loses at most that much of its log.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CExchangeLog : private boost::noncopyable
+{
+public:
+    /// record types of the log
+    enum ERecord { RECORD_STATE = 'S', RECORD_COMMAND = 'C' };
+    
+    /// identifies the log format
+    static const boost::uint32_t MAGIC = 0x474C5846;
+    
+    /// version of the log format
+    static const boost::uint32_t VERSION = 1;
+    
+    /// milliseconds between flushes of the recorded tables
+    static const long FLUSH_PERIOD = 1000;
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// CExchangeLog( const string &, size_t, size_t )
+    ///
+    /// @description
+    ///     Creates a log file and writes its header.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Throws std::runtime_error if the file cannot be created.
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     m_file holds the header of the log
+    ///
+    /// @param
+    ///     p_filename is the file to record into, replaced if it exists
+    ///     p_state is the number of entries in the state table
+    ///     p_command is the number of entries in the command table
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    CExchangeLog( const std::string & p_filename, size_t p_state, size_t p_command );
+    
+    /// flushes the records that are still buffered
+    ~CExchangeLog();
+    
+    /// appends a state table received from the simulation
+    void RecordState( const double * p_state );
+    
+    /// appends a command table sent to the simulation
+    void RecordCommand( const double * p_command );
+    
+    /// writes the buffered records to the file
+    void Flush();
+private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// Record( ERecord, const double *, size_t )
+    ///
+    /// @description
+    ///     Appends one timestamped table to the log.
+    ///
+    /// @Shared_Memory
+    ///     m_file can be written by the session threads of the server
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     p_table holds p_length elements
+    ///
+    /// @post
+    ///     m_mutex is obtained for the write
+    ///     m_file is flushed if FLUSH_PERIOD has passed since m_lastFlush
+    ///
+    /// @param
+    ///     p_type is the type of the record
+    ///     p_table is the table to record
+    ///     p_length is the number of elements in p_table
+    ///
+    /// @limitations
+    ///     Write errors are not reported, the log stops growing instead.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void Record( ERecord p_type, const double * p_table, size_t p_length );
+    
+    /// serializes the session threads that record
+    boost::mutex m_mutex;
+    
+    /// destination of the log
+    std::ofstream m_file;
+    
+    /// time the log was opened
+    boost::posix_time::ptime m_start;
+    
+    /// time the records were last flushed
+    boost::posix_time::ptime m_lastFlush;
+    
+    /// number of state table entries
+    size_t m_state;
+    
+    /// number of command table entries
+    size_t m_command;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// CExchangeReplay
+///
+/// @description
+///     Reads back the records of a log written by CExchangeLog.
+///
+/// @limitations
+///     none
+///
+////////////////////////////////////////////////////////////////////////////////
+class CExchangeReplay : private boost::noncopyable
+{
+public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// CExchangeReplay( const string &, size_t, size_t )
+    ///
+    /// @description
+    ///     Opens a log and checks that it matches the given tables.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Throws std::runtime_error if the file cannot be read, is not a log
+    ///     or was recorded with tables of another size.
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     m_file is positioned at the first record
+    ///
+    /// @param
+    ///     p_filename is the log to replay
+    ///     p_state is the number of entries in the state table
+    ///     p_command is the number of entries in the command table
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    CExchangeReplay( const std::string & p_filename, size_t p_state, size_t p_command );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// Next( ERecord &, uint64_t &, vector<double> & )
+    ///
+    /// @description
+    ///     Reads the next record of the log.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     m_file is positioned after the record
+    ///
+    /// @param
+    ///     p_type is set to the type of the record
+    ///     p_time is set to the microseconds since the log was opened
+    ///     p_table is set to the recorded table
+    ///
+    /// @return
+    ///     false at the end of the log or on a truncated record
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    bool Next( CExchangeLog::ERecord & p_type, boost::uint64_t & p_time,
+        std::vector<double> & p_table );
+private:
+    /// source of the log
+    std::ifstream m_file;
+    
+    /// number of state table entries
+    size_t m_state;
+    
+    /// number of command table entries
+    size_t m_command;
+};
+
+} // namespace simulation
+} // namespace freedm
+
+#endif // C_EXCHANGE_LOG_HPP
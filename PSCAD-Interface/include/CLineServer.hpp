@@ -11,7 +11,7 @@
 ///     Server side implementation of the simulation line protocol.
 ///
 /// @functions
-///     Create( io_service &, unsigned short, TGetCallback, TSetCallback )
+///     Create( io_service &, unsigned short, TResolveCallback, TSetCallback, TGetCallback )
 ///
 /// These source code files were created at the Missouri University of Science
 /// and Technology, and are intended for use in teaching or research. They may
@@ -36,6 +36,7 @@
 #include <stdexcept>
 
 #include <boost/asio.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/bind.hpp>
 #include <boost/utility.hpp>
 #include <boost/function.hpp>
@@ -48,6 +49,8 @@ CREATE_EXTERN_STD_LOGS()
 namespace freedm {
 namespace simulation {
 
+class CLineSession;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// CLineServer
 ///
@@ -57,6 +60,36 @@ namespace simulation {
 ///     the unique identifier of some physical hardware and Key is the variable
 ///     name of that hardware to be manipulated.
 ///
+///     RESOLVE returns the integer handle of a (Device,Key) pair. GETH and SETH
+///     take that handle in place of the pair and skip the name lookup. GET and
+///     SET resolve their pair on every request.
+///
+///     A client can send BINARY to switch its connection to binary framing.
+///     After the 200 OK response every request and response is a fixed-size
+///     frame of FRAME_SIZE bytes: opcode (1), status (1), payload length (2),
+///     handle (4) and value (8). Integers and the IEEE-754 value are sent in
+///     network byte order. RESOLVE carries "device key" as its payload and
+///     returns a handle; GET and SET then refer to that handle, so names are
+///     only sent once per connection.
+///
+///     WAIT takes the last step version the client has seen and answers with
+///     the current version once the simulation server has published a newer
+///     step, so clients can block on the next step instead of polling. WAIT 0
+///     returns as soon as the first step has arrived. In binary framing the
+///     version is carried in the value field of an OP_WAIT frame.
+///
+///     DONE takes the step version the client has finished with, including
+///     any commands it issued for that step. In lockstep mode the simulation
+///     server holds the next command table until each SST has sent DONE.
+///     OP_DONE carries the version in its value field.
+///
+///     STATS answers with one line of name=value pairs that describe the
+///     load on the interface, such as the lock waits of the device tables.
+///     It is only available in the text protocol.
+///
+///     Each accepted client is served by its own CLineSession, so several
+///     brokers and monitoring tools can use the same port at once.
+///
 /// @limitations
 ///     none
 ///
@@ -64,11 +97,28 @@ namespace simulation {
 class CLineServer : private boost::noncopyable
 {
 public:
-    typedef boost::function< void ( const std::string &, const std::string &, const std::string & ) > TSetCallback;
-    typedef boost::function< std::string ( const std::string &, const std::string & ) > TGetCallback;
+    typedef boost::function< boost::uint32_t ( const std::string &, const std::string & ) > TResolveCallback;
+    typedef boost::function< void ( boost::uint32_t, double ) > TSetCallback;
+    typedef boost::function< double ( boost::uint32_t ) > TGetCallback;
+    typedef boost::function< void ( boost::uint64_t ) > TStepCallback;
+    typedef boost::function< void ( boost::uint64_t, TStepCallback ) > TWaitCallback;
+    typedef boost::function< void ( boost::uint64_t ) > TDoneCallback;
+    typedef boost::function< std::string () > TStatsCallback;
     typedef boost::shared_ptr<CLineServer> TPointer;
+    typedef boost::shared_ptr<CLineSession> TSessionPointer;
+    
+    /// size in bytes of a binary frame without its payload
+    static const size_t FRAME_SIZE = 16;
     
-    static TPointer Create( boost::asio::io_service & p_service, unsigned short p_port, TSetCallback p_set, TGetCallback p_get );
+    /// binary frame request types
+    enum EOpcode { OP_RESOLVE = 1, OP_GET = 2, OP_SET = 3, OP_QUIT = 4, OP_WAIT = 5, OP_DONE = 6 };
+    
+    /// binary frame response codes
+    enum EStatus { STATUS_OK = 0, STATUS_NOTFOUND = 1, STATUS_BADREQUEST = 2 };
+    
+    static TPointer Create( boost::asio::io_service & p_service, unsigned short p_port,
+        TResolveCallback p_resolve, TSetCallback p_set, TGetCallback p_get,
+        TWaitCallback p_wait, TDoneCallback p_done, TStatsCallback p_stats );
     
     ////////////////////////////////////////////////////////////////////////////
     /// ~CLineServer
@@ -87,7 +137,6 @@ public:
     ///
     /// @post
     ///     m_acceptor is closed
-    ///     m_socket is closed
     ///
     /// @limitations
     ///     none
@@ -96,7 +145,7 @@ public:
     ~CLineServer();
 private:
     ////////////////////////////////////////////////////////////////////////////
-    /// CLineServer( io_service &, unsigned short, TGetCallback, TSetCallback )
+    /// CLineServer( io_service &, unsigned short, TResolveCallback, TSetCallback, TGetCallback, TWaitCallback, TDoneCallback, TStatsCallback )
     ///
     /// @description
     ///     Creates a line protocol server using the given callback functions.
@@ -111,27 +160,37 @@ private:
     ///     none
     ///
     /// @post
-    ///     io_service is shared with m_acceptor and m_socket
-    ///     connections to m_acceptor are redirected to MessageHandler
+    ///     io_service is shared with m_acceptor and each session
+    ///     connections to m_acceptor are redirected to HandleAccept
     ///
     /// @param
-    ///     p_service is the io_service the acceptor and socket run on
+    ///     p_service is the io_service the acceptor and sessions run on
     ///     p_port is the port the acceptor listens on
+    ///     p_resolve is the function that converts a (Device,Key) to a handle
     ///     p_set is the function called for SET requests
     ///     p_get is the function called for GET requests
+    ///     p_wait is the function called for WAIT requests
+    ///     p_done is the function called for DONE requests
+    ///     p_stats is the function called for STATS requests
     ///
     /// @limitations
-    ///     p_set : void ( const string &, const string &, const string & )
-    ///     p_get : string ( const string &, const string & )
+    ///     p_resolve : uint32_t ( const string &, const string & )
+    ///     p_set : void ( uint32_t, double )
+    ///     p_get : double ( uint32_t )
+    ///     p_wait : void ( uint64_t, TStepCallback )
+    ///     p_done : void ( uint64_t )
+    ///     p_stats : string ()
     ///
     ////////////////////////////////////////////////////////////////////////////
-    CLineServer( boost::asio::io_service & p_service, unsigned short p_port, TSetCallback p_set, TGetCallback p_get );
+    CLineServer( boost::asio::io_service & p_service, unsigned short p_port,
+        TResolveCallback p_resolve, TSetCallback p_set, TGetCallback p_get,
+        TWaitCallback p_wait, TDoneCallback p_done, TStatsCallback p_stats );
     
     ////////////////////////////////////////////////////////////////////////////
     /// StartAccept
     ///
     /// @description
-    ///     Waits for a client connection and redirects it to MessageHandler.
+    ///     Waits for a client connection and redirects it to HandleAccept.
     ///
     /// @Shared_Memory
     ///     none
@@ -140,10 +199,10 @@ private:
     ///     none
     ///
     /// @pre
-    ///     m_socket is closed
+    ///     none
     ///
     /// @post
-    ///     m_socket set to the new client connection
+    ///     an asynchronous accept into a new session is pending
     ///
     /// @limitations
     ///     none
@@ -152,38 +211,42 @@ private:
     void StartAccept();
     
     ////////////////////////////////////////////////////////////////////////////
-    /// MessageHandler
+    /// HandleAccept( TSessionPointer, const error_code & )
     ///
     /// @description
-    ///     Handles all messages from a client until QUIT is received.
+    ///     Starts the session of an accepted client and waits for the next.
     ///
     /// @Shared_Memory
     ///     none
     ///
     /// @Error_Handling
-    ///     Terminates the client connection if an exception occurs.
+    ///     Discards the session if the accept failed.
     ///
     /// @pre
-    ///     m_socket is an open connection
+    ///     none
     ///
     /// @post
-    ///     read and write operations occur over m_socket
-    ///     m_socket is closed when the function returns
+    ///     p_session serves its client until it disconnects
+    ///     another asynchronous accept is pending on m_acceptor
     ///
     /// @param
+    ///     p_session is the session that owns the accepted socket
     ///     p_error is an error code set on accept failure
     ///
     /// @limitations
     ///     none
     ///
     ////////////////////////////////////////////////////////////////////////////
-    void MessageHandler( const boost::system::error_code & p_error );
+    void HandleAccept( TSessionPointer p_session, const boost::system::error_code & p_error );
+    
+    /// service shared with each session
+    boost::asio::io_service & m_service;
     
     /// entry queue for client connections
     boost::asio::ip::tcp::acceptor m_acceptor;
     
-    /// socket to line procotol client
-    boost::asio::ip::tcp::socket m_socket;
+    /// resolve callback function
+    TResolveCallback m_resolve;
     
     /// set callback function
     TSetCallback m_set;
@@ -191,6 +254,15 @@ private:
     /// get callback function
     TGetCallback m_get;
     
+    /// wait callback function
+    TWaitCallback m_wait;
+    
+    /// done callback function
+    TDoneCallback m_done;
+    
+    /// stats callback function
+    TStatsCallback m_stats;
+    
     /// port number for debug output
     unsigned short m_port;
 };
@@ -0,0 +1,331 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CLineSession.hpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @description
+///     One client connection to a simulation line server.
+///
+/// @functions
+///     Create( io_service &, unsigned short, TResolveCallback, TSetCallback, TGetCallback )
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_LINE_SESSION_HPP
+#define C_LINE_SESSION_HPP
+
+#include <string>
+#include <cstring>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/asio.hpp>
+#include <boost/array.hpp>
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/utility.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/enable_shared_from_this.hpp>
+
+#include "logger.hpp"
+#include "CLineServer.hpp"
+#include "CTraceRing.hpp"
+
+CREATE_EXTERN_STD_LOGS()
+
+namespace freedm {
+namespace simulation {
+
+////////////////////////////////////////////////////////////////////////////////
+/// CLineSession
+///
+/// @description
+///     Serves the line protocol for a single accepted client. Every read and
+///     write is asynchronous, so a session never holds the io_service thread
+///     while it waits on its client and any number of sessions can share it.
+///     Each pending operation holds a shared pointer to the session, which is
+///     destroyed once the client disconnects.
+///
+/// @limitations
+///     A session has at most one operation pending, so its handlers never run
+///     concurrently even on an io_service run by several threads.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CLineSession
+    : public boost::enable_shared_from_this<CLineSession>
+    , private boost::noncopyable
+{
+public:
+    typedef boost::shared_ptr<CLineSession> TPointer;
+    
+    static TPointer Create( boost::asio::io_service & p_service, unsigned short p_port,
+        CLineServer::TResolveCallback p_resolve, CLineServer::TSetCallback p_set,
+        CLineServer::TGetCallback p_get, CLineServer::TWaitCallback p_wait,
+        CLineServer::TDoneCallback p_done, CLineServer::TStatsCallback p_stats );
+    
+    /// socket the line server accepts the client on
+    boost::asio::ip::tcp::socket & Socket() { return m_socket; }
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// Start
+    ///
+    /// @description
+    ///     Begins to read text requests from the accepted client.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     m_socket is an open connection
+    ///
+    /// @post
+    ///     an asynchronous read is pending on m_socket
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void Start();
+private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// CLineSession( io_service &, unsigned short, TResolveCallback, TSetCallback, TGetCallback, TWaitCallback, TDoneCallback, TStatsCallback )
+    ///
+    /// @description
+    ///     Creates an unconnected session that uses the given callbacks.
+    ///
+    /// @Shared_Memory
+    ///     Uses the passed io_service until destroyed.
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     io_service is shared with m_socket
+    ///
+    /// @param
+    ///     p_service is the io_service the socket runs on
+    ///     p_port is the server port for debug output
+    ///     p_resolve is the function that converts a (Device,Key) to a handle
+    ///     p_set is the function called for SET requests
+    ///     p_get is the function called for GET requests
+    ///     p_wait is the function called for WAIT requests
+    ///     p_done is the function called for DONE requests
+    ///     p_stats is the function called for STATS requests
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    CLineSession( boost::asio::io_service & p_service, unsigned short p_port,
+        CLineServer::TResolveCallback p_resolve, CLineServer::TSetCallback p_set,
+        CLineServer::TGetCallback p_get, CLineServer::TWaitCallback p_wait,
+        CLineServer::TDoneCallback p_done, CLineServer::TStatsCallback p_stats );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// HandleLine( const error_code & )
+    ///
+    /// @description
+    ///     Answers one text request and writes the response to the client.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Closes the connection if the read failed or the request throws.
+    ///
+    /// @pre
+    ///     m_request holds a complete line
+    ///
+    /// @post
+    ///     the line is removed from m_request
+    ///     an asynchronous write of the response is pending on m_socket
+    ///
+    /// @param
+    ///     p_error is an error code set on read failure
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void HandleLine( const boost::system::error_code & p_error );
+    
+    /// continues after a text response has been written
+    void HandleLineWritten( const boost::system::error_code & p_error );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// ReadFrame( const error_code & )
+    ///
+    /// @description
+    ///     Reads until m_request holds a complete binary frame, then calls
+    ///     HandleFrame. Used as its own completion handler.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Closes the connection if the read failed.
+    ///
+    /// @pre
+    ///     the client has negotiated binary framing on m_socket
+    ///
+    /// @post
+    ///     an asynchronous read is pending or the frame has been handled
+    ///
+    /// @param
+    ///     p_error is an error code set on read failure
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void ReadFrame( const boost::system::error_code & p_error );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// HandleFrame
+    ///
+    /// @description
+    ///     Answers one binary frame and writes the response frame.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Requests that fail are answered with an error status.
+    ///
+    /// @pre
+    ///     m_request holds a complete frame and its payload
+    ///
+    /// @post
+    ///     the frame and its payload are removed from m_request
+    ///     an asynchronous write of the response is pending on m_socket
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void HandleFrame();
+    
+    /// continues after a response frame has been written
+    void HandleFrameWritten( const boost::system::error_code & p_error );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// StartWait( uint64_t )
+    ///
+    /// @description
+    ///     Defers the response to a WAIT request until a step newer than the
+    ///     given version has been published.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     no response is in progress
+    ///
+    /// @post
+    ///     HandleStep is posted to m_service once the step is published
+    ///
+    /// @param
+    ///     p_version is the last step version seen by the client
+    ///
+    /// @limitations
+    ///     The client socket is not read while the session waits, so a client
+    ///     that disconnects is only noticed after the next step.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void StartWait( boost::uint64_t p_version );
+    
+    /// posts HandleStep from the thread that published the step
+    void NotifyStep( boost::uint64_t p_version );
+    
+    /// writes the response to a completed WAIT request
+    void HandleStep( boost::uint64_t p_version );
+    
+    /// closes the connection, which ends the session
+    void Close();
+    
+    /// serializes a binary frame header and value into p_frame
+    static void PackFrame( unsigned char * p_frame, unsigned char p_opcode,
+        unsigned char p_status, boost::uint16_t p_length,
+        boost::uint32_t p_handle, double p_value );
+    
+    /// reads a big-endian integer of p_bytes bytes
+    static boost::uint64_t UnpackInteger( const unsigned char * p_data, size_t p_bytes );
+    
+    /// writes a big-endian integer of p_bytes bytes
+    static void PackInteger( unsigned char * p_data, boost::uint64_t p_value, size_t p_bytes );
+    
+    /// the session states that follow a written response
+    enum EState { STATE_TEXT, STATE_BINARY, STATE_QUIT };
+    
+    /// service that runs the session handlers
+    boost::asio::io_service & m_service;
+    
+    /// socket to line protocol client
+    boost::asio::ip::tcp::socket m_socket;
+    
+    /// bytes received from the client and not yet handled
+    boost::asio::streambuf m_request;
+    
+    /// text response in progress
+    boost::asio::streambuf m_response;
+    
+    /// binary response in progress
+    boost::array<unsigned char, CLineServer::FRAME_SIZE> m_frame;
+    
+    /// state to enter once the current response is written
+    EState m_state;
+    
+    /// resolve callback function
+    CLineServer::TResolveCallback m_resolve;
+    
+    /// set callback function
+    CLineServer::TSetCallback m_set;
+    
+    /// get callback function
+    CLineServer::TGetCallback m_get;
+    
+    /// wait callback function
+    CLineServer::TWaitCallback m_wait;
+    
+    /// done callback function
+    CLineServer::TDoneCallback m_done;
+    
+    /// stats callback function
+    CLineServer::TStatsCallback m_stats;
+    
+    /// port number for debug output
+    unsigned short m_port;
+};
+
+} // namespace simulation
+} // namespace freedm
+
+#endif // C_LINE_SESSION_HPP
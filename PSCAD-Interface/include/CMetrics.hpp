@@ -0,0 +1,234 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CMetrics.hpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+///     Counters and histograms that describe the load on the server.
+///
+/// @functions
+///     CCounter::Increment( uint64_t )
+///     CHistogram::Record( uint64_t )
+///     CHistogram::RecordElapsed( const ptime & )
+///     CMetrics::Add( const string &, const CCounter & )
+///     CMetrics::Add( const string &, const CHistogram & )
+///     CMetrics::Format()
+///
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_METRICS_HPP
+#define C_METRICS_HPP
+
+#include <map>
+#include <string>
+
+#include <boost/cstdint.hpp>
+#include <boost/utility.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace freedm {
+namespace simulation {
+
+////////////////////////////////////////////////////////////////////////////////
+/// CCounter
+///
+/// @description
+///     Event count that any thread may increment without a lock.
+///
+/// @limitations
+///     Uses the GCC atomic builtins.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CCounter : private boost::noncopyable
+{
+public:
+    CCounter() : m_value(0) {}
+    
+    /// adds p_amount to the count
+    void Increment( boost::uint64_t p_amount = 1 )
+    {
+        __sync_fetch_and_add( &m_value, p_amount );
+    }
+    
+    /// returns the count
+    boost::uint64_t Get() const
+    {
+        return __sync_fetch_and_add( const_cast<boost::uint64_t *>(&m_value), 0 );
+    }
+private:
+    /// number of events counted
+    boost::uint64_t m_value;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// CHistogram
+///
+/// @description
+///     Distribution of values that any thread may record without a lock.
+///     Values are counted in power of two buckets, so bucket b holds the
+///     values that need b bits. A percentile is reported as the upper bound
+///     of the bucket it falls in, which is at most twice the true value.
+///
+/// @limitations
+///     Uses the GCC atomic builtins. A histogram read while values are
+///     recorded may be off by the values in flight.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CHistogram : private boost::noncopyable
+{
+public:
+    /// one bucket per bit of a recorded value, and one for zero
+    static const size_t BUCKETS = 65;
+    
+    CHistogram();
+    
+    /// counts one value
+    void Record( boost::uint64_t p_value );
+    
+    /// counts the microseconds since p_start
+    void RecordElapsed( const boost::posix_time::ptime & p_start );
+    
+    /// returns the number of values recorded
+    boost::uint64_t GetCount() const;
+    
+    /// returns the sum of the values recorded
+    boost::uint64_t GetSum() const;
+    
+    /// returns the largest value recorded
+    boost::uint64_t GetMax() const;
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// GetPercentile( double ) const
+    ///
+    /// @description
+    ///     Returns an upper bound of the given percentile of the values.
+    ///
+    /// @Shared_Memory
+    ///     m_buckets is read
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     none
+    ///
+    /// @param
+    ///     p_fraction is the percentile as a fraction, such as 0.99
+    ///
+    /// @return
+    ///     the largest value of the bucket that holds the percentile, no more
+    ///     than GetMax, or 0 if no value has been recorded
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    boost::uint64_t GetPercentile( double p_fraction ) const;
+private:
+    /// number of values recorded in each bucket
+    boost::uint64_t m_buckets[BUCKETS];
+    
+    /// number of values recorded
+    boost::uint64_t m_count;
+    
+    /// sum of the values recorded
+    boost::uint64_t m_sum;
+    
+    /// largest value recorded
+    boost::uint64_t m_max;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// CMetrics
+///
+/// @description
+///     Names the counters and histograms of the server so they can be read
+///     as one line of name=value pairs. Each metric is owned by the object it
+///     describes and is only referenced here, so recording a value never
+///     touches the registry.
+///
+///     A counter is formatted as name=count. A histogram is formatted as
+///     name_count, name_sum, name_p50, name_p99 and name_max.
+///
+/// @limitations
+///     Every metric must outlive the registry. Metrics should be added
+///     before other threads call Format.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CMetrics : private boost::noncopyable
+{
+public:
+    /// starts the uptime that Format reports
+    CMetrics();
+    
+    /// names a counter
+    void Add( const std::string & p_name, const CCounter & p_counter );
+    
+    /// names a histogram
+    void Add( const std::string & p_name, const CHistogram & p_histogram );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// Format
+    ///
+    /// @description
+    ///     Describes the uptime and every named metric in name order.
+    ///
+    /// @Shared_Memory
+    ///     every named metric is read
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     m_mutex is obtained while the names are read
+    ///
+    /// @return
+    ///     space separated name=value pairs, starting with uptime_s
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    std::string Format();
+private:
+    /// protects m_counters and m_histograms
+    boost::mutex m_mutex;
+    
+    /// time the registry was created
+    boost::posix_time::ptime m_start;
+    
+    /// named counters
+    std::map<std::string, const CCounter *> m_counters;
+    
+    /// named histograms
+    std::map<std::string, const CHistogram *> m_histograms;
+};
+
+} // namespace simulation
+} // namespace freedm
+
+#endif // C_METRICS_HPP
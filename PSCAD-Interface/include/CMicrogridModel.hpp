@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CMicrogridModel.hpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @description
+///     Power balance model that stands in for the simulation.
+///
+/// @functions
+///     CMicrogridModel( const CTableStructure &, const CTableStructure &, double )
+///
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_MICROGRID_MODEL_HPP
+#define C_MICROGRID_MODEL_HPP
+
+#include <map>
+#include <cmath>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include <boost/utility.hpp>
+
+#include "logger.hpp"
+#include "CDeviceKey.hpp"
+#include "CTableStructure.hpp"
+
+CREATE_EXTERN_STD_LOGS()
+
+namespace freedm {
+namespace simulation {
+
+////////////////////////////////////////////////////////////////////////////////
+/// CMicrogridModel
+///
+/// @description
+///     A simple power balance model of the devices in the state table. The
+///     type of a device is its name up to the first digit or underscore: pv,
+///     load, dg, battery or grid. Devices are grouped into one bus
+///     per parent SST, and each step
+///
+///     1.  pv, load and dg devices produce or consume power if switched on,
+///         the pv and load following a compressed day of DAY_LENGTH seconds
+///     2.  battery devices cover the remaining imbalance of their bus within
+///         their rating, charging on a surplus, and track their charge
+///     3.  grid devices import what is left if their breaker is closed
+///
+///     Each device writes its power to its powerLevel state entry, and a
+///     battery writes its charge to a stateOfCharge entry if the table has
+///     one. A device is switched on while its onOffSwitch command entry is 0,
+///     which matches the initial command table of the simulation server.
+///
+///     The devices are compiled into flat arrays once, so a step is a few
+///     passes over contiguous memory without any name lookups.
+///
+/// @limitations
+///     Generation reports positive power and so does consumption. The model
+///     does not shed load, so an islanded bus may stay unbalanced.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CMicrogridModel : private boost::noncopyable
+{
+public:
+    /// seconds of model time in one simulated day
+    static const double DAY_LENGTH;
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// CMicrogridModel( const CTableStructure &, const CTableStructure &, double )
+    ///
+    /// @description
+    ///     Compiles the devices of the state table into the model.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Throws std::invalid_argument if p_step is not positive.
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     every state entry of a known device type is part of the model
+    ///
+    /// @param
+    ///     p_state is the structure of the state table
+    ///     p_command is the structure of the command table
+    ///     p_step is the model time of one step in seconds
+    ///
+    /// @limitations
+    ///     State entries of unknown device types or keys are never written.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    CMicrogridModel( const CTableStructure & p_state, const CTableStructure & p_command,
+        double p_step );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// Step( const double *, double * )
+    ///
+    /// @description
+    ///     Advances the model by one step.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     p_command and p_state have the length of their table structures
+    ///
+    /// @post
+    ///     every state entry of the model is written to p_state
+    ///
+    /// @param
+    ///     p_command is the command table to apply
+    ///     p_state is the state table to write
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void Step( const double * p_command, double * p_state );
+    
+    /// returns the number of devices in the model
+    size_t GetDeviceCount() const;
+private:
+    /// types of simulated device
+    enum EType { TYPE_PV, TYPE_LOAD, TYPE_DG, TYPE_BATTERY, TYPE_GRID };
+    
+    /// one simulated device
+    struct SDevice
+    {
+        EType m_type;
+        size_t m_bus;
+        size_t m_power;
+        size_t m_charge;
+        size_t m_switch;
+        double m_rating;
+        double m_phase;
+        double m_charged;
+    };
+    
+    /// marks a device without an entry in one of the tables
+    static const size_t NO_ENTRY = static_cast<size_t>(-1);
+    
+    /// true if the switch of p_device is on in p_command
+    static bool IsOn( const SDevice & p_device, const double * p_command );
+    
+    /// devices that produce or consume power on their own
+    std::vector<SDevice> m_sources;
+    
+    /// batteries that balance their bus
+    std::vector<SDevice> m_storage;
+    
+    /// grid links that take the rest of the imbalance
+    std::vector<SDevice> m_links;
+    
+    /// demand not yet covered on each bus, indexed by parent SST
+    std::vector<double> m_demand;
+    
+    /// model time of one step
+    double m_step;
+    
+    /// model time since the first step
+    double m_time;
+};
+
+} // namespace simulation
+} // namespace freedm
+
+#endif // C_MICROGRID_MODEL_HPP
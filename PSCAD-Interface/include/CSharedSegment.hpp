@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CSharedSegment.hpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @description
+///     Shared memory segment for same-host exchanges with the simulation.
+///
+/// @functions
+///     CSharedSegment( const string &, size_t, size_t )
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_SHARED_SEGMENT_HPP
+#define C_SHARED_SEGMENT_HPP
+
+#include <string>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <boost/utility.hpp>
+
+#include "logger.hpp"
+#include "pscad_shm.h"
+
+CREATE_EXTERN_STD_LOGS()
+
+namespace freedm {
+namespace simulation {
+
+////////////////////////////////////////////////////////////////////////////////
+/// CSharedSegment
+///
+/// @description
+///     Owns the POSIX shared memory segment described in pscad_shm.h. The
+///     simulation writes its state table into the segment and reads its
+///     command table from it, so a simulation on the same host needs no
+///     socket exchange.
+///
+/// @limitations
+///     Linux only, since the segment relies on futex signaling.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CSharedSegment : private boost::noncopyable
+{
+public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// CSharedSegment( const string &, size_t, size_t )
+    ///
+    /// @description
+    ///     Creates and maps a segment sized for the given tables.
+    ///
+    /// @Shared_Memory
+    ///     the segment is shared with any process that opens p_name
+    ///
+    /// @Error_Handling
+    ///     Throws std::runtime_error if the segment cannot be created.
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     m_header points to an initialized segment with zeroed tables
+    ///
+    /// @param
+    ///     p_name is the shm_open name of the segment, such as /freedm
+    ///     p_state is the number of entries in the state table
+    ///     p_command is the number of entries in the command table
+    ///
+    /// @limitations
+    ///     An existing segment of the same name is replaced.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    CSharedSegment( const std::string & p_name, size_t p_state, size_t p_command );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// ~CSharedSegment
+    ///
+    /// @description
+    ///     Unmaps and removes the segment.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     the segment name is unlinked
+    ///
+    /// @limitations
+    ///     A simulation that still maps the segment keeps its mapping.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    ~CSharedSegment();
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// WaitForState( unsigned int, long )
+    ///
+    /// @description
+    ///     Sleeps until the simulation publishes a new state table.
+    ///
+    /// @Shared_Memory
+    ///     the state counter of the segment is read
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     none
+    ///
+    /// @param
+    ///     p_seen is the state counter of the last table read
+    ///     p_usec is the longest time to sleep in microseconds
+    ///
+    /// @return
+    ///     true if the state counter differs from p_seen
+    ///
+    /// @limitations
+    ///     May return early on a spurious wakeup.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    bool WaitForState( unsigned int p_seen, long p_usec );
+    
+    /// copies a consistent state table, returns its counter
+    unsigned int ReadState( double * p_state );
+    
+    /// publishes a command table to the simulation
+    void WriteCommand( const double * p_command );
+private:
+    /// name of the segment
+    std::string m_name;
+    
+    /// size of the mapping in bytes
+    size_t m_size;
+    
+    /// start of the mapping
+    pscad_shm_header * m_header;
+};
+
+} // namespace simulation
+} // namespace freedm
+
+#endif // C_SHARED_SEGMENT_HPP
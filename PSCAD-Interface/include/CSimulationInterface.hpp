@@ -31,18 +31,25 @@
 #ifndef C_SIMULATION_INTERFACE_CPP
 #define C_SIMULATION_INTERFACE_CPP
 
+#include <map>
 #include <string>
+#include <vector>
+#include <sstream>
 #include <iostream>
+#include <stdexcept>
 
 #include <boost/ref.hpp>
 #include <boost/asio.hpp>
 #include <boost/utility.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include "logger.hpp"
 #include "CLineServer.hpp"
 #include "CDeviceTable.hpp"
+#include "CStepBarrier.hpp"
+#include "CMetrics.hpp"
 
 CREATE_EXTERN_STD_LOGS()
 
@@ -58,6 +65,10 @@ namespace simulation {
 ///     the simulation server and contains a line server that accepts requests
 ///     from cyber control algorithms.
 ///
+///     Access rights are resolved once at construction. Each device variable
+///     the interface may read or write is given a handle that stores its
+///     entry in both tables, so requests by handle index the tables directly.
+///
 /// @limitations
 ///     none
 ///
@@ -68,16 +79,18 @@ public:
     typedef boost::shared_ptr<CSimulationInterface> TPointer;
     
     static TPointer Create( boost::asio::io_service & p_service, CDeviceTable & p_command,
-        CDeviceTable & p_state, unsigned short p_port, size_t p_index );
+        CDeviceTable & p_state, CStepBarrier & p_barrier, CMetrics & p_metrics,
+        unsigned short p_port, size_t p_index );
 private:
     ////////////////////////////////////////////////////////////////////////////
-    /// CSimulationInterface( io_service &, CDeviceTable &, CDeviceTable &, unsigned short, size_t )
+    /// CSimulationInterface( io_service &, CDeviceTable &, CDeviceTable &, CStepBarrier &, CMetrics &, unsigned short, size_t )
     ///
     /// @description
     ///     Creates a simulation interface using the given port number.
     ///
     /// @Shared_Memory
-    ///     Uses the passed io_service and CDeviceTable until destroyed.
+    ///     Uses the passed io_service, CDeviceTable, CStepBarrier and CMetrics
+    ///     until destroyed.
     ///
     /// @Error_Handling
     ///     none
@@ -87,11 +100,15 @@ private:
     ///
     /// @post
     ///     creates a new reference to a CLineServer on p_port
+    ///     m_handles holds each device variable p_index may access
+    ///     the request counters are named in p_metrics
     ///
     /// @param
     ///     p_service is the io_service the line server runs on
     ///     p_command is the device command table maintained by the server
     ///     p_state is the device state table maintained by the server
+    ///     p_barrier collects the step acknowledgements of the interface
+    ///     p_metrics names the metrics of the server
     ///     p_port is the port the line server listens on
     ///     p_index is the interface unique identifier
     ///
@@ -100,10 +117,43 @@ private:
     ///
     ////////////////////////////////////////////////////////////////////////////
     CSimulationInterface( boost::asio::io_service & p_service, CDeviceTable & p_command,
-        CDeviceTable & p_state, unsigned short p_port, size_t p_index );
+        CDeviceTable & p_state, CStepBarrier & p_barrier, CMetrics & p_metrics,
+        unsigned short p_port, size_t p_index );
     
     ////////////////////////////////////////////////////////////////////////////
-    /// Set( const string &, const string &, const string & )
+    /// Resolve( const string &, const string & )
+    ///
+    /// @description
+    ///     Returns the handle of a device variable for use with Get and Set.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Throws std::out_of_range if m_index has no access to the variable
+    ///     in either table.
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     none
+    ///
+    /// @param
+    ///     p_device is the device identifier to resolve
+    ///     p_key is the device variable to resolve
+    ///
+    /// @return
+    ///     handle of (p_device,p_key) in m_handles
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    boost::uint32_t Resolve( const std::string & p_device, const std::string & p_key );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// Set( uint32_t, double )
     ///
     /// @description
     ///     Modifies a value in the command table.
@@ -112,57 +162,106 @@ private:
     ///     m_command is accessed and modified
     ///
     /// @Error_Handling
-    ///     none
+    ///     Throws std::out_of_range if the handle does not refer to a command
+    ///     table entry that m_index may access.
     ///
     /// @pre
-    ///     (p_device,p_key) is in m_command
-    ///     m_index has access to (p_device,p_key)
+    ///     p_handle was returned by Resolve
     ///
     /// @post
-    ///     (p_device,p_key) in m_command is set to p_value
+    ///     the m_command entry of p_handle is set to p_value
     ///
     /// @param
-    ///     p_device is the device identifier to modify
-    ///     p_key is the device variable to modify
+    ///     p_handle is the device variable to modify
     ///     p_value is the value to set
     ///
     /// @limitations
     ///     none
     ///
     ////////////////////////////////////////////////////////////////////////////
-    void Set( const std::string & p_device, const std::string & p_key, const std::string & p_value );
+    void Set( boost::uint32_t p_handle, double p_value );
     
     ////////////////////////////////////////////////////////////////////////////
-    /// Get( const string &, const string & )
+    /// Get( uint32_t )
     ///
     /// @description
-    ///     Returns a value from the command table.
+    ///     Returns a value from the state table.
     ///
     /// @Shared_Memory
     ///     m_state is accessed
     ///
     /// @Error_Handling
-    ///     none
+    ///     Throws std::out_of_range if the handle does not refer to a state
+    ///     table entry that m_index may access.
     ///
     /// @pre
-    ///     (p_device,p_key) is in m_state
-    ///     m_index has access to (p_device,p_key)
+    ///     p_handle was returned by Resolve
     ///
     /// @post
     ///     none
     ///
     /// @param
-    ///     p_device is the device identifier to retrieve
-    ///     p_key is the device variable to retrieve
+    ///     p_handle is the device variable to retrieve
     ///
     /// @return
-    ///     stored value for (p_device,p_key) in m_state
+    ///     stored value of the m_state entry of p_handle
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    double Get( boost::uint32_t p_handle );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// Wait( uint64_t, TStepCallback )
+    ///
+    /// @description
+    ///     Calls p_callback once the state table has a step newer than the
+    ///     given version.
+    ///
+    /// @Shared_Memory
+    ///     m_state is accessed
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     p_callback is registered with m_state
+    ///
+    /// @param
+    ///     p_version is the last step version seen by the client
+    ///     p_callback receives the version of the newer step
     ///
     /// @limitations
     ///     none
     ///
     ////////////////////////////////////////////////////////////////////////////
-    std::string Get( const std::string & p_device, const std::string & p_key );
+    void Wait( boost::uint64_t p_version, CLineServer::TStepCallback p_callback );
+    
+    /// acknowledges that the client has finished with a state table version
+    void Done( boost::uint64_t p_version );
+    
+    /// describes every metric of the server for a STATS request
+    std::string Stats();
+    
+    /// table entries of a device variable, NO_ENTRY if inaccessible
+    struct SHandle
+    {
+        size_t m_state;
+        size_t m_command;
+    };
+    
+    /// marks a handle without an entry in one of the tables
+    static const size_t NO_ENTRY = static_cast<size_t>(-1);
+    
+    /// device variables m_index may access, indexed by handle
+    std::vector<SHandle> m_handles;
+    
+    /// handle of each device variable in m_handles
+    std::map<CDeviceKey, boost::uint32_t> m_names;
 
     /// line server for cyber control requests
     CLineServer::TPointer m_server;
@@ -173,6 +272,18 @@ private:
     /// device state table
     CDeviceTable & m_state;
     
+    /// lockstep barrier shared with the server
+    CStepBarrier & m_barrier;
+    
+    /// metrics of the server
+    CMetrics & m_metrics;
+    
+    /// requests served by the interface
+    CCounter m_gets;
+    CCounter m_sets;
+    CCounter m_waits;
+    CCounter m_dones;
+    
     /// unique identifier
     size_t m_index;
 };
@@ -34,19 +34,27 @@
 
 #include <list>
 #include <string>
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/utility.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
 
 #include "logger.hpp"
 #include "CDeviceTable.hpp"
+#include "CTableLayout.hpp"
+#include "CStepBarrier.hpp"
+#include "CExchangeLog.hpp"
+#include "CMicrogridModel.hpp"
+#include "CSharedSegment.hpp"
 #include "CSimulationInterface.hpp"
 
 CREATE_EXTERN_STD_LOGS()
@@ -54,6 +62,65 @@ CREATE_EXTERN_STD_LOGS()
 namespace freedm {
 namespace simulation {
 
+////////////////////////////////////////////////////////////////////////////////
+/// SServerOptions
+///
+/// @description
+///     Settings of a simulation server, filled from the driver command line.
+///
+/// @limitations
+///     none
+///
+////////////////////////////////////////////////////////////////////////////////
+struct SServerOptions
+{
+    SServerOptions() : m_xml("xml"), m_layoutCache("xml.layout"), m_port(4000), m_sharedPoll(1000)
+        , m_lockstep(false), m_lockstepTimeout(1000), m_replayFast(false)
+        , m_replayDelay(0), m_model(false), m_modelRate(1000.0), m_statsPeriod(0) {}
+    
+    // filename of the XML table specification
+    std::string m_xml;
+    
+    // compiled table layout of m_xml, empty to parse m_xml on every start
+    std::string m_layoutCache;
+    
+    // port for the simulation, interface i listens on m_port+i
+    unsigned short m_port;
+    
+    // shared memory segment name, empty to exchange over TCP only
+    std::string m_shm;
+    
+    // longest wait in microseconds between command table updates in m_shm
+    long m_sharedPoll;
+    
+    // hold each command table read until the SSTs finish the last step
+    bool m_lockstep;
+    
+    // longest wait in milliseconds for the SSTs in lockstep mode
+    long m_lockstepTimeout;
+    
+    // exchange log to record into, empty to record nothing
+    std::string m_record;
+    
+    // exchange log to replay in place of the simulation, empty for none
+    std::string m_replay;
+    
+    // replay the state tables without their recorded delays
+    bool m_replayFast;
+    
+    // milliseconds to let the brokers connect before the replay starts
+    long m_replayDelay;
+    
+    // run the built-in microgrid model in place of the simulation
+    bool m_model;
+    
+    // model steps per second, 0 to step as fast as possible
+    double m_modelRate;
+    
+    // seconds between logged metrics, 0 to log none
+    long m_statsPeriod;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// CSimulationServer
 ///
@@ -63,6 +130,11 @@ namespace simulation {
 ///     power simulation and a command table of settings to issue to the
 ///     simulation. These tables are shared with each cyber interface.
 ///
+///     In lockstep mode the command table is only released to the simulation
+///     once every registered SST has acknowledged the last published state
+///     table, so each step of a run sees the commands computed from the step
+///     before it.
+///
 /// @limitations
 ///     none
 ///
@@ -71,7 +143,7 @@ class CSimulationServer : private boost::noncopyable
 {
 public:
     ////////////////////////////////////////////////////////////////////////////
-    /// CSimulationServer( const string &, unsigned short )
+    /// CSimulationServer( const SServerOptions & )
     ///
     /// @description
     ///     Creates the simulation server and starts the cyber interfaces.
@@ -83,21 +155,26 @@ public:
     ///     An exception will be thrown if the given XML file has a bad format.
     ///
     /// @pre
-    ///     p_xml has tags for 'command' and 'state'
+    ///     p_options.m_xml has tags for 'command' and 'state'
     ///
     /// @post
     ///     m_interface is populated with cyber interfaces
     ///     simulation thread is created on CSimulationServer::Run()
+    ///     shared memory thread is created if p_options.m_shm is set
+    ///     replay thread replaces both if p_options.m_replay is set
+    ///     model thread replaces both if p_options.m_model is set
+    ///     stats thread is created if p_options.m_statsPeriod is set
+    ///     m_service is run by one thread per processor until stopped
     ///
     /// @param
-    ///     p_xml is the filename of the XML input
-    ///     p_port is the port the simulation connects to
+    ///     p_options holds the XML input, the ports and the shared memory name
     ///
     /// @limitations
-    ///     none
+    ///     Blocks until Stop is called. The cyber interfaces share the thread
+    ///     pool, while the simulation exchange keeps its own threads.
     ///
     ////////////////////////////////////////////////////////////////////////////
-    CSimulationServer( const std::string & p_xml, unsigned short p_port );
+    CSimulationServer( const SServerOptions & p_options );
     
     ////////////////////////////////////////////////////////////////////////////
     /// ~CSimulationServer
@@ -148,19 +225,21 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     void Stop();
 private:
+    /// shared handle to a simulation session socket
+    typedef boost::shared_ptr<boost::asio::ip::tcp::socket> TSocket;
+    
     ////////////////////////////////////////////////////////////////////////////
     /// Run
     ///
     /// @description
-    ///     Message handler for the simulation server.
+    ///     Accepts connections from the simulation and starts a session thread
+    ///     for each of them.
     ///
     /// @Shared_Memory
-    ///     m_command and m_state are accessed and modifier
-    ///     private members of each element in m_interface are accessed
+    ///     a detached thread is started for each accepted connection
     ///
     /// @Error_Handling
-    ///     Messages that cause exceptions are disgarded without interrupting
-    ///     the simulation server.
+    ///     none
     ///
     /// @pre
     ///     none
@@ -169,12 +248,134 @@ private:
     ///     none
     ///
     /// @limitations
-    ///     none
+    ///     Blocks on accept, so m_quit is only checked between connections.
     ///
     ////////////////////////////////////////////////////////////////////////////
     void Run();
-
-    void StartDGIProcess(unsigned short p_port, size_t p_index);
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// Session( TSocket )
+    ///
+    /// @description
+    ///     Message handler for one simulation connection. Handles framed GET
+    ///     and SET exchanges on the same socket until the simulation closes
+    ///     it, so the simulation does not reconnect on every time step.
+    ///
+    ///     DST and DGT are the delta forms of SET and GET. Their body is a
+    ///     32-bit count, that many 32-bit table indexes, and then the doubles
+    ///     of those entries. DST updates only the listed state entries. DGT
+    ///     returns the command entries that changed since the last table sent
+    ///     on this session, or every entry if none was sent. The simulation
+    ///     sends a full SET or GET now and then to recover from a lost delta.
+    ///
+    /// @Shared_Memory
+    ///     m_command and m_state are accessed and modified
+    ///
+    /// @Error_Handling
+    ///     An exception ends the session without interrupting the simulation
+    ///     server. The simulation is expected to reconnect.
+    ///
+    /// @pre
+    ///     p_socket is connected to the simulation
+    ///
+    /// @post
+    ///     p_socket is closed
+    ///
+    /// @param
+    ///     p_socket is the accepted simulation connection
+    ///
+    /// @limitations
+    ///     A simulation that connects once per exchange is still served, one
+    ///     exchange per session.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void Session( TSocket p_socket );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// RunSharedMemory
+    ///
+    /// @description
+    ///     Exchanges the tables with a simulation on the same host through
+    ///     m_segment. Each state table the simulation publishes is copied into
+    ///     m_state, and the command table is copied into the segment after
+    ///     every wakeup.
+    ///
+    /// @Shared_Memory
+    ///     m_command is read and m_state is modified
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     m_segment is mapped
+    ///
+    /// @post
+    ///     none
+    ///
+    /// @limitations
+    ///     Command changes reach the segment within m_options.m_sharedPoll.
+    ///     In lockstep mode the command table is written after the barrier,
+    ///     but a simulation that reads before then sees the previous commands.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void RunSharedMemory();
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// RunReplay
+    ///
+    /// @description
+    ///     Stands in for the simulation by publishing the state tables of
+    ///     m_replay, either at their recorded times or as fast as the state
+    ///     table and the lockstep barrier allow. Stops the server at the end
+    ///     of the log and reports the replay rate.
+    ///
+    /// @Shared_Memory
+    ///     m_state is modified and m_command is read
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     m_replay is open
+    ///
+    /// @post
+    ///     the server is stopped
+    ///
+    /// @limitations
+    ///     Recorded command tables are skipped, since the cyber controls
+    ///     compute their own. Record the replay to compare them.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void RunReplay();
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// RunModel
+    ///
+    /// @description
+    ///     Stands in for the simulation by stepping m_model on the current
+    ///     command table and publishing the resulting state table at
+    ///     m_options.m_modelRate steps per second.
+    ///
+    /// @Shared_Memory
+    ///     m_state is modified and m_command is read
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     m_model is created
+    ///
+    /// @post
+    ///     none
+    ///
+    /// @limitations
+    ///     A step that runs late is not made up, so the rate is a maximum.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void RunModel();
+    
+    /// logs every metric each m_options.m_statsPeriod seconds until stopped
+    void RunStats();
 
     // container of external cyber interfaces
     std::list<CSimulationInterface::TPointer> m_interface;
@@ -182,8 +383,14 @@ private:
     // service used by all the sockets
     boost::asio::io_service m_service;
     
-    // simulation port number
-    unsigned short m_port;
+    // server settings
+    SServerOptions m_options;
+    
+    // table layouts of m_options.m_xml, parsed or cached once for both tables
+    CTableLayout m_layout;
+    
+    // named metrics of the server, its tables and its interfaces
+    CMetrics m_metrics;
     
     // commands issued to devices
     CDeviceTable m_command;
@@ -194,6 +401,50 @@ private:
     // worker thread for the server
     boost::thread m_thread;
     
+    // threads that run m_service for the cyber interfaces
+    boost::thread_group m_pool;
+    
+    // acknowledgements of each SST for lockstep mode
+    boost::scoped_ptr<CStepBarrier> m_barrier;
+    
+    // tables shared with a simulation on the same host
+    boost::scoped_ptr<CSharedSegment> m_segment;
+    
+    // worker thread for m_segment
+    boost::thread m_sharedThread;
+    
+    // record of every table exchanged with the simulation
+    boost::scoped_ptr<CExchangeLog> m_log;
+    
+    // recorded exchanges that stand in for the simulation
+    boost::scoped_ptr<CExchangeReplay> m_replay;
+    
+    // worker thread for m_replay
+    boost::thread m_replayThread;
+    
+    // power balance model that stands in for the simulation
+    boost::scoped_ptr<CMicrogridModel> m_model;
+    
+    // worker thread for m_model
+    boost::thread m_modelThread;
+    
+    // worker thread that logs m_metrics
+    boost::thread m_statsThread;
+    
+    // tables exchanged with the simulation
+    CCounter m_stateExchanges;
+    CCounter m_commandExchanges;
+    
+    // bytes of each table exchange with the simulation
+    CHistogram m_stateBytes;
+    CHistogram m_commandBytes;
+    
+    // microseconds the state table writer lock is held per step
+    CHistogram m_writerHold;
+    
+    // microseconds the simulation waits on the lockstep barrier
+    CHistogram m_barrierWait;
+    
     // flag for termination
     bool m_quit;
     
@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CStepBarrier.hpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @description
+///     Barrier that holds the simulation until each SST finishes a step.
+///
+/// @functions
+///     CStepBarrier( size_t, long )
+///
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_STEP_BARRIER_HPP
+#define C_STEP_BARRIER_HPP
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/cstdint.hpp>
+#include <boost/utility.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include "logger.hpp"
+
+CREATE_EXTERN_STD_LOGS()
+
+namespace freedm {
+namespace simulation {
+
+////////////////////////////////////////////////////////////////////////////////
+/// CStepBarrier
+///
+/// @description
+///     Synchronizes the simulation with the cyber controls in lockstep mode.
+///     The server reports each state table version it publishes, and each SST
+///     acknowledges the version it has finished with. Before the simulation
+///     reads a command table, it waits for a step newer than the last released
+///     step and for every registered SST to acknowledge that step.
+///
+///     The simulation sends its state and requests its commands over separate
+///     connections, so a command request can arrive before the state of the
+///     same step. Waiting on the newest published step would then release the
+///     commands of the previous step, which is why the barrier tracks the
+///     released step itself.
+///
+///     An SST registers with its first acknowledgement. An SST that misses
+///     the timeout is unregistered so that a stopped broker delays only one
+///     step, and it registers again with its next acknowledgement.
+///
+/// @limitations
+///     The barrier does not know of brokers that have never acknowledged a
+///     step, so the first steps of a run may not wait on late brokers. A
+///     simulation that reads commands before it sends its first state waits
+///     for the timeout once.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CStepBarrier : private boost::noncopyable
+{
+public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// CStepBarrier( size_t, long )
+    ///
+    /// @description
+    ///     Creates a barrier with no registered SST.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     m_acked has an entry for each SST index from 1 to p_count
+    ///
+    /// @param
+    ///     p_count is the number of SST that may acknowledge a step
+    ///     p_timeout is the longest wait for a step in milliseconds
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    CStepBarrier( size_t p_count, long p_timeout );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// Acknowledge( size_t, uint64_t )
+    ///
+    /// @description
+    ///     Records that an SST has finished with a state table version.
+    ///
+    /// @Shared_Memory
+    ///     m_acked and m_registered can be modified outside of the class
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     p_index is registered with the barrier
+    ///     a simulation waiting on p_version is woken
+    ///
+    /// @param
+    ///     p_index is the SST index of the acknowledging interface
+    ///     p_version is the last state table version the SST has handled
+    ///
+    /// @limitations
+    ///     Acknowledgements from unknown SST indexes are ignored.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void Acknowledge( size_t p_index, boost::uint64_t p_version );
+    
+    /// records that the server has published a new state table version
+    void Publish( boost::uint64_t p_version );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// Wait
+    ///
+    /// @description
+    ///     Blocks until a step newer than the last released step has been
+    ///     published and every registered SST has acknowledged it, or until
+    ///     the timeout expires.
+    ///
+    /// @Shared_Memory
+    ///     m_acked is read and m_registered can be modified
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     m_released is set to the newest published step
+    ///     SST that missed the timeout are unregistered
+    ///
+    /// @return
+    ///     true if the step was published and acknowledged in time
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    bool Wait();
+private:
+    /// returns true if a new step is published and each registered SST has
+    /// acknowledged it
+    bool Complete() const;
+    
+    /// protects every member below
+    boost::mutex m_mutex;
+    
+    /// signalled on every acknowledgement and publish
+    boost::condition_variable m_changed;
+    
+    /// newest state table version published by the server
+    boost::uint64_t m_published;
+    
+    /// state table version of the last released command table
+    boost::uint64_t m_released;
+    
+    /// last version acknowledged by each SST, indexed by SST
+    std::vector<boost::uint64_t> m_acked;
+    
+    /// true for each SST the barrier waits on, indexed by SST
+    std::vector<bool> m_registered;
+    
+    /// longest wait for a step
+    boost::posix_time::time_duration m_timeout;
+};
+
+} // namespace simulation
+} // namespace freedm
+
+#endif // C_STEP_BARRIER_HPP
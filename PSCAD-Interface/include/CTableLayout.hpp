@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CTableLayout.hpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+///     Table layouts of an XML input file, compiled once and cached.
+///
+/// @functions
+///     CTableLayout( const string &, const string & )
+///     CTableLayout::GetSSTCount() const
+///     CTableLayout::GetTable( const string & ) const
+///
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_TABLE_LAYOUT_HPP
+#define C_TABLE_LAYOUT_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/foreach.hpp>
+#include <boost/utility.hpp>
+#include <boost/optional/optional.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+
+#include "logger.hpp"
+
+CREATE_EXTERN_STD_LOGS()
+
+namespace freedm {
+namespace simulation {
+
+////////////////////////////////////////////////////////////////////////////////
+/// CTableLayout
+///
+/// @description
+///     Holds the SST count and the entries of every table in an XML input
+///     file, so the file is parsed once for all of the tables built from it.
+///
+///     The parsed layout is written to a binary cache file together with a
+///     hash of the XML contents. A later run with the same XML maps the cache
+///     into memory and reads the layout from it without parsing any XML. A
+///     cache with a different hash, version or a damaged body is ignored and
+///     rewritten.
+///
+///     Cache format, in host byte order:
+///         uint32 MAGIC, uint32 VERSION, uint64 XML hash, uint32 SST count,
+///         uint32 table count, then per table:
+///         uint32 tag length, tag, uint32 entry count, then per entry:
+///         uint32 parent, uint32 device length, device, uint32 key length, key
+///
+/// @limitations
+///     The cache is only valid on hosts with the byte order that wrote it;
+///     any other host rewrites it.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CTableLayout : private boost::noncopyable
+{
+public:
+    /// one table entry, stored at its table index
+    struct SEntry
+    {
+        std::string m_device;
+        std::string m_key;
+        size_t m_parent;        // parent SST, or 0 if every SST has access
+    };
+    
+    /// format of a cache file
+    static const boost::uint32_t MAGIC = 0x4C545846;    // "FXTL"
+    static const boost::uint32_t VERSION = 1;
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// CTableLayout( const string &, const string & )
+    ///
+    /// @description
+    ///     Reads the table layouts of an XML input file, from the cache file
+    ///     if it matches the XML contents.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Throws an exception if the XML input file cannot be read or has an
+    ///     invalid format. A cache that cannot be read or written only logs a
+    ///     warning.
+    ///
+    /// @pre
+    ///     p_xml has the format required by CTableStructure
+    ///
+    /// @post
+    ///     the layout of every table in p_xml is stored
+    ///     p_cache holds the layout unless it is empty or not writable
+    ///
+    /// @param
+    ///     p_xml is the filename of the XML input file
+    ///     p_cache is the filename of the cache, empty to parse without one
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    CTableLayout( const std::string & p_xml, const std::string & p_cache );
+    
+    /// returns the number of SST in the layout
+    size_t GetSSTCount() const { return m_SSTCount; }
+    
+    /// returns true if the layout was read from the cache
+    bool IsCached() const { return m_cached; }
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// GetTable( const string & ) const
+    ///
+    /// @description
+    ///     Returns the entries of a table in index order.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Throws std::out_of_range if the layout has no table with p_tag.
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     none
+    ///
+    /// @param
+    ///     p_tag is the XML tag of the table specification
+    ///
+    /// @return
+    ///     the entry at each table index
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    const std::vector<SEntry> & GetTable( const std::string & p_tag ) const;
+private:
+    typedef std::map< std::string, std::vector<SEntry> > TTableMap;
+    
+    /// parses every table of the XML contents
+    void Parse( const std::string & p_contents );
+    
+    /// reads a mapped cache file, false if it does not match p_hash
+    bool ReadCache( const char * p_data, size_t p_size, boost::uint64_t p_hash );
+    
+    /// maps and reads a cache file, false if it cannot be used
+    bool LoadCache( const std::string & p_cache, boost::uint64_t p_hash );
+    
+    /// writes the layout to a cache file, false if it cannot be written
+    bool SaveCache( const std::string & p_cache, boost::uint64_t p_hash ) const;
+    
+    /// number of SST that may be granted access to an entry
+    size_t m_SSTCount;
+    
+    /// entries of each table by XML tag
+    TTableMap m_tables;
+    
+    /// true if the layout was read from the cache
+    bool m_cached;
+};
+
+} // namespace simulation
+} // namespace freedm
+
+#endif // C_TABLE_LAYOUT_HPP
@@ -12,6 +12,7 @@
 ///
 /// @functions
 ///     CTableStructure::CTableStructure( const string &, const string & )
+///     CTableStructure::CTableStructure( const CTableLayout &, const string & )
 ///     CTableStructure::GetSize() const
 ///     CTableStructure::FindIndex( const CDeviceKey & ) const
 ///     CTableStructure::FindDevice( size_t ) const
@@ -35,8 +36,7 @@
 #ifndef C_TABLE_STRUCTURE_HPP
 #define C_TABLE_STRUCTURE_HPP
 
-#include <map>
-#include <set>
+#include <vector>
 #include <string>
 #include <sstream>
 #include <stdexcept>
@@ -49,6 +49,7 @@
 
 #include "logger.hpp"
 #include "CDeviceKey.hpp"
+#include "CTableLayout.hpp"
 
 CREATE_EXTERN_STD_LOGS()
 
@@ -115,6 +116,36 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     CTableStructure( const std::string & p_xml, const std::string & p_tag );
     
+    ////////////////////////////////////////////////////////////////////////////
+    /// CTableStructure( const CTableLayout &, const string & )
+    ///
+    /// @description
+    ///     Creates an instance of CTableStructure from a table of a layout
+    ///     that has already been read, so several tables share one parse.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     Throws an exception if the layout has no table with p_tag or if the
+    ///     table has duplicate device keys.
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     none
+    ///
+    /// @param
+    ///     p_layout holds the parsed XML input file
+    ///     p_tag is the XML tag of the table specification
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    CTableStructure( const CTableLayout & p_layout, const std::string & p_tag );
+    
     ////////////////////////////////////////////////////////////////////////////
     /// GetSize() const
     ///
@@ -142,6 +173,9 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     size_t GetSize() const { return m_TableSize; }
     
+    /// returns the number of sst that may be granted access to an entry
+    size_t GetSSTCount() const { return m_SSTCount; }
+    
     ////////////////////////////////////////////////////////////////////////////
     /// FindIndex( const CDeviceKey & ) const
     ///
@@ -235,7 +269,76 @@ public:
     ///
     ////////////////////////////////////////////////////////////////////////////
     bool HasAccess( const CDeviceKey & p_dkey, size_t p_parent ) const;
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// HasAccess( size_t, size_t ) const
+    ///
+    /// @description
+    ///     Determines if a parent has access to the entry at a specific index.
+    ///     The check is a single bit test against the access bitmap.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     none
+    ///
+    /// @param
+    ///     p_index is the table index of the entry to check for access
+    ///     p_parent is the index of the parent SST seeking access
+    ///
+    /// @return
+    ///     true if p_parent has access to the entry at p_index
+    ///     false if p_index is outside the table
+    ///     false if p_parent is an unrecognized parent index
+    ///     false otherwise
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    bool HasAccess( size_t p_index, size_t p_parent ) const;
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// FindParent( size_t ) const
+    ///
+    /// @description
+    ///     Returns the parent SST of the entry at a specific index.
+    ///
+    /// @Shared_Memory
+    ///     none
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     none
+    ///
+    /// @post
+    ///     none
+    ///
+    /// @param
+    ///     p_index is the table index of the entry
+    ///
+    /// @return
+    ///     the index of the only SST with access to the entry
+    ///     0 if several SST or none have access to the entry
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    size_t FindParent( size_t p_index ) const;
 private:
+    /// builds the bimap and access bitmap from a table of p_layout
+    void Build( const CTableLayout & p_layout, const std::string & p_tag );
+    
     struct SDevice {};
     struct SIndex {};
     
@@ -247,8 +350,11 @@ private:
     /// bidirectional map from device key to numeric index
     TBimap m_DeviceIndex;
     
-    /// unidirectional map from device key to list of parents
-    std::map< CDeviceKey, std::set<size_t> > m_DeviceParent;
+    /// number of sst that may be granted access to an entry
+    size_t m_SSTCount;
+    
+    /// access bitmap with one row per table index and one bit per sst
+    std::vector<bool> m_Access;
 };
 
 } // namespace simulation
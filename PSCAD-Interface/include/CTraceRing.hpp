@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CTraceRing.hpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+///     Binary trace points for the request paths of the simulation server.
+///
+/// @functions
+///     CTraceRing::Enable( size_t )
+///     CTraceRing::Record( EPoint, uint32_t, double )
+///     CTraceRing::Dump( const string & )
+///
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_TRACE_RING_HPP
+#define C_TRACE_RING_HPP
+
+#include <string>
+
+#include <boost/cstdint.hpp>
+#include <boost/scoped_array.hpp>
+
+#include "logger.hpp"
+
+CREATE_EXTERN_STD_LOGS()
+
+/// records a trace point when tracing is compiled in and enabled at run time
+#ifdef PSCAD_INTERFACE_TRACE
+    #define TRACE_POINT( point, index, value ) \
+        if( !freedm::simulation::CTraceRing::IsEnabled() ) {} else \
+            freedm::simulation::CTraceRing::Record( \
+                freedm::simulation::CTraceRing::point, index, value )
+#else
+    #define TRACE_POINT( point, index, value ) ((void)0)
+#endif
+
+namespace freedm {
+namespace simulation {
+
+////////////////////////////////////////////////////////////////////////////////
+/// CTraceRing
+///
+/// @description
+///     Stores the most recent trace points in a fixed ring of binary records.
+///     A record costs one atomic increment, a clock read and a copy of three
+///     numbers, so every table access can be traced without formatting text.
+///     The ring is written to a file with Dump and decoded offline.
+///
+///     Trace points are placed with the TRACE_POINT macro. Without the
+///     PSCAD_INTERFACE_TRACE definition the macro compiles to nothing, and
+///     with it a disabled ring costs a single branch.
+///
+/// @limitations
+///     A record written while the ring is dumped may be torn. Dump the ring
+///     after the server stops for an exact trace.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CTraceRing
+{
+public:
+    /// places in the code that record a trace point
+    enum EPoint
+    {
+        TABLE_GET = 1,      // device table read by device key
+        TABLE_SET,          // device table write by device key
+        ENTRY_GET,          // device table read by table index
+        ENTRY_SET,          // device table write by table index
+        HANDLE_GET,         // interface read by handle
+        HANDLE_SET,         // interface write by handle
+        LINE_REQUEST,       // text request from a broker
+        FRAME_REQUEST,      // binary request from a broker
+        PSCAD_REQUEST,      // request from the simulation
+        STEP_PUBLISHED      // state table version published
+    };
+    
+    /// format of a dumped trace file
+    static const boost::uint32_t MAGIC = 0x52545846;    // "FXTR"
+    static const boost::uint32_t VERSION = 1;
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// Enable( size_t )
+    ///
+    /// @description
+    ///     Allocates the ring and starts recording trace points.
+    ///
+    /// @Shared_Memory
+    ///     s_records is allocated
+    ///
+    /// @Error_Handling
+    ///     Throws std::invalid_argument if p_capacity is zero.
+    ///
+    /// @pre
+    ///     no other thread records trace points
+    ///
+    /// @post
+    ///     IsEnabled returns true
+    ///
+    /// @param
+    ///     p_capacity is the number of records kept before the oldest is lost
+    ///
+    /// @limitations
+    ///     The ring is allocated once per process.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static void Enable( size_t p_capacity );
+    
+    /// returns true if the ring records trace points
+    static bool IsEnabled() { return s_capacity != 0; }
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// Record( EPoint, uint32_t, double )
+    ///
+    /// @description
+    ///     Stores a trace point over the oldest record of the ring.
+    ///
+    /// @Shared_Memory
+    ///     s_next is incremented and one element of s_records is written
+    ///
+    /// @Error_Handling
+    ///     none
+    ///
+    /// @pre
+    ///     IsEnabled returns true
+    ///
+    /// @post
+    ///     the newest record holds the trace point
+    ///
+    /// @param
+    ///     p_point identifies the place in the code
+    ///     p_index is the table index, handle or port of the trace point
+    ///     p_value is the value read or written, or a request code
+    ///
+    /// @limitations
+    ///     none
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static void Record( EPoint p_point, boost::uint32_t p_index, double p_value );
+    
+    ////////////////////////////////////////////////////////////////////////////
+    /// Dump( const string & )
+    ///
+    /// @description
+    ///     Writes the records of the ring to a file from oldest to newest.
+    ///     The file starts with the uint32 values MAGIC, VERSION and the record
+    ///     count, followed by the records in host byte order.
+    ///
+    /// @Shared_Memory
+    ///     s_records is read
+    ///
+    /// @Error_Handling
+    ///     Throws std::runtime_error if the file cannot be created.
+    ///
+    /// @pre
+    ///     IsEnabled returns true
+    ///
+    /// @post
+    ///     p_filename holds the records of the ring
+    ///
+    /// @param
+    ///     p_filename is the name of the trace file
+    ///
+    /// @limitations
+    ///     See the class limitations.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static void Dump( const std::string & p_filename );
+private:
+    /// one trace point
+    struct SRecord
+    {
+        boost::uint64_t m_time;     // microseconds on the monotonic clock
+        boost::uint32_t m_point;    // EPoint of the record
+        boost::uint32_t m_index;    // table index, handle or port
+        double m_value;             // value or request code
+    };
+    
+    /// circular buffer of records
+    static boost::scoped_array<SRecord> s_records;
+    
+    /// number of s_records elements, zero while disabled
+    static size_t s_capacity;
+    
+    /// number of records ever stored, updated with the __sync builtins
+    static boost::uint64_t s_next;
+};
+
+} // namespace simulation
+} // namespace freedm
+
+#endif // C_TRACE_RING_HPP
@@ -36,6 +36,11 @@ public:
     {
         m_filter = p_level;
     }
+    
+    static bool isEnabled( const int p_level )
+    {
+        return m_filter >= p_level;
+    }
 
 private:
     static int m_filter;
@@ -52,6 +57,14 @@ private:
 #define CREATE_EXTERN_LOG( level, name ) \
     boost::iostreams::stream<Logger::Log> name
 
+// streams to a standard log only if its level passes the filter, so that a
+// filtered message is never formatted
+#define LOG_IF( level, name ) \
+    if( !Logger::Log::isEnabled(level) ) {} else Logger::name
+
+#define LOG_DEBUG   LOG_IF( 7, Debug )
+#define LOG_INFO    LOG_IF( 6, Info )
+
 #define CREATE_STD_LOGS() \
 	namespace Logger { \
 	CREATE_LOG(7, Debug); \
@@ -0,0 +1,96 @@
+#ifndef PSCAD_SHM_H
+#define PSCAD_SHM_H
+
+// Layout of the shared memory segment used by psocket.c and the simulation
+// server for same-host exchanges. The segment is a header followed by the
+// state table and then the command table, both arrays of doubles.
+//
+// Each table is guarded by a sequence counter that is odd while its writer
+// is copying. A reader copies the table and retries until it saw the same
+// even counter before and after the copy. PSCAD writes the state table and
+// wakes the server with a futex on state_seq; the server writes the command
+// table and PSCAD reads it without waiting.
+
+// syscall and struct timespec are not declared under a strict C standard
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <time.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#define PSCAD_SHM_MAGIC     0x4644474D
+#define PSCAD_SHM_VERSION   1
+
+struct pscad_shm_header
+{
+    uint32_t magic;                 // PSCAD_SHM_MAGIC once initialized
+    uint32_t version;               // PSCAD_SHM_VERSION
+    uint32_t state_length;          // number of doubles in the state table
+    uint32_t command_length;        // number of doubles in the command table
+    volatile uint32_t state_seq;    // odd while PSCAD writes the state table
+    volatile uint32_t command_seq;  // odd while the server writes commands
+};
+
+#define PSCAD_SHM_SIZE(ns,nc) \
+    (sizeof(struct pscad_shm_header) + ((ns)+(nc))*sizeof(double))
+#define PSCAD_SHM_STATE(h) \
+    ((double *)((char *)(h) + sizeof(struct pscad_shm_header)))
+#define PSCAD_SHM_COMMAND(h) \
+    (PSCAD_SHM_STATE(h) + (h)->state_length)
+
+static __inline__ void pscad_shm_write( volatile uint32_t * seq, double * dest,
+        const double * src, uint32_t length )
+{
+    // each increment is a full barrier around the copy
+    __sync_fetch_and_add( seq, 1 );
+    memcpy( dest, src, length*sizeof(double) );
+    __sync_fetch_and_add( seq, 1 );
+}
+
+static __inline__ uint32_t pscad_shm_read( volatile uint32_t * seq, double * dest,
+        const double * src, uint32_t length )
+{
+    uint32_t before;
+    uint32_t after;
+    
+    do
+    {
+        // wait out a writer that is in the middle of a copy
+        while( (before = *seq) & 1 )
+        {
+            __sync_synchronize();
+        }
+        __sync_synchronize();
+        memcpy( dest, src, length*sizeof(double) );
+        __sync_synchronize();
+        after = *seq;
+    }
+    while( before != after );
+    
+    return before;
+}
+
+static __inline__ void pscad_shm_wake( volatile uint32_t * seq )
+{
+    syscall( SYS_futex, seq, FUTEX_WAKE, INT_MAX, 0, 0, 0 );
+}
+
+static __inline__ void pscad_shm_wait( volatile uint32_t * seq, uint32_t seen, long usec )
+{
+    struct timespec timeout;
+    
+    timeout.tv_sec = usec / 1000000;
+    timeout.tv_nsec = (usec % 1000000) * 1000;
+    
+    // returns at once if the counter already moved past seen
+    syscall( SYS_futex, seq, FUTEX_WAIT, seen, &timeout, 0, 0 );
+}
+
+#endif // PSCAD_SHM_H
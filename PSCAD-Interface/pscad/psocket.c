@@ -1,11 +1,26 @@
+// pscad_shm.h needs syscall and struct timespec, which a strict C standard
+// hides unless requested before the first system header
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <time.h>
 #include <errno.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 
+#include <fcntl.h>
 #include <netdb.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include "pscad_shm.h"
 
 #define ERROR_LOGFILE   1
 #define ERROR_HOSTNAME  2
@@ -14,29 +29,101 @@
 #define ERROR_HEADER    5
 #define ERROR_SEND      6
 #define ERROR_RECV      7
+#define ERROR_SHM       8
 
 #define PKT_HEADER_SIZE 5
 
 #define SENDLOG "pscad_send.log"
 #define RECVLOG "pscad_recv.log"
 
+// names the shared memory segment of a same-host simulation server
+#define SHM_VARIABLE "PSCAD_SHM"
+
+// steps between full tables in delta mode, delta mode is off when unset
+#define DELTA_VARIABLE "PSCAD_DELTA"
+
+// log detail: 0 logs only errors, 1 adds each request, 2 adds the table values
+#define LOG_VARIABLE "PSCAD_LOG"
+#define LOG_DEFAULT 1
+
+// bytes of log output batched in memory between writes to the file
+#define LOG_BUFFER_SIZE 65536
+
+// log file of one direction, open from the init call to the close call
+struct log_file
+{
+    const char * filename;          // name of the log file
+    FILE * fd;                      // open log, or 0
+    int level;                      // detail read from LOG_VARIABLE
+    char buffer[LOG_BUFFER_SIZE];   // output not yet written to the file
+};
+
+static struct log_file send_log = { SENDLOG, 0, LOG_DEFAULT, { 0 } };
+static struct log_file recv_log = { RECVLOG, 0, LOG_DEFAULT, { 0 } };
+
+// persistent connection to the simulation server, one per direction
+struct session
+{
+    int sd;                     // connected socket, or -1
+    int resolved;               // nonzero once server holds the address
+    struct sockaddr_in server;  // resolved server address
+};
+
+static struct session send_session = { -1, 0, { 0 } };
+static struct session recv_session = { -1, 0, { 0 } };
+
+// last table exchanged in delta mode, one per direction
+struct delta_table
+{
+    int length;                 // number of table entries
+    int period;                 // exchanges per full table, 0 disables deltas
+    int steps;                  // exchanges since the last full table
+    double * values;            // last table sent or received
+    uint32_t * index;           // indexes of the changed entries
+    double * changed;           // values of the changed entries
+    char * packet;              // count, indexes and values of a delta
+};
+
+static struct delta_table send_table = { 0, 0, 0, 0, 0, 0, 0 };
+static struct delta_table recv_table = { 0, 0, 0, 0, 0, 0, 0 };
+
+// shared memory segment, used in place of the sockets when mapped
+static struct pscad_shm_header * shm = 0;
+static size_t shm_size = 0;
+
+// components using the segment, and whether each direction holds it
+static int shm_users = 0;
+static int send_mapped = 0;
+static int recv_mapped = 0;
+
 int itodd( char * address, int ip1, int ip2, int ip3, int ip4 )
 {
     // convert from integer to dot-decimal notation
     return sprintf( address, "%d.%d.%d.%d", ip1, ip2, ip3, ip4 ) + 1;
 }
 
-int print_header( const char * filename, const char * address, int port )
+int print_header( struct log_file * pl, const char * address, int port )
 {
+    const char * level = getenv(LOG_VARIABLE);
     FILE * fd;
     time_t rawtime;
     struct tm * timeinfo;
     
-    // create new log
-    if( (fd = fopen( filename, "w" )) == 0 )
+    // a previous run may not have reached its close call
+    if( pl->fd != 0 )
+    {
+        fclose(pl->fd);
+        pl->fd = 0;
+    }
+    
+    // create new log, written only when the buffer fills or on errors
+    if( (fd = fopen( pl->filename, "w" )) == 0 )
     {
         return ERROR_LOGFILE;
     }
+    setvbuf( fd, pl->buffer, _IOFBF, sizeof(pl->buffer) );
+    pl->fd = fd;
+    pl->level = ( level != 0 ? atoi(level) : LOG_DEFAULT );
     
     // get current time
     time(&rawtime);
@@ -45,32 +132,38 @@ int print_header( const char * filename, const char * address, int port )
     // print log header
     fprintf( fd, "Current Time:   %s", asctime(timeinfo) );
     fprintf( fd, "Server Address: %s:%d\n", address, port );
+    fflush(fd);
     
-    fclose(fd);
     return 0;
 }
 
-int print_result( const char * filename, const char * header,
+int print_result( struct log_file * pl, const char * header,
         const double * data, int length )
 {
-    FILE * fd;
+    FILE * fd = pl->fd;
+    int error = errno;
     int index;
     
-    // append to existing log
-    if( (fd = fopen( filename, "a" )) == 0 )
+    if( fd == 0 )
     {
         return ERROR_LOGFILE;
     }
     
     // print status message
-    switch( errno )
+    switch( error )
     {
     case 0:
         // success case
-        fprintf( fd, "%s\n", header );
-        for( index = 0; index < length; index++ )
+        if( pl->level >= 1 )
         {
-            fprintf( fd, "\t%f\n", data[index] );
+            fprintf( fd, "%s\n", header );
+        }
+        if( pl->level >= 2 )
+        {
+            for( index = 0; index < length; index++ )
+            {
+                fprintf( fd, "\t%f\n", data[index] );
+            }
         }
         break;
     case ERROR_HOSTNAME:
@@ -91,37 +184,41 @@ int print_result( const char * filename, const char * header,
     case ERROR_HEADER:
         fprintf( fd, "invalid packet header size\n" );
         break;
+    case ERROR_SHM:
+        fprintf( fd, "shared memory segment does not match the table\n" );
+        break;
     default:
         fprintf( fd, "unhandled error\n" );
         break;
     }
     
-    fclose(fd);
-    return errno;
+    // errors reach the file at once in case the simulation is aborted
+    if( error != 0 )
+    {
+        fflush(fd);
+    }
+    
+    return error;
 }
 
-int print_footer( const char * filename )
+int print_footer( struct log_file * pl )
 {
-    FILE * fd;
-    
-    // append to existing log
-    if( (fd = fopen( filename, "a" )) == 0 )
+    if( pl->fd == 0 )
     {
         return ERROR_LOGFILE;
     }
     
-    // print log footer
-    fprintf( fd, "Simulation Complete\n" );
+    // print log footer and write what remains of the batch
+    fprintf( pl->fd, "Simulation Complete\n" );
+    fclose(pl->fd);
+    pl->fd = 0;
     
-    fclose(fd);
     return 0;
 }
 
-int connect_to_server( const char * address, int port )
+int resolve_server( struct session * ps, const char * address, int port )
 {
     struct hostent * hostname;
-    struct sockaddr_in server;
-    int client;
     
     // resolve server hostname
     if( (hostname = gethostbyname(address)) == 0 )
@@ -130,6 +227,27 @@ int connect_to_server( const char * address, int port )
         return -1;
     }
     
+    // specify server details
+    memset( &ps->server, 0, sizeof(ps->server) );
+    ps->server.sin_family = AF_INET;
+    ps->server.sin_port = htons(port);
+    memcpy( &ps->server.sin_addr, hostname->h_addr_list[0], hostname->h_length );
+    ps->resolved = 1;
+    
+    return 0;
+}
+
+int connect_to_server( struct session * ps )
+{
+    int client;
+    int enable = 1;
+    
+    // reuse the connection from the previous time step
+    if( ps->sd != -1 )
+    {
+        return ps->sd;
+    }
+    
     // create client IPv4 TCP socket
     if( (client = socket( AF_INET, SOCK_STREAM, 0 )) == -1 )
     {
@@ -137,28 +255,73 @@ int connect_to_server( const char * address, int port )
         return -1;
     }
     
-    // specify server details
-    server.sin_family = AF_INET;
-    server.sin_port = htons(port);
-    memcpy( &server.sin_addr, hostname->h_addr_list[0], hostname->h_length );
-    
     // connect client to server
-    if( connect( client, (struct sockaddr *)&server, sizeof(server) ) == -1 )
+    if( connect( client, (struct sockaddr *)&ps->server, sizeof(ps->server) ) == -1 )
     {
         errno = ERROR_CONNECT;
         close(client);
         return -1;
     }
     
+    // each packet is a complete request, so do not hold it back for more
+    setsockopt( client, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable) );
+    
+    ps->sd = client;
     return client;
 }
 
+void disconnect_from_server( struct session * ps )
+{
+    if( ps->sd != -1 )
+    {
+        close(ps->sd);
+        ps->sd = -1;
+    }
+}
+
+int send_all( int sd, struct iovec * parts, int count, int bytes )
+{
+    struct msghdr message;
+    ssize_t sent;
+    int total = 0;
+    
+    memset( &message, 0, sizeof(message) );
+    message.msg_iov = parts;
+    message.msg_iovlen = count;
+    
+    // sendmsg may transfer only part of the buffers; a closed session must
+    // fail the send and reach the retry in exchange rather than raise SIGPIPE
+    while( total < bytes )
+    {
+        if( (sent = sendmsg( sd, &message, MSG_NOSIGNAL )) <= 0 )
+        {
+            errno = ERROR_SEND;
+            return -1;
+        }
+        total += sent;
+        
+        // skip the buffers sent in full and advance into the next one
+        while( message.msg_iovlen > 0 && (size_t)sent >= message.msg_iov->iov_len )
+        {
+            sent -= message.msg_iov->iov_len;
+            message.msg_iov++;
+            message.msg_iovlen--;
+        }
+        if( message.msg_iovlen > 0 )
+        {
+            message.msg_iov->iov_base = (char *)message.msg_iov->iov_base + sent;
+            message.msg_iov->iov_len -= sent;
+        }
+    }
+    
+    return total;
+}
+
 int send_packet( int sd, const char * header, const void * data, int bytes )
 {
-    char * packet;
-    int packet_size;
+    char prefix[PKT_HEADER_SIZE];
+    struct iovec parts[2];
     int header_size;
-    int data_size;
     
     // get size of header
     header_size = strlen(header);
@@ -168,42 +331,331 @@ int send_packet( int sd, const char * header, const void * data, int bytes )
         return -1;
     }
     
-    // allocate memory for packet
-    packet_size = PKT_HEADER_SIZE + bytes;
-    packet = (char *)malloc(packet_size);
+    // pad the header to its fixed size
+    memset( prefix, 0, PKT_HEADER_SIZE );
+    memcpy( prefix, header, header_size );
+    
+    // send header and data in one call without copying the data
+    parts[0].iov_base = prefix;
+    parts[0].iov_len = PKT_HEADER_SIZE;
+    parts[1].iov_base = (void *)data;
+    parts[1].iov_len = bytes;
+    
+    return send_all( sd, parts, bytes > 0 ? 2 : 1, PKT_HEADER_SIZE + bytes );
+}
+
+int receive_packet( int sd, void * data, int bytes )
+{
+    int received;
+    int total = 0;
+    
+    // the response may arrive in several segments
+    while( total < bytes )
     {
-        // store header at packet front
-        memcpy( packet, header, header_size );
-        packet[header_size] = '\0';
+        if( (received = recv( sd, (char *)data+total, bytes-total, 0 )) <= 0 )
+        {
+            errno = ERROR_RECV;
+            return -1;
+        }
+        total += received;
+    }
+    
+    return total;
+}
 
-        if( bytes > 0 )
+int exchange( struct session * ps, const char * address, int port,
+        const char * header, void * data, int bytes, int response )
+{
+    int sd;
+    int attempt;
+    
+    // resolve the server once for the whole simulation
+    if( !ps->resolved && resolve_server( ps, address, port ) == -1 )
+    {
+        return -1;
+    }
+    
+    // a broken session is retried once on a fresh connection
+    for( attempt = 0; attempt < 2; attempt++ )
+    {
+        if( (sd = connect_to_server(ps)) == -1 )
         {
-            // store data after packet header
-            memcpy( packet+PKT_HEADER_SIZE, data, bytes );
+            return -1;
         }
         
-        // send packet across socket
-        if( (data_size = send( sd, packet, packet_size, 0 )) == -1 )
+        if( send_packet( sd, header, response ? 0 : data,
+                response ? 0 : bytes ) != -1 &&
+            (!response || receive_packet( sd, data, bytes ) != -1) )
         {
-            errno = ERROR_SEND;
+            return 0;
         }
+        
+        disconnect_from_server(ps);
     }
-    free(packet);
     
-    return data_size;
+    return -1;
 }
 
-int receive_packet( int sd, void * data, int bytes )
+int receive_delta( int sd, struct delta_table * pt )
 {
-    int data_size;
+    uint32_t count;
+    uint32_t i;
     
-    // receive packet from socket
-    if( (data_size = recv( sd, data, bytes, 0 )) == -1 )
+    // the count gives the size of the index and value lists
+    if( receive_packet( sd, &count, sizeof(count) ) == -1 )
+    {
+        return -1;
+    }
+    if( count > (uint32_t)pt->length ||
+        receive_packet( sd, pt->index, count*sizeof(uint32_t) ) == -1 ||
+        receive_packet( sd, pt->changed, count*sizeof(double) ) == -1 )
     {
         errno = ERROR_RECV;
+        return -1;
+    }
+    
+    for( i = 0; i < count; i++ )
+    {
+        if( pt->index[i] >= (uint32_t)pt->length )
+        {
+            errno = ERROR_RECV;
+            return -1;
+        }
+        pt->values[pt->index[i]] = pt->changed[i];
+    }
+    
+    return 0;
+}
+
+int exchange_delta( struct session * ps, const char * address, int port,
+        struct delta_table * pt )
+{
+    int sd;
+    int attempt;
+    
+    if( !ps->resolved && resolve_server( ps, address, port ) == -1 )
+    {
+        return -1;
     }
     
-    return data_size;
+    // a new session answers with every entry, so the retry needs no resync
+    for( attempt = 0; attempt < 2; attempt++ )
+    {
+        if( (sd = connect_to_server(ps)) == -1 )
+        {
+            return -1;
+        }
+        
+        if( send_packet( sd, "DGT", 0, 0 ) != -1 && receive_delta( sd, pt ) != -1 )
+        {
+            return 0;
+        }
+        
+        disconnect_from_server(ps);
+    }
+    
+    return -1;
+}
+
+int delta_period( void )
+{
+    const char * period = getenv(DELTA_VARIABLE);
+    return( period != 0 ? atoi(period) : 0 );
+}
+
+void release_table( struct delta_table * pt )
+{
+    free(pt->values);
+    free(pt->index);
+    free(pt->changed);
+    free(pt->packet);
+    pt->values = 0;
+    pt->index = 0;
+    pt->changed = 0;
+    pt->packet = 0;
+    pt->length = 0;
+    pt->steps = 0;
+}
+
+int prepare_table( struct delta_table * pt, int length )
+{
+    if( pt->length == length && pt->values != 0 )
+    {
+        return 0;
+    }
+    
+    // a table of a new size starts over with a full exchange
+    release_table(pt);
+    pt->values = (double *)calloc( length, sizeof(double) );
+    pt->index = (uint32_t *)malloc( length*sizeof(uint32_t) );
+    pt->changed = (double *)malloc( length*sizeof(double) );
+    pt->packet = (char *)malloc( sizeof(uint32_t) + length*(sizeof(uint32_t)+sizeof(double)) );
+    pt->length = length;
+    
+    if( pt->values == 0 || pt->index == 0 || pt->changed == 0 || pt->packet == 0 )
+    {
+        release_table(pt);
+        errno = ERROR_SEND;
+        return -1;
+    }
+    
+    return 0;
+}
+
+int send_delta( const char * address, int port, const double * data, int length )
+{
+    struct delta_table * pt = &send_table;
+    uint32_t count = 0;
+    int i;
+    
+    if( prepare_table( pt, length ) == -1 )
+    {
+        return -1;
+    }
+    
+    if( pt->steps % pt->period == 0 )
+    {
+        // a full table now and then recovers from a lost delta
+        if( exchange( &send_session, address, port, "SET", (void *)data,
+                length*sizeof(double), 0 ) == -1 )
+        {
+            pt->steps = 0;
+            return -1;
+        }
+    }
+    else
+    {
+        // list the entries that changed since the last table sent
+        for( i = 0; i < length; i++ )
+        {
+            if( memcmp( &data[i], &pt->values[i], sizeof(double) ) != 0 )
+            {
+                pt->index[count] = i;
+                pt->changed[count] = data[i];
+                count++;
+            }
+        }
+        
+        memcpy( pt->packet, &count, sizeof(count) );
+        memcpy( pt->packet + sizeof(count), pt->index, count*sizeof(uint32_t) );
+        memcpy( pt->packet + sizeof(count) + count*sizeof(uint32_t), pt->changed,
+                count*sizeof(double) );
+        
+        if( exchange( &send_session, address, port, "DST", pt->packet,
+                sizeof(count) + count*(sizeof(uint32_t)+sizeof(double)), 0 ) == -1 )
+        {
+            pt->steps = 0;
+            return -1;
+        }
+    }
+    
+    memcpy( pt->values, data, length*sizeof(double) );
+    pt->steps++;
+    return 0;
+}
+
+int recv_delta( const char * address, int port, double * data, int length )
+{
+    struct delta_table * pt = &recv_table;
+    int result;
+    
+    if( prepare_table( pt, length ) == -1 )
+    {
+        return -1;
+    }
+    
+    if( pt->steps % pt->period == 0 )
+    {
+        result = exchange( &recv_session, address, port, "GET", pt->values,
+                length*sizeof(double), 1 );
+    }
+    else
+    {
+        result = exchange_delta( &recv_session, address, port, pt );
+    }
+    
+    if( result == -1 )
+    {
+        pt->steps = 0;
+        return -1;
+    }
+    
+    memcpy( data, pt->values, length*sizeof(double) );
+    pt->steps++;
+    return 0;
+}
+
+int map_segment( int * mapped )
+{
+    const char * name;
+    struct pscad_shm_header header;
+    int fd;
+    
+    if( *mapped )
+    {
+        return 0;
+    }
+    
+    // the other direction already mapped the segment
+    if( shm != 0 )
+    {
+        shm_users++;
+        *mapped = 1;
+        return 0;
+    }
+    
+    // the segment is only used when the environment names one
+    if( (name = getenv(SHM_VARIABLE)) == 0 )
+    {
+        return 0;
+    }
+    
+    if( (fd = shm_open( name, O_RDWR, 0 )) == -1 )
+    {
+        errno = ERROR_SHM;
+        return -1;
+    }
+    
+    // the header gives the size of the tables that follow it
+    if( read( fd, &header, sizeof(header) ) != sizeof(header) ||
+        header.magic != PSCAD_SHM_MAGIC || header.version != PSCAD_SHM_VERSION )
+    {
+        close(fd);
+        errno = ERROR_SHM;
+        return -1;
+    }
+    
+    shm_size = PSCAD_SHM_SIZE( header.state_length, header.command_length );
+    shm = (struct pscad_shm_header *)mmap( 0, shm_size, PROT_READ | PROT_WRITE,
+            MAP_SHARED, fd, 0 );
+    close(fd);
+    
+    if( shm == MAP_FAILED )
+    {
+        shm = 0;
+        errno = ERROR_SHM;
+        return -1;
+    }
+    
+    shm_users = 1;
+    *mapped = 1;
+    return 0;
+}
+
+void unmap_segment( int * mapped )
+{
+    if( !*mapped )
+    {
+        return;
+    }
+    *mapped = 0;
+    
+    // the segment stays mapped while the other direction still uses it
+    if( --shm_users == 0 )
+    {
+        munmap( shm, shm_size );
+        shm = 0;
+    }
 }
 
 void pscad_send_init__( int * ip1, int * ip2, int * ip3, int * ip4, int * port,
@@ -213,7 +665,18 @@ void pscad_send_init__( int * ip1, int * ip2, int * ip3, int * ip4, int * port,
 
     // get printable ip address
     itodd( address, *ip1, *ip2, *ip3, *ip4 );
-    *status = print_header( SENDLOG, address, *port );
+    
+    // a new run may target a different server
+    disconnect_from_server( &send_session );
+    send_session.resolved = 0;
+    send_table.steps = 0;
+    send_table.period = delta_period();
+    
+    *status = print_header( &send_log, address, *port );
+    if( *status == 0 && map_segment( &send_mapped ) == -1 )
+    {
+        *status = print_result( &send_log, "SHM", 0, 0 );
+    }
 }
 
 void pscad_send__( int * ip1, int * ip2, int * ip3, int * ip4, int * port,
@@ -221,27 +684,48 @@ void pscad_send__( int * ip1, int * ip2, int * ip3, int * ip4, int * port,
 {
     char request[] = "SET";
     char address[16];
-    int sd;
     
     // get printable ip address
     itodd( address, *ip1, *ip2, *ip3, *ip4 );
     
-    // connect to remote simulation server
-    if( (sd = connect_to_server( address, *port )) != -1 )
+    if( shm != 0 )
     {
-        // send the SET request and corresponding data
-        if( send_packet( sd, request, data, (*length)*sizeof(double) ) != -1 )
+        // publish the state table and wake the server
+        if( (uint32_t)*length == shm->state_length )
         {
-            errno = 0;  // reset errno on success
+            pscad_shm_write( &shm->state_seq, PSCAD_SHM_STATE(shm), data, *length );
+            pscad_shm_wake( &shm->state_seq );
+            errno = 0;
         }
+        else
+        {
+            errno = ERROR_SHM;
+        }
+    }
+    // send only the changed entries between periodic full tables
+    else if( send_table.period > 0 )
+    {
+        if( send_delta( address, *port, data, *length ) != -1 )
+        {
+            errno = 0;
+        }
+    }
+    // send the SET request and corresponding data on the open session
+    else if( exchange( &send_session, address, *port, request, data,
+            (*length)*sizeof(double), 0 ) != -1 )
+    {
+        errno = 0;  // reset errno on success
     }
     
-    *status = print_result( SENDLOG, request, data, *length );
+    *status = print_result( &send_log, request, data, *length );
 }
 
 void pscad_send_close__( int * status )
 {
-    *status = print_footer( SENDLOG );
+    disconnect_from_server( &send_session );
+    release_table( &send_table );
+    unmap_segment( &send_mapped );
+    *status = print_footer( &send_log );
 }
 
 void pscad_recv_init__( int * ip1, int * ip2, int * ip3, int * ip4, int * port,
@@ -251,7 +735,18 @@ void pscad_recv_init__( int * ip1, int * ip2, int * ip3, int * ip4, int * port,
     
     // get printable ip address
     itodd( address, *ip1, *ip2, *ip3, *ip4 );
-    *status = print_header( RECVLOG, address, *port );
+    
+    // a new run may target a different server
+    disconnect_from_server( &recv_session );
+    recv_session.resolved = 0;
+    recv_table.steps = 0;
+    recv_table.period = delta_period();
+    
+    *status = print_header( &recv_log, address, *port );
+    if( *status == 0 && map_segment( &recv_mapped ) == -1 )
+    {
+        *status = print_result( &recv_log, "SHM", 0, 0 );
+    }
 }
 
 void pscad_recv__( int * ip1, int * ip2, int * ip3, int * ip4, int * port,
@@ -259,29 +754,45 @@ void pscad_recv__( int * ip1, int * ip2, int * ip3, int * ip4, int * port,
 {
     char request[] = "GET";
     char address[16];
-    int sd;
     
     // get printable ip address
     itodd( address, *ip1, *ip2, *ip3, *ip4 );
     
-    // connect to remote simulation server
-    if( (sd = connect_to_server( address, *port )) != -1 )
+    if( shm != 0 )
     {
-        // send the GET request
-        if( send_packet( sd, request, 0, 0 ) != -1 )
+        // copy the latest command table the server published
+        if( (uint32_t)*length == shm->command_length )
         {
-            // receive the data response
-            if( receive_packet( sd, data, (*length)*sizeof(double) ) != -1 )
-            {
-                errno = 0;  // reset errno on success
-            }
+            pscad_shm_read( &shm->command_seq, data, PSCAD_SHM_COMMAND(shm), *length );
+            errno = 0;
         }
+        else
+        {
+            errno = ERROR_SHM;
+        }
+    }
+    // receive only the changed entries between periodic full tables
+    else if( recv_table.period > 0 )
+    {
+        if( recv_delta( address, *port, data, *length ) != -1 )
+        {
+            errno = 0;
+        }
+    }
+    // send the GET request and receive the data response on the open session
+    else if( exchange( &recv_session, address, *port, request, data,
+            (*length)*sizeof(double), 1 ) != -1 )
+    {
+        errno = 0;  // reset errno on success
     }
     
-    *status = print_result( RECVLOG, request, data, *length );
+    *status = print_result( &recv_log, request, data, *length );
 }
 
 void pscad_recv_close__( int * status )
 {
-    *status = print_footer( RECVLOG );
+    disconnect_from_server( &recv_session );
+    release_table( &recv_table );
+    unmap_segment( &recv_mapped );
+    *status = print_footer( &recv_log );
 }
@@ -26,24 +26,50 @@
 
 #include "CDeviceTable.hpp"
 
+#include <algorithm>
+
 namespace freedm {
 namespace simulation {
 
 CDeviceTable::CDeviceTable( const std::string & p_xml, const std::string & p_tag )
-    : m_structure( p_xml, p_tag )
+    : m_structure( p_xml, p_tag ), m_backStale(true), m_deltaApplied(false), m_version(0)
+{
+    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    Initialize();
+}
+
+CDeviceTable::CDeviceTable( const CTableLayout & p_layout, const std::string & p_tag )
+    : m_structure( p_layout, p_tag ), m_backStale(true), m_deltaApplied(false), m_version(0)
 {
     Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    Initialize();
+}
+
+void CDeviceTable::Initialize()
+{
+    // partition 0 holds the entries without a single parent sst
+    m_partitionCount = m_structure.GetSSTCount() + 1;
+    m_partitions.reset( new boost::shared_mutex[m_partitionCount] );
     
     m_length    = m_structure.GetSize();
+    m_partitionOf.resize( m_length );
+    for( size_t i = 0; i < m_length; i++ )
+    {
+        m_partitionOf[i] = m_structure.FindParent(i);
+    }
+    
     m_data      = new double[m_length];
+    m_back      = new double[m_length];
     //initialize all data to 0. Command table will further be initiated in CSimulationServer.cpp
-    for (int index = 0; index < m_length; index ++)
+    for (size_t index = 0; index < m_length; index ++)
+    {
       m_data[index] = 0;
+      m_back[index] = 0;
+    }
 }
 
 double CDeviceTable::GetValue( const CDeviceKey & p_dkey, size_t p_index )
 {
-    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
     std::stringstream error;
     
     // check for read permission
@@ -53,17 +79,20 @@ double CDeviceTable::GetValue( const CDeviceKey & p_dkey, size_t p_index )
         throw std::logic_error( error.str() );
     }
     
-    // enter critical section of m_data as reader
-    boost::shared_lock<boost::shared_mutex> lock(m_mutex);
-    Logger::Debug << "DGI-Interface " << p_index << " obtained mutex as reader" << std::endl;
+    // convert the key to an index
+    size_t entry = m_structure.FindIndex(p_dkey);
+    
+    // enter critical section of the entry partition as reader
+    LockPartition( m_partitionOf[entry], false );
+    boost::shared_lock<boost::shared_mutex> lock(m_partitions[m_partitionOf[entry]],
+        boost::adopt_lock);
+    TRACE_POINT( TABLE_GET, entry, m_data[entry] );
     
-    // convert the key to an index and return its value
-    return m_data[m_structure.FindIndex(p_dkey)];
+    return m_data[entry];
 }
 
 void CDeviceTable::SetValue( const CDeviceKey & p_dkey, size_t p_index, double p_value )
 {
-    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
     std::stringstream error;
     
     // check for write permission
@@ -73,18 +102,202 @@ void CDeviceTable::SetValue( const CDeviceKey & p_dkey, size_t p_index, double p
         throw std::logic_error( error.str() );
     }
     
-    // enter critical section of m_data as writer
-    boost::unique_lock<boost::shared_mutex> lock(m_mutex);
-    Logger::Debug << "DGI-Interface " << p_index << " obtained mutex as writer" << std::endl;
+    // convert the key to an index
+    size_t entry = m_structure.FindIndex(p_dkey);
+    
+    // enter critical section of the entry partition as writer
+    LockPartition( m_partitionOf[entry], true );
+    boost::unique_lock<boost::shared_mutex> lock(m_partitions[m_partitionOf[entry]],
+        boost::adopt_lock);
+    TRACE_POINT( TABLE_SET, entry, p_value );
+    
+    m_data[entry] = p_value;
+}
+
+double CDeviceTable::GetEntry( size_t p_entry )
+{
+    LockPartition( m_partitionOf[p_entry], false );
+    boost::shared_lock<boost::shared_mutex> lock(m_partitions[m_partitionOf[p_entry]],
+        boost::adopt_lock);
+    TRACE_POINT( ENTRY_GET, p_entry, m_data[p_entry] );
+    return m_data[p_entry];
+}
+
+void CDeviceTable::SetEntry( size_t p_entry, double p_value )
+{
+    LockPartition( m_partitionOf[p_entry], true );
+    boost::unique_lock<boost::shared_mutex> lock(m_partitions[m_partitionOf[p_entry]],
+        boost::adopt_lock);
+    TRACE_POINT( ENTRY_SET, p_entry, p_value );
+    m_data[p_entry] = p_value;
+}
+
+void CDeviceTable::Publish()
+{
+    std::vector<TWaitCallback> waiters;
+    boost::uint64_t version;
+    
+    // a full update leaves no record of which entries m_back lacks
+    if( !m_deltaApplied )
+    {
+        m_backStale = true;
+    }
+    m_deltaApplied = false;
+    
+    // the readers only wait for the pointer swap
+    LockPartitions(true);
+    boost::posix_time::ptime held = boost::posix_time::microsec_clock::universal_time();
+    std::swap( m_data, m_back );
+    UnlockPartitions(true);
+    m_publishHold.RecordElapsed( held );
+    
+    {
+        // the new data is visible before the new version
+        boost::mutex::scoped_lock lock(m_waiting);
+        version = ++m_version;
+        waiters.swap( m_waiters );
+    }
+    TRACE_POINT( STEP_PUBLISHED, 0, static_cast<double>(version) );
+    
+    // waiters run without a lock so they may read the table
+    for( size_t i = 0; i < waiters.size(); i++ )
+    {
+        waiters[i]( version );
+    }
+}
+
+void CDeviceTable::BeginFullUpdate()
+{
+    m_backStale = true;
+    m_deltaApplied = false;
+}
+
+void CDeviceTable::ApplyDelta( const std::vector<boost::uint32_t> & p_index,
+    const std::vector<double> & p_value )
+{
+    for( size_t i = 0; i < p_index.size(); i++ )
+    {
+        if( p_index[i] >= m_length )
+        {
+            throw std::out_of_range("delta entry outside of the table");
+        }
+    }
+    
+    // m_back holds the table from before the last publish
+    LockPartitions(false);
+    if( m_backStale )
+    {
+        std::copy( m_data, m_data + m_length, m_back );
+    }
+    else
+    {
+        for( size_t i = 0; i < m_lastDelta.size(); i++ )
+        {
+            m_back[m_lastDelta[i]] = m_data[m_lastDelta[i]];
+        }
+    }
+    UnlockPartitions(false);
+    
+    for( size_t i = 0; i < p_index.size(); i++ )
+    {
+        m_back[p_index[i]] = p_value[i];
+    }
     
-    // convert the key to an index and set its value
-    m_data[m_structure.FindIndex(p_dkey)] = p_value;
+    m_lastDelta = p_index;
+    m_backStale = false;
+    m_deltaApplied = true;
+}
+
+boost::uint64_t CDeviceTable::GetVersion()
+{
+    boost::mutex::scoped_lock lock(m_waiting);
+    return m_version;
+}
+
+void CDeviceTable::AsyncWait( boost::uint64_t p_version, TWaitCallback p_callback )
+{
+    boost::uint64_t version;
+    
+    {
+        boost::mutex::scoped_lock lock(m_waiting);
+        if( m_version <= p_version )
+        {
+            m_waiters.push_back( p_callback );
+            return;
+        }
+        version = m_version;
+    }
+    
+    // the step has already been published
+    p_callback( version );
+}
+
+void CDeviceTable::Snapshot( std::vector<double> & p_copy )
+{
+    // the vector is sized first so the copy cannot throw under the locks
+    p_copy.resize( m_length );
+    LockPartitions(false);
+    std::copy( m_data, m_data + m_length, p_copy.begin() );
+    UnlockPartitions(false);
+}
+
+void CDeviceTable::LockPartition( size_t p_partition, bool p_unique )
+{
+    boost::shared_mutex & mutex = m_partitions[p_partition];
+    
+    // the clock is only read when the lock is contended
+    if( p_unique ? mutex.try_lock() : mutex.try_lock_shared() )
+    {
+        return;
+    }
+    
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    if( p_unique )
+    {
+        mutex.lock();
+    }
+    else
+    {
+        mutex.lock_shared();
+    }
+    m_lockWait.RecordElapsed( start );
+}
+
+void CDeviceTable::LockPartitions( bool p_unique )
+{
+    // a fixed order keeps two whole-table operations from deadlocking
+    for( size_t i = 0; i < m_partitionCount; i++ )
+    {
+        LockPartition( i, p_unique );
+    }
+}
+
+void CDeviceTable::AddMetrics( CMetrics & p_metrics, const std::string & p_prefix ) const
+{
+    p_metrics.Add( p_prefix + "_lock_wait_us", m_lockWait );
+    p_metrics.Add( p_prefix + "_publish_hold_us", m_publishHold );
+}
+
+void CDeviceTable::UnlockPartitions( bool p_unique )
+{
+    for( size_t i = m_partitionCount; i > 0; i-- )
+    {
+        if( p_unique )
+        {
+            m_partitions[i-1].unlock();
+        }
+        else
+        {
+            m_partitions[i-1].unlock_shared();
+        }
+    }
 }
 
 CDeviceTable::~CDeviceTable()
 {
     Logger::Info << __PRETTY_FUNCTION__ << std::endl;
     delete [] m_data;
+    delete [] m_back;
 }
 
 } // namespace simulation
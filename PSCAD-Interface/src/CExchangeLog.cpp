@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CExchangeLog.cpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @see            CExchangeLog.hpp
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CExchangeLog.hpp"
+
+namespace freedm {
+namespace simulation {
+
+const long CExchangeLog::FLUSH_PERIOD;
+
+CExchangeLog::CExchangeLog( const std::string & p_filename, size_t p_state, size_t p_command )
+    : m_file(p_filename.c_str(), std::ios::binary | std::ios::trunc)
+    , m_start(boost::posix_time::microsec_clock::universal_time())
+    , m_lastFlush(m_start)
+    , m_state(p_state), m_command(p_command)
+{
+    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    boost::uint32_t header[4];
+    
+    header[0] = MAGIC;
+    header[1] = VERSION;
+    header[2] = static_cast<boost::uint32_t>(p_state);
+    header[3] = static_cast<boost::uint32_t>(p_command);
+    
+    if( !m_file )
+    {
+        throw std::runtime_error("cannot create exchange log " + p_filename);
+    }
+    m_file.write( reinterpret_cast<const char *>(header), sizeof(header) );
+    
+    Logger::Notice << "Recording simulation exchanges to " << p_filename << std::endl;
+}
+
+CExchangeLog::~CExchangeLog()
+{
+    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    
+    Flush();
+}
+
+void CExchangeLog::Flush()
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    
+    m_file.flush();
+    m_lastFlush = boost::posix_time::microsec_clock::universal_time();
+}
+
+void CExchangeLog::RecordState( const double * p_state )
+{
+    Record( RECORD_STATE, p_state, m_state );
+}
+
+void CExchangeLog::RecordCommand( const double * p_command )
+{
+    Record( RECORD_COMMAND, p_command, m_command );
+}
+
+void CExchangeLog::Record( ERecord p_type, const double * p_table, size_t p_length )
+{
+    boost::posix_time::ptime now;
+    boost::posix_time::time_duration elapsed;
+    boost::uint64_t time;
+    char type = static_cast<char>(p_type);
+    
+    boost::mutex::scoped_lock lock(m_mutex);
+    
+    // the timestamp is taken under the lock so the log is in time order
+    now = boost::posix_time::microsec_clock::universal_time();
+    elapsed = now - m_start;
+    time = elapsed.total_microseconds();
+    
+    m_file.write( &type, sizeof(type) );
+    m_file.write( reinterpret_cast<const char *>(&time), sizeof(time) );
+    m_file.write( reinterpret_cast<const char *>(p_table), p_length * sizeof(double) );
+    
+    // the server is usually ended by a signal, so bound what stays buffered
+    if( now - m_lastFlush >= boost::posix_time::milliseconds(FLUSH_PERIOD) )
+    {
+        m_file.flush();
+        m_lastFlush = now;
+    }
+}
+
+CExchangeReplay::CExchangeReplay( const std::string & p_filename, size_t p_state, size_t p_command )
+    : m_file(p_filename.c_str(), std::ios::binary), m_state(p_state), m_command(p_command)
+{
+    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    boost::uint32_t header[4];
+    
+    if( !m_file.read( reinterpret_cast<char *>(header), sizeof(header) ) )
+    {
+        throw std::runtime_error("cannot read exchange log " + p_filename);
+    }
+    if( header[0] != CExchangeLog::MAGIC || header[1] != CExchangeLog::VERSION )
+    {
+        throw std::runtime_error(p_filename + " is not an exchange log");
+    }
+    if( header[2] != p_state || header[3] != p_command )
+    {
+        throw std::runtime_error(p_filename + " was recorded with other table sizes");
+    }
+}
+
+bool CExchangeReplay::Next( CExchangeLog::ERecord & p_type, boost::uint64_t & p_time,
+    std::vector<double> & p_table )
+{
+    char type;
+    
+    if( !m_file.read( &type, sizeof(type) ) ||
+        !m_file.read( reinterpret_cast<char *>(&p_time), sizeof(p_time) ) )
+    {
+        return false;
+    }
+    
+    if( type == CExchangeLog::RECORD_STATE )
+    {
+        p_type = CExchangeLog::RECORD_STATE;
+        p_table.resize( m_state );
+    }
+    else if( type == CExchangeLog::RECORD_COMMAND )
+    {
+        p_type = CExchangeLog::RECORD_COMMAND;
+        p_table.resize( m_command );
+    }
+    else
+    {
+        Logger::Warn << "Exchange log has a record of unknown type" << std::endl;
+        return false;
+    }
+    
+    if( p_table.empty() )
+    {
+        return true;
+    }
+    return static_cast<bool>( m_file.read( reinterpret_cast<char *>(&p_table[0]),
+        p_table.size() * sizeof(double) ) );
+}
+
+} // namespace simulation
+} // namespace freedm
@@ -25,19 +25,25 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "CLineServer.hpp"
+#include "CLineSession.hpp"
 
 namespace freedm {
 namespace simulation {
 
-CLineServer::TPointer CLineServer::Create( boost::asio::io_service & p_service, unsigned short p_port, TSetCallback p_set, TGetCallback p_get )
+CLineServer::TPointer CLineServer::Create( boost::asio::io_service & p_service, unsigned short p_port,
+    TResolveCallback p_resolve, TSetCallback p_set, TGetCallback p_get, TWaitCallback p_wait,
+    TDoneCallback p_done, TStatsCallback p_stats )
 {
     Logger::Info << __PRETTY_FUNCTION__ << std::endl;
-    return TPointer( new CLineServer(p_service,p_port,p_set,p_get) );
+    return TPointer( new CLineServer(p_service,p_port,p_resolve,p_set,p_get,p_wait,p_done,
+        p_stats) );
 }
 
 CLineServer::CLineServer( boost::asio::io_service & p_service,
-    unsigned short p_port, TSetCallback p_set, TGetCallback p_get )
-    : m_acceptor(p_service), m_socket(p_service), m_set(p_set), m_get(p_get), m_port(p_port)
+    unsigned short p_port, TResolveCallback p_resolve, TSetCallback p_set, TGetCallback p_get,
+    TWaitCallback p_wait, TDoneCallback p_done, TStatsCallback p_stats )
+    : m_service(p_service), m_acceptor(p_service), m_resolve(p_resolve), m_set(p_set)
+    , m_get(p_get), m_wait(p_wait), m_done(p_done), m_stats(p_stats), m_port(p_port)
 {
     Logger::Info << m_port << " - " << __PRETTY_FUNCTION__ << std::endl;
     boost::asio::ip::tcp::endpoint endpoint( boost::asio::ip::tcp::v4(), p_port );
@@ -55,111 +61,29 @@ CLineServer::CLineServer( boost::asio::io_service & p_service,
 CLineServer::~CLineServer()
 {
     Logger::Info << m_port << " - " << __PRETTY_FUNCTION__ << std::endl;
-    // close the socket and acceptor
+    // close the acceptor, open sessions run until their clients disconnect
     if( m_acceptor.is_open() )
     {
         m_acceptor.close();
     }
-    if( m_socket.is_open() )
-    {
-        m_socket.close();
-    }
 }
 
 void CLineServer::StartAccept()
 {
-    Logger::Info << m_port << " - " << __PRETTY_FUNCTION__ << std::endl;
-    // wait for next client connection, open it on m_socket, call MessageHandler
-    m_acceptor.async_accept( m_socket, boost::bind( &CLineServer::MessageHandler,
-        this, boost::asio::placeholders::error ) );
+    TSessionPointer session = CLineSession::Create( m_service,
+        m_port, m_resolve, m_set, m_get, m_wait, m_done, m_stats );
+    
+    // wait for next client connection, open it on the session, call HandleAccept
+    m_acceptor.async_accept( session->Socket(), boost::bind( &CLineServer::HandleAccept,
+        this, session, boost::asio::placeholders::error ) );
 }
 
-void CLineServer::MessageHandler( const boost::system::error_code & p_error )
+void CLineServer::HandleAccept( TSessionPointer p_session, const boost::system::error_code & p_error )
 {
-    Logger::Info << m_port << " - " << __PRETTY_FUNCTION__ << std::endl;
     if( !p_error )
     {
-        boost::asio::streambuf request;
-        std::istream request_stream( &request );
-        std::string request_code, device, key, value;
-        
-        boost::asio::streambuf response;
-        std::ostream response_stream( &response );
-        
-        bool quit = false;
-        size_t bytes;
-        
-        try
-        {
-            while( !quit )
-            {
-                // receive the request stream and get the request type
-                bytes = boost::asio::read_until( m_socket, request, "\r\n" );
-                request_stream >> request_code;
-                
-                Logger::Debug << m_port << " - received " << request_code << std::endl;
-                
-                // handle different message types
-                if( request_code == "GET" )
-                {
-                    // split the request stream
-                    request_stream >> device >> key;
-                    value = m_get(device,key);
-                    
-                    // format the response stream
-                    if( value.empty() )
-                    {
-                        response_stream << "404 ERROR NOTFOUND\r\n";
-                    }
-                    else
-                    {
-                        response_stream << "200 OK " << value << "\r\n";
-                    }
-                    Logger::Debug << m_port << " - returned " << value << " for ("
-                        << device << "," << key << ")" << std::endl;
-                }
-                else if( request_code == "SET" )
-                {
-                    // split the request stream
-                    request_stream >> device >> key >> value;
-
-                    m_set(device,key,value);
-                    
-                    // format the response stream
-                    response_stream << "200 OK\r\n";
-                    Logger::Debug << m_port << " - set " << value << " for ("
-                        << device << "," << key << ")" << std::endl;
-                }
-                else if( request_code == "QUIT" )
-                {
-                    quit = true;
-                    
-                    // format the response stream
-                    response_stream << "200 OK\r\n";
-                }
-                else
-                {
-                    Logger::Warn << m_port << " - received unhandled message" << std::endl;
-                    // unrecognized request type
-                    response_stream << "400 BADREQUEST\r\n";
-                }
-                
-                // send the response stream
-                boost::asio::write( m_socket, response );
-                request.consume( bytes );
-            }
-        }
-        catch( std::exception & e )
-        {
-            // on error, terminate the connection but continue the server
-            std::cerr << "Connection error: " << e.what() << std::endl;
-        }
-        
-        if( m_socket.is_open() )
-        {
-            // close connection
-            m_socket.close();
-        }
+        LOG_DEBUG << m_port << " - accepted connection" << std::endl;
+        p_session->Start();
         
         // wait for next connection
         StartAccept();
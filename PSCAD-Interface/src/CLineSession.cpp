@@ -0,0 +1,429 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CLineSession.cpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @see            CLineSession.hpp
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CLineSession.hpp"
+
+namespace freedm {
+namespace simulation {
+
+CLineSession::TPointer CLineSession::Create( boost::asio::io_service & p_service,
+    unsigned short p_port, CLineServer::TResolveCallback p_resolve,
+    CLineServer::TSetCallback p_set, CLineServer::TGetCallback p_get,
+    CLineServer::TWaitCallback p_wait, CLineServer::TDoneCallback p_done,
+    CLineServer::TStatsCallback p_stats )
+{
+    return TPointer( new CLineSession(p_service,p_port,p_resolve,p_set,p_get,p_wait,p_done,
+        p_stats) );
+}
+
+CLineSession::CLineSession( boost::asio::io_service & p_service, unsigned short p_port,
+    CLineServer::TResolveCallback p_resolve, CLineServer::TSetCallback p_set,
+    CLineServer::TGetCallback p_get, CLineServer::TWaitCallback p_wait,
+    CLineServer::TDoneCallback p_done, CLineServer::TStatsCallback p_stats )
+    : m_service(p_service), m_socket(p_service), m_state(STATE_TEXT), m_resolve(p_resolve)
+    , m_set(p_set), m_get(p_get), m_wait(p_wait), m_done(p_done), m_stats(p_stats), m_port(p_port)
+{
+    // skip
+}
+
+void CLineSession::Start()
+{
+    boost::asio::async_read_until( m_socket, m_request, "\r\n",
+        boost::bind(&CLineSession::HandleLine, shared_from_this(),
+        boost::asio::placeholders::error) );
+}
+
+void CLineSession::HandleLine( const boost::system::error_code & p_error )
+{
+    if( p_error )
+    {
+        Close();
+        return;
+    }
+    
+    std::istream request_stream( &m_request );
+    std::ostream response_stream( &m_response );
+    std::string line, request_code, device, key, value;
+    boost::uint32_t handle;
+    boost::uint64_t version;
+    
+    // take exactly one line, later requests may already be buffered
+    std::getline( request_stream, line );
+    std::istringstream request( line );
+    request >> request_code;
+    
+    TRACE_POINT( LINE_REQUEST, m_port, request_code.empty() ? 0.0 : request_code[0] );
+    LOG_DEBUG << m_port << " - received " << request_code << std::endl;
+    
+    try
+    {
+        // handle different message types
+        if( request_code == "GET" )
+        {
+            // split the request stream
+            request >> device >> key;
+            value = boost::lexical_cast<std::string>( m_get(m_resolve(device,key)) );
+            
+            // format the response stream
+            response_stream << "200 OK " << value << "\r\n";
+            LOG_DEBUG << m_port << " - returned " << value << " for ("
+                << device << "," << key << ")" << std::endl;
+        }
+        else if( request_code == "SET" )
+        {
+            // split the request stream
+            request >> device >> key >> value;
+            
+            m_set( m_resolve(device,key), boost::lexical_cast<double>(value) );
+            
+            // format the response stream
+            response_stream << "200 OK\r\n";
+            LOG_DEBUG << m_port << " - set " << value << " for ("
+                << device << "," << key << ")" << std::endl;
+        }
+        else if( request_code == "RESOLVE" )
+        {
+            // split the request stream
+            request >> device >> key;
+            handle = m_resolve(device,key);
+            
+            // format the response stream
+            response_stream << "200 OK " << handle << "\r\n";
+            LOG_DEBUG << m_port << " - resolved (" << device << ","
+                << key << ") to " << handle << std::endl;
+        }
+        else if( request_code == "GETH" )
+        {
+            // split the request stream
+            if( !(request >> handle) )
+            {
+                throw std::invalid_argument("GETH requires a handle");
+            }
+            value = boost::lexical_cast<std::string>( m_get(handle) );
+            
+            // format the response stream
+            response_stream << "200 OK " << value << "\r\n";
+            LOG_DEBUG << m_port << " - returned " << value << " for "
+                << handle << std::endl;
+        }
+        else if( request_code == "SETH" )
+        {
+            // split the request stream
+            if( !(request >> handle >> value) )
+            {
+                throw std::invalid_argument("SETH requires a handle and value");
+            }
+            
+            m_set( handle, boost::lexical_cast<double>(value) );
+            
+            // format the response stream
+            response_stream << "200 OK\r\n";
+            LOG_DEBUG << m_port << " - set " << value << " for "
+                << handle << std::endl;
+        }
+        else if( request_code == "WAIT" )
+        {
+            // split the request stream
+            if( !(request >> version) )
+            {
+                throw std::invalid_argument("WAIT requires a step version");
+            }
+            
+            // the response is written once the step arrives
+            StartWait( version );
+            return;
+        }
+        else if( request_code == "DONE" )
+        {
+            // split the request stream
+            if( !(request >> version) )
+            {
+                throw std::invalid_argument("DONE requires a step version");
+            }
+            
+            m_done( version );
+            
+            // format the response stream
+            response_stream << "200 OK\r\n";
+            LOG_DEBUG << m_port << " - finished step " << version << std::endl;
+        }
+        else if( request_code == "STATS" )
+        {
+            // format the response stream
+            response_stream << "200 OK " << m_stats() << "\r\n";
+        }
+        else if( request_code == "BINARY" )
+        {
+            // acknowledge before the first binary frame
+            response_stream << "200 OK\r\n";
+            m_state = STATE_BINARY;
+        }
+        else if( request_code == "QUIT" )
+        {
+            // format the response stream
+            response_stream << "200 OK\r\n";
+            m_state = STATE_QUIT;
+        }
+        else
+        {
+            Logger::Warn << m_port << " - received unhandled message" << std::endl;
+            // unrecognized request type
+            response_stream << "400 BADREQUEST\r\n";
+        }
+    }
+    catch( std::exception & e )
+    {
+        // on error, terminate the connection but continue the server
+        std::cerr << "Connection error: " << e.what() << std::endl;
+        Close();
+        return;
+    }
+    
+    // send the response stream
+    boost::asio::async_write( m_socket, m_response,
+        boost::bind(&CLineSession::HandleLineWritten, shared_from_this(),
+        boost::asio::placeholders::error) );
+}
+
+void CLineSession::HandleLineWritten( const boost::system::error_code & p_error )
+{
+    if( p_error || m_state == STATE_QUIT )
+    {
+        Close();
+    }
+    else if( m_state == STATE_BINARY )
+    {
+        LOG_INFO << m_port << " - switched to binary framing" << std::endl;
+        ReadFrame( p_error );
+    }
+    else
+    {
+        Start();
+    }
+}
+
+void CLineSession::ReadFrame( const boost::system::error_code & p_error )
+{
+    if( p_error )
+    {
+        Close();
+        return;
+    }
+    
+    size_t needed = CLineServer::FRAME_SIZE;
+    
+    if( m_request.size() >= CLineServer::FRAME_SIZE )
+    {
+        // the payload length follows the opcode and status
+        const unsigned char * header =
+            boost::asio::buffer_cast<const unsigned char *>( m_request.data() );
+        needed += UnpackInteger( header+2, 2 );
+    }
+    
+    if( m_request.size() >= needed )
+    {
+        HandleFrame();
+    }
+    else
+    {
+        boost::asio::async_read( m_socket, m_request,
+            boost::asio::transfer_at_least(needed - m_request.size()),
+            boost::bind(&CLineSession::ReadFrame, shared_from_this(),
+            boost::asio::placeholders::error) );
+    }
+}
+
+void CLineSession::HandleFrame()
+{
+    unsigned char frame[CLineServer::FRAME_SIZE];
+    
+    m_request.sgetn( reinterpret_cast<char *>(frame), CLineServer::FRAME_SIZE );
+    
+    unsigned char opcode = frame[0];
+    size_t length = UnpackInteger( frame+2, 2 );
+    boost::uint32_t handle = UnpackInteger( frame+4, 4 );
+    boost::uint64_t bits = UnpackInteger( frame+8, 8 );
+    double value;
+    std::memcpy( &value, &bits, sizeof(value) );
+    
+    // the payload follows the header
+    std::string payload( length, '\0' );
+    if( length > 0 )
+    {
+        m_request.sgetn( &payload[0], length );
+    }
+    
+    unsigned char status = CLineServer::STATUS_OK;
+    double result = 0.0;
+    
+    TRACE_POINT( FRAME_REQUEST, handle, opcode );
+    
+    try
+    {
+        if( opcode == CLineServer::OP_RESOLVE )
+        {
+            std::istringstream names( payload );
+            std::string device, key;
+            
+            if( names >> device >> key )
+            {
+                handle = m_resolve( device, key );
+            }
+            else
+            {
+                status = CLineServer::STATUS_BADREQUEST;
+            }
+        }
+        else if( opcode == CLineServer::OP_GET )
+        {
+            result = m_get( handle );
+        }
+        else if( opcode == CLineServer::OP_SET )
+        {
+            m_set( handle, value );
+        }
+        else if( opcode == CLineServer::OP_QUIT )
+        {
+            m_state = STATE_QUIT;
+        }
+        else if( opcode == CLineServer::OP_DONE && value >= 0 )
+        {
+            m_done( static_cast<boost::uint64_t>(value) );
+        }
+        else if( opcode == CLineServer::OP_WAIT && value >= 0 )
+        {
+            // the response frame is written once the step arrives
+            StartWait( static_cast<boost::uint64_t>(value) );
+            return;
+        }
+        else
+        {
+            Logger::Warn << m_port << " - received unhandled frame" << std::endl;
+            status = CLineServer::STATUS_BADREQUEST;
+        }
+    }
+    catch( std::exception & e )
+    {
+        Logger::Warn << m_port << " - request failed: " << e.what() << std::endl;
+        status = CLineServer::STATUS_NOTFOUND;
+    }
+    
+    // respond with a frame of the same type
+    PackFrame( m_frame.data(), opcode, status, 0, handle, result );
+    boost::asio::async_write( m_socket, boost::asio::buffer(m_frame),
+        boost::bind(&CLineSession::HandleFrameWritten, shared_from_this(),
+        boost::asio::placeholders::error) );
+}
+
+void CLineSession::HandleFrameWritten( const boost::system::error_code & p_error )
+{
+    if( p_error || m_state == STATE_QUIT )
+    {
+        Close();
+    }
+    else
+    {
+        ReadFrame( p_error );
+    }
+}
+
+void CLineSession::StartWait( boost::uint64_t p_version )
+{
+    LOG_DEBUG << m_port << " - waiting for step " << p_version+1 << std::endl;
+    m_wait( p_version, boost::bind(&CLineSession::NotifyStep, shared_from_this(), _1) );
+}
+
+void CLineSession::NotifyStep( boost::uint64_t p_version )
+{
+    m_service.post( boost::bind(&CLineSession::HandleStep, shared_from_this(), p_version) );
+}
+
+void CLineSession::HandleStep( boost::uint64_t p_version )
+{
+    LOG_DEBUG << m_port << " - returned step " << p_version << std::endl;
+    
+    if( m_state == STATE_BINARY )
+    {
+        PackFrame( m_frame.data(), CLineServer::OP_WAIT, CLineServer::STATUS_OK, 0,
+            0, static_cast<double>(p_version) );
+        boost::asio::async_write( m_socket, boost::asio::buffer(m_frame),
+            boost::bind(&CLineSession::HandleFrameWritten, shared_from_this(),
+            boost::asio::placeholders::error) );
+    }
+    else
+    {
+        std::ostream response_stream( &m_response );
+        response_stream << "200 OK " << p_version << "\r\n";
+        boost::asio::async_write( m_socket, m_response,
+            boost::bind(&CLineSession::HandleLineWritten, shared_from_this(),
+            boost::asio::placeholders::error) );
+    }
+}
+
+void CLineSession::Close()
+{
+    LOG_DEBUG << m_port << " - closed session" << std::endl;
+    boost::system::error_code error;
+    
+    // no handler is pending, so the session is released on return
+    m_socket.close( error );
+}
+
+void CLineSession::PackFrame( unsigned char * p_frame, unsigned char p_opcode,
+    unsigned char p_status, boost::uint16_t p_length, boost::uint32_t p_handle,
+    double p_value )
+{
+    boost::uint64_t bits;
+    std::memcpy( &bits, &p_value, sizeof(bits) );
+    
+    p_frame[0] = p_opcode;
+    p_frame[1] = p_status;
+    PackInteger( p_frame+2, p_length, 2 );
+    PackInteger( p_frame+4, p_handle, 4 );
+    PackInteger( p_frame+8, bits, 8 );
+}
+
+boost::uint64_t CLineSession::UnpackInteger( const unsigned char * p_data, size_t p_bytes )
+{
+    boost::uint64_t result = 0;
+    for( size_t i = 0; i < p_bytes; i++ )
+    {
+        result = (result << 8) | p_data[i];
+    }
+    return result;
+}
+
+void CLineSession::PackInteger( unsigned char * p_data, boost::uint64_t p_value, size_t p_bytes )
+{
+    for( size_t i = p_bytes; i > 0; i-- )
+    {
+        p_data[i-1] = static_cast<unsigned char>(p_value & 0xFF);
+        p_value >>= 8;
+    }
+}
+
+} // namespace simulation
+} // namespace freedm
@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CMetrics.cpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @see            CMetrics.hpp
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CMetrics.hpp"
+
+#include <sstream>
+#include <algorithm>
+
+namespace freedm {
+namespace simulation {
+
+CHistogram::CHistogram()
+    : m_count(0), m_sum(0), m_max(0)
+{
+    for( size_t i = 0; i < BUCKETS; i++ )
+    {
+        m_buckets[i] = 0;
+    }
+}
+
+void CHistogram::Record( boost::uint64_t p_value )
+{
+    size_t bucket = 0;
+    boost::uint64_t max;
+    
+    // the bucket is the number of bits in the value
+    for( boost::uint64_t value = p_value; value != 0; value >>= 1 )
+    {
+        bucket++;
+    }
+    
+    __sync_fetch_and_add( &m_buckets[bucket], 1 );
+    __sync_fetch_and_add( &m_count, 1 );
+    __sync_fetch_and_add( &m_sum, p_value );
+    
+    // raise the maximum unless another thread raised it further
+    max = m_max;
+    while( p_value > max )
+    {
+        boost::uint64_t seen = __sync_val_compare_and_swap( &m_max, max, p_value );
+        if( seen == max )
+        {
+            break;
+        }
+        max = seen;
+    }
+}
+
+void CHistogram::RecordElapsed( const boost::posix_time::ptime & p_start )
+{
+    boost::posix_time::time_duration elapsed =
+        boost::posix_time::microsec_clock::universal_time() - p_start;
+    Record( static_cast<boost::uint64_t>(std::max<boost::int64_t>(elapsed.total_microseconds(), 0)) );
+}
+
+boost::uint64_t CHistogram::GetCount() const
+{
+    return __sync_fetch_and_add( const_cast<boost::uint64_t *>(&m_count), 0 );
+}
+
+boost::uint64_t CHistogram::GetSum() const
+{
+    return __sync_fetch_and_add( const_cast<boost::uint64_t *>(&m_sum), 0 );
+}
+
+boost::uint64_t CHistogram::GetMax() const
+{
+    return __sync_fetch_and_add( const_cast<boost::uint64_t *>(&m_max), 0 );
+}
+
+boost::uint64_t CHistogram::GetPercentile( double p_fraction ) const
+{
+    boost::uint64_t buckets[BUCKETS];
+    boost::uint64_t total = 0;
+    boost::uint64_t seen = 0;
+    
+    // the percentile is taken over one copy of the buckets
+    for( size_t i = 0; i < BUCKETS; i++ )
+    {
+        buckets[i] = __sync_fetch_and_add( const_cast<boost::uint64_t *>(&m_buckets[i]), 0 );
+        total += buckets[i];
+    }
+    
+    for( size_t i = 0; i < BUCKETS; i++ )
+    {
+        seen += buckets[i];
+        if( seen > 0 && seen >= p_fraction * total )
+        {
+            // bucket i holds the values below 2^i
+            boost::uint64_t bound = i < 64 ? (boost::uint64_t(1) << i) - 1 : ~boost::uint64_t(0);
+            return std::min( bound, GetMax() );
+        }
+    }
+    
+    return 0;
+}
+
+CMetrics::CMetrics()
+    : m_start(boost::posix_time::microsec_clock::universal_time())
+{
+    // skip
+}
+
+void CMetrics::Add( const std::string & p_name, const CCounter & p_counter )
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_counters[p_name] = &p_counter;
+}
+
+void CMetrics::Add( const std::string & p_name, const CHistogram & p_histogram )
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_histograms[p_name] = &p_histogram;
+}
+
+std::string CMetrics::Format()
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    std::map<std::string, const CCounter *>::const_iterator counter;
+    std::map<std::string, const CHistogram *>::const_iterator histogram;
+    std::ostringstream result;
+    
+    result << "uptime_s=" << (boost::posix_time::microsec_clock::universal_time()
+        - m_start).total_seconds();
+    
+    for( counter = m_counters.begin(); counter != m_counters.end(); counter++ )
+    {
+        result << " " << counter->first << "=" << counter->second->Get();
+    }
+    
+    for( histogram = m_histograms.begin(); histogram != m_histograms.end(); histogram++ )
+    {
+        const std::string & name = histogram->first;
+        const CHistogram & value = *histogram->second;
+        
+        result << " " << name << "_count=" << value.GetCount()
+            << " " << name << "_sum=" << value.GetSum()
+            << " " << name << "_p50=" << value.GetPercentile(0.50)
+            << " " << name << "_p99=" << value.GetPercentile(0.99)
+            << " " << name << "_max=" << value.GetMax();
+    }
+    
+    return result.str();
+}
+
+} // namespace simulation
+} // namespace freedm
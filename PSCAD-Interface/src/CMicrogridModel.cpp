@@ -0,0 +1,252 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CMicrogridModel.cpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @see            CMicrogridModel.hpp
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CMicrogridModel.hpp"
+
+namespace freedm {
+namespace simulation {
+
+namespace {
+
+/// rated power of each device type
+const double PV_RATING = 10.0;
+const double LOAD_RATING = 15.0;
+const double DG_RATING = 8.0;
+const double BATTERY_RATING = 5.0;
+
+/// part of the day a full battery lasts at its rated power
+const double BATTERY_DAYS = 0.25;
+
+/// devices are spread over this many phases of the day
+const size_t PHASES = 24;
+
+const double TWO_PI = 2.0 * std::acos(-1.0);
+
+}
+
+const double CMicrogridModel::DAY_LENGTH = 600.0;
+
+CMicrogridModel::CMicrogridModel( const CTableStructure & p_state,
+    const CTableStructure & p_command, double p_step )
+    : m_step(p_step), m_time(0.0)
+{
+    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    
+    std::map<std::string, SDevice> devices;
+    std::map<std::string, SDevice>::iterator it;
+    size_t buses = 1;
+    
+    if( p_step <= 0.0 )
+    {
+        throw std::invalid_argument("the model step must be positive");
+    }
+    
+    for( size_t i = 0; i < p_state.GetSize(); i++ )
+    {
+        const CDeviceKey & dkey = p_state.FindDevice(i);
+        const std::string & name = dkey.GetDevice();
+        
+        it = devices.find(name);
+        if( it == devices.end() )
+        {
+            // the device type is the name up to its number
+            std::string type = name.substr( 0, name.find_first_of("0123456789_") );
+            SDevice device;
+            
+            if( type == "pv" )
+            {
+                device.m_type = TYPE_PV;
+                device.m_rating = PV_RATING;
+            }
+            else if( type == "load" )
+            {
+                device.m_type = TYPE_LOAD;
+                device.m_rating = LOAD_RATING;
+            }
+            else if( type == "dg" )
+            {
+                device.m_type = TYPE_DG;
+                device.m_rating = DG_RATING;
+            }
+            else if( type == "battery" )
+            {
+                device.m_type = TYPE_BATTERY;
+                device.m_rating = BATTERY_RATING;
+            }
+            else if( type == "grid" )
+            {
+                device.m_type = TYPE_GRID;
+                device.m_rating = 0.0;
+            }
+            else
+            {
+                Logger::Warn << "The model has no device type for " << dkey << std::endl;
+                continue;
+            }
+            
+            device.m_bus = p_state.FindParent(i);
+            device.m_power = NO_ENTRY;
+            device.m_charge = NO_ENTRY;
+            device.m_phase = TWO_PI * (devices.size() % PHASES) / PHASES;
+            device.m_charged = 0.5;
+            
+            try
+            {
+                device.m_switch = p_command.FindIndex( CDeviceKey(name,"onOffSwitch") );
+            }
+            catch( std::out_of_range & )
+            {
+                // a device without a switch is always on
+                device.m_switch = NO_ENTRY;
+            }
+            
+            buses = std::max( buses, device.m_bus + 1 );
+            it = devices.insert( std::make_pair(name, device) ).first;
+        }
+        
+        if( dkey.GetKey() == "powerLevel" )
+        {
+            it->second.m_power = i;
+        }
+        else if( dkey.GetKey() == "stateOfCharge" && it->second.m_type == TYPE_BATTERY )
+        {
+            it->second.m_charge = i;
+        }
+        else
+        {
+            Logger::Warn << "The model does not write " << dkey << std::endl;
+        }
+    }
+    
+    // the passes of a step need the devices grouped by their role
+    for( it = devices.begin(); it != devices.end(); it++ )
+    {
+        if( it->second.m_type == TYPE_BATTERY )
+        {
+            m_storage.push_back( it->second );
+        }
+        else if( it->second.m_type == TYPE_GRID )
+        {
+            m_links.push_back( it->second );
+        }
+        else
+        {
+            m_sources.push_back( it->second );
+        }
+    }
+    m_demand.resize( buses );
+    
+    Logger::Notice << "The model has " << GetDeviceCount() << " devices" << std::endl;
+}
+
+void CMicrogridModel::Step( const double * p_command, double * p_state )
+{
+    double day, power, capacity;
+    
+    m_time += m_step;
+    day = TWO_PI * m_time / DAY_LENGTH;
+    std::fill( m_demand.begin(), m_demand.end(), 0.0 );
+    
+    for( size_t i = 0; i < m_sources.size(); i++ )
+    {
+        const SDevice & device = m_sources[i];
+        power = 0.0;
+        
+        if( IsOn( device, p_command ) )
+        {
+            if( device.m_type == TYPE_PV )
+            {
+                power = device.m_rating * std::max( 0.0, std::sin(day + device.m_phase) );
+            }
+            else if( device.m_type == TYPE_LOAD )
+            {
+                power = device.m_rating * (0.8 + 0.2 * std::sin(day + device.m_phase));
+            }
+            else
+            {
+                power = device.m_rating;
+            }
+        }
+        
+        m_demand[device.m_bus] += ( device.m_type == TYPE_LOAD ? power : -power );
+        if( device.m_power != NO_ENTRY )
+        {
+            p_state[device.m_power] = power;
+        }
+    }
+    
+    for( size_t i = 0; i < m_storage.size(); i++ )
+    {
+        SDevice & device = m_storage[i];
+        capacity = device.m_rating * BATTERY_DAYS * DAY_LENGTH;
+        power = 0.0;
+        
+        if( IsOn( device, p_command ) )
+        {
+            // discharge into a deficit and charge from a surplus
+            power = std::max( -device.m_rating, std::min( device.m_rating,
+                m_demand[device.m_bus] ) );
+            power = std::min( power, device.m_charged * capacity / m_step );
+            power = std::max( power, (device.m_charged - 1.0) * capacity / m_step );
+            device.m_charged -= power * m_step / capacity;
+        }
+        
+        m_demand[device.m_bus] -= power;
+        if( device.m_power != NO_ENTRY )
+        {
+            p_state[device.m_power] = power;
+        }
+        if( device.m_charge != NO_ENTRY )
+        {
+            p_state[device.m_charge] = device.m_charged;
+        }
+    }
+    
+    for( size_t i = 0; i < m_links.size(); i++ )
+    {
+        const SDevice & device = m_links[i];
+        power = ( IsOn( device, p_command ) ? m_demand[device.m_bus] : 0.0 );
+        
+        m_demand[device.m_bus] -= power;
+        if( device.m_power != NO_ENTRY )
+        {
+            p_state[device.m_power] = power;
+        }
+    }
+}
+
+size_t CMicrogridModel::GetDeviceCount() const
+{
+    return m_sources.size() + m_storage.size() + m_links.size();
+}
+
+bool CMicrogridModel::IsOn( const SDevice & p_device, const double * p_command )
+{
+    return( p_device.m_switch == NO_ENTRY || p_command[p_device.m_switch] == 0.0 );
+}
+
+} // namespace simulation
+} // namespace freedm
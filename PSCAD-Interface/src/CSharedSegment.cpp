@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CSharedSegment.cpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @see            CSharedSegment.hpp
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CSharedSegment.hpp"
+
+namespace freedm {
+namespace simulation {
+
+CSharedSegment::CSharedSegment( const std::string & p_name, size_t p_state, size_t p_command )
+    : m_name(p_name), m_size(PSCAD_SHM_SIZE(p_state,p_command)), m_header(0)
+{
+    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    int fd;
+    void * address;
+    
+    // a stale segment from an earlier run would have the wrong layout
+    shm_unlink( m_name.c_str() );
+    
+    if( (fd = shm_open( m_name.c_str(), O_CREAT | O_RDWR, 0600 )) == -1 )
+    {
+        throw std::runtime_error("shm_open " + m_name + ": " + std::strerror(errno));
+    }
+    if( ftruncate( fd, m_size ) == -1 )
+    {
+        close(fd);
+        shm_unlink( m_name.c_str() );
+        throw std::runtime_error("ftruncate " + m_name + ": " + std::strerror(errno));
+    }
+    
+    address = mmap( 0, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    close(fd);
+    
+    if( address == MAP_FAILED )
+    {
+        shm_unlink( m_name.c_str() );
+        throw std::runtime_error("mmap " + m_name + ": " + std::strerror(errno));
+    }
+    
+    // the tables are zero from ftruncate, the magic is written last
+    m_header = static_cast<pscad_shm_header *>(address);
+    m_header->version = PSCAD_SHM_VERSION;
+    m_header->state_length = p_state;
+    m_header->command_length = p_command;
+    m_header->state_seq = 0;
+    m_header->command_seq = 0;
+    __sync_synchronize();
+    m_header->magic = PSCAD_SHM_MAGIC;
+    
+    Logger::Notice << "PSCAD may use shared memory " << m_name << std::endl;
+}
+
+CSharedSegment::~CSharedSegment()
+{
+    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    munmap( m_header, m_size );
+    shm_unlink( m_name.c_str() );
+}
+
+bool CSharedSegment::WaitForState( unsigned int p_seen, long p_usec )
+{
+    pscad_shm_wait( &m_header->state_seq, p_seen, p_usec );
+    return( m_header->state_seq != p_seen );
+}
+
+unsigned int CSharedSegment::ReadState( double * p_state )
+{
+    return pscad_shm_read( &m_header->state_seq, p_state,
+        PSCAD_SHM_STATE(m_header), m_header->state_length );
+}
+
+void CSharedSegment::WriteCommand( const double * p_command )
+{
+    pscad_shm_write( &m_header->command_seq, PSCAD_SHM_COMMAND(m_header),
+        p_command, m_header->command_length );
+}
+
+} // namespace simulation
+} // namespace freedm
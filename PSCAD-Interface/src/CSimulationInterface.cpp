@@ -30,35 +30,122 @@ namespace freedm {
 namespace simulation {
 
 CSimulationInterface::TPointer CSimulationInterface::Create( boost::asio::io_service & p_service,
-    CDeviceTable & p_command, CDeviceTable & p_state, unsigned short p_port, size_t p_index )
+    CDeviceTable & p_command, CDeviceTable & p_state, CStepBarrier & p_barrier,
+    CMetrics & p_metrics, unsigned short p_port, size_t p_index )
 {
     Logger::Info << __PRETTY_FUNCTION__ << std::endl;
-    return TPointer( new CSimulationInterface(p_service,p_command,p_state,p_port,p_index) );
+    return TPointer( new CSimulationInterface(p_service,p_command,p_state,p_barrier,
+        p_metrics,p_port,p_index) );
 }
 
 CSimulationInterface::CSimulationInterface( boost::asio::io_service & p_service,
-    CDeviceTable & p_command, CDeviceTable & p_state, unsigned short p_port, size_t p_index )
-    : m_command(p_command), m_state(p_state), m_index(p_index)
+    CDeviceTable & p_command, CDeviceTable & p_state, CStepBarrier & p_barrier,
+    CMetrics & p_metrics, unsigned short p_port, size_t p_index )
+    : m_command(p_command), m_state(p_state), m_barrier(p_barrier), m_metrics(p_metrics)
+    , m_index(p_index)
 {
     Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    std::string prefix = "sst" + boost::lexical_cast<std::string>(p_index);
+    
+    const CTableStructure & state = m_state.GetStructure();
+    const CTableStructure & command = m_command.GetStructure();
+    std::map<CDeviceKey, boost::uint32_t>::iterator it;
+    SHandle empty = { NO_ENTRY, NO_ENTRY };
+    
+    // assign a handle to each state variable this interface may read
+    for( size_t i = 0; i < state.GetSize(); i++ )
+    {
+        if( state.HasAccess(i,m_index) )
+        {
+            m_names[state.FindDevice(i)] = m_handles.size();
+            m_handles.push_back(empty);
+            m_handles.back().m_state = i;
+        }
+    }
+    
+    // extend the handles with each command variable this interface may write
+    for( size_t i = 0; i < command.GetSize(); i++ )
+    {
+        if( command.HasAccess(i,m_index) )
+        {
+            const CDeviceKey & dkey = command.FindDevice(i);
+            it = m_names.find(dkey);
+            if( it == m_names.end() )
+            {
+                it = m_names.insert( std::make_pair(dkey,m_handles.size()) ).first;
+                m_handles.push_back(empty);
+            }
+            m_handles[it->second].m_command = i;
+        }
+    }
+    
     m_server = CLineServer::Create( p_service, p_port,
-        boost::bind(&CSimulationInterface::Set, boost::ref(*this), _1, _2, _3),
-        boost::bind(&CSimulationInterface::Get, boost::ref(*this), _1, _2) );
+        boost::bind(&CSimulationInterface::Resolve, boost::ref(*this), _1, _2),
+        boost::bind(&CSimulationInterface::Set, boost::ref(*this), _1, _2),
+        boost::bind(&CSimulationInterface::Get, boost::ref(*this), _1),
+        boost::bind(&CSimulationInterface::Wait, boost::ref(*this), _1, _2),
+        boost::bind(&CSimulationInterface::Done, boost::ref(*this), _1),
+        boost::bind(&CSimulationInterface::Stats, boost::ref(*this)) );
+    m_metrics.Add( prefix + "_get", m_gets );
+    m_metrics.Add( prefix + "_set", m_sets );
+    m_metrics.Add( prefix + "_wait", m_waits );
+    m_metrics.Add( prefix + "_done", m_dones );
     Logger::Notice << "DGI-Interface " << p_index << " will use port " << p_port << std::endl;
 }
 
-void CSimulationInterface::Set( const std::string & p_device, const std::string & p_key, const std::string & p_value )
+boost::uint32_t CSimulationInterface::Resolve( const std::string & p_device, const std::string & p_key )
 {
-    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
-    double value = boost::lexical_cast<double>(p_value);
-    m_command.SetValue( CDeviceKey(p_device,p_key), m_index, value );
+    std::map<CDeviceKey, boost::uint32_t>::const_iterator it;
+    std::stringstream error;
+    
+    it = m_names.find( CDeviceKey(p_device,p_key) );
+    if( it == m_names.end() )
+    {
+        error << m_index << " does not have access to " << CDeviceKey(p_device,p_key);
+        throw std::out_of_range( error.str() );
+    }
+    return it->second;
 }
 
-std::string CSimulationInterface::Get( const std::string & p_device, const std::string & p_key )
+void CSimulationInterface::Set( boost::uint32_t p_handle, double p_value )
 {
-    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
-    double value = m_state.GetValue( CDeviceKey(p_device,p_key), m_index );
-    return boost::lexical_cast<std::string>(value);
+    TRACE_POINT( HANDLE_SET, p_handle, p_value );
+    m_sets.Increment();
+    
+    if( p_handle >= m_handles.size() || m_handles[p_handle].m_command == NO_ENTRY )
+    {
+        throw std::out_of_range("handle has no command entry");
+    }
+    m_command.SetEntry( m_handles[p_handle].m_command, p_value );
+}
+
+double CSimulationInterface::Get( boost::uint32_t p_handle )
+{
+    TRACE_POINT( HANDLE_GET, p_handle, 0.0 );
+    m_gets.Increment();
+    
+    if( p_handle >= m_handles.size() || m_handles[p_handle].m_state == NO_ENTRY )
+    {
+        throw std::out_of_range("handle has no state entry");
+    }
+    return m_state.GetEntry( m_handles[p_handle].m_state );
+}
+
+void CSimulationInterface::Wait( boost::uint64_t p_version, CLineServer::TStepCallback p_callback )
+{
+    m_waits.Increment();
+    m_state.AsyncWait( p_version, p_callback );
+}
+
+void CSimulationInterface::Done( boost::uint64_t p_version )
+{
+    m_dones.Increment();
+    m_barrier.Acknowledge( m_index, p_version );
+}
+
+std::string CSimulationInterface::Stats()
+{
+    return m_metrics.Format();
 }
 
 } // namespace simulation
@@ -29,50 +29,119 @@
 namespace freedm {
 namespace simulation {
 
-CSimulationServer::CSimulationServer( const std::string & p_xml, unsigned short p_port )
-    : m_port(p_port), m_command(p_xml,"command"), m_state(p_xml,"state"), m_quit(false)
+CSimulationServer::CSimulationServer( const SServerOptions & p_options )
+    : m_options(p_options), m_layout(p_options.m_xml, p_options.m_layoutCache)
+    , m_command(m_layout,"command"), m_state(m_layout,"state"), m_quit(false)
 {
     Logger::Info << __PRETTY_FUNCTION__ << std::endl;
     
-    // read the xml input file
-    boost::property_tree::ptree xmlTree;
-    boost::property_tree::read_xml( p_xml, xmlTree );
-    size_t interfaces = xmlTree.get<size_t>("SSTCount");
-    std::list<boost::shared_ptr<boost::thread> > thread_pool;
+    size_t interfaces = m_layout.GetSSTCount();
+    
+    m_state.AddMetrics( m_metrics, "state" );
+    m_command.AddMetrics( m_metrics, "command" );
+    m_metrics.Add( "pscad_state_exchanges", m_stateExchanges );
+    m_metrics.Add( "pscad_command_exchanges", m_commandExchanges );
+    m_metrics.Add( "pscad_state_bytes", m_stateBytes );
+    m_metrics.Add( "pscad_command_bytes", m_commandBytes );
+    m_metrics.Add( "state_writer_hold_us", m_writerHold );
+    m_metrics.Add( "lockstep_wait_us", m_barrierWait );
+    
+    // every interface acknowledges its steps, lockstep mode waits on them
+    m_barrier.reset( new CStepBarrier(interfaces, m_options.m_lockstepTimeout) );
 
     // start each interface with a unique port / identifier
     for( size_t i = 1; i <= interfaces; i++ )
     {
-        thread_pool.push_back(boost::make_shared<boost::thread>(&CSimulationServer::StartDGIProcess, this, p_port+i, i
-));
+        m_interface.push_back( CSimulationInterface::Create(m_service, m_command,
+            m_state, *m_barrier, m_metrics, m_options.m_port+i, i) );
 
         Logger::Notice << "Initialized DGI-Interface " << i << std::endl;
     }
     
-    // start the simulation server
-    m_thread = boost::thread( &CSimulationServer::Run, this );
-    Logger::Notice << "Running PSCAD Interface" << std::endl;
+    //hard code command table's initial state.  Will let xml handle this later
+    //the replay and the simulation exchanges both start from it
+
+    //power to main grid would initially be disconnected (breaker engaged)
+    m_command.m_data[0] = 1;
+    m_command.m_data[4] = 1;
+
+    //diesel generator would initially be OFF
+    m_command.m_data[3] = 1;
+    m_command.m_data[7] = 1;
+
+    //load and battery would initilally be ON
+    m_command.m_data[1] = 0;
+    m_command.m_data[2] = 0;
+    m_command.m_data[5] = 0;
+    m_command.m_data[6] = 0;
+    
+    if( !m_options.m_record.empty() )
+    {
+        m_log.reset( new CExchangeLog(m_options.m_record, m_state.m_length,
+            m_command.m_length) );
+    }
+    
+    if( !m_options.m_replay.empty() )
+    {
+        // the replay stands in for the simulation
+        m_replay.reset( new CExchangeReplay(m_options.m_replay, m_state.m_length,
+            m_command.m_length) );
+        m_replayThread = boost::thread( &CSimulationServer::RunReplay, this );
+        Logger::Notice << "Replaying " << m_options.m_replay << std::endl;
+    }
+    else if( m_options.m_model )
+    {
+        // the model stands in for the simulation
+        m_model.reset( new CMicrogridModel(m_state.GetStructure(), m_command.GetStructure(),
+            m_options.m_modelRate > 0 ? 1.0 / m_options.m_modelRate : 0.001) );
+        m_modelThread = boost::thread( &CSimulationServer::RunModel, this );
+        Logger::Notice << "Running the microgrid model" << std::endl;
+    }
+    else
+    {
+        // start the simulation server
+        m_thread = boost::thread( &CSimulationServer::Run, this );
+        Logger::Notice << "Running PSCAD Interface" << std::endl;
+        
+        if( !m_options.m_shm.empty() )
+        {
+            m_segment.reset( new CSharedSegment(m_options.m_shm, m_state.m_length,
+                m_command.m_length) );
+            m_sharedThread = boost::thread( &CSimulationServer::RunSharedMemory, this );
+        }
+    }
+    
+    if( m_options.m_statsPeriod > 0 )
+    {
+        m_statsThread = boost::thread( &CSimulationServer::RunStats, this );
+    }
+    
+    // every interface shares one pool of threads on the i/o service
+    size_t threads = std::max( boost::thread::hardware_concurrency(), 1u );
+    for( size_t i = 1; i < threads; i++ )
+    {
+        m_pool.create_thread( boost::bind(&boost::asio::io_service::run, &m_service) );
+    }
+    Logger::Notice << "DGI-Interfaces use " << threads << " threads" << std::endl;
     
     // start i/o service
     m_service.run();
+    m_pool.join_all();
 }
 
-void CSimulationServer::StartDGIProcess(unsigned short p_port,size_t p_index)
-{
-  boost::asio::io_service dgi_service;
-  
-  CSimulationInterface::TPointer dgi=CSimulationInterface::Create(dgi_service, m_command, m_state, p_port, p_index);
-  dgi_service.run();
-}
-
-
-
 CSimulationServer::~CSimulationServer()
 {
     Logger::Info << __PRETTY_FUNCTION__ << std::endl;
     
     // wait on the worker
     m_thread.join();
+    m_sharedThread.join();
+    m_replayThread.join();
+    m_modelThread.join();
+    
+    // the stats thread sleeps until interrupted
+    m_statsThread.interrupt();
+    m_statsThread.join();
 }
 
 void CSimulationServer::Stop()
@@ -81,36 +150,23 @@ void CSimulationServer::Stop()
     
     m_quit = true;
     m_service.stop();
+    
+    if( m_log )
+    {
+        m_log->Flush();
+    }
 }
 
 void CSimulationServer::Run()
 {
-    //hard code command table's initial state.  Will let xml handle this later
-
-    //power to main grid would initially be disconnected (breaker engaged)
-    m_command.m_data[0] = 1;
-    m_command.m_data[4] = 1;
-
-    //diesel generator would initially be OFF
-    m_command.m_data[3] = 1;
-    m_command.m_data[7] = 1;
-
-    //load and battery would initilally be ON
-    m_command.m_data[1] = 0;
-    m_command.m_data[2] = 0;
-    m_command.m_data[5] = 0;
-    m_command.m_data[6] = 0;
-    
     Logger::Info << __PRETTY_FUNCTION__ << std::endl;
     
-    boost::array<char,HEADER_SIZE> header;
-
     // create an acceptor on the shared I/O service
     boost::asio::ip::tcp::acceptor acceptor( m_service );
     
     // create an endpoint for IPv4 with m_port as a port number
-    boost::asio::ip::tcp::endpoint endpoint( boost::asio::ip::tcp::v4(), m_port );
-    Logger::Notice << "PSCAD will use port " << m_port << std::endl;
+    boost::asio::ip::tcp::endpoint endpoint( boost::asio::ip::tcp::v4(), m_options.m_port );
+    Logger::Notice << "PSCAD will use port " << m_options.m_port << std::endl;
     
     // open the acceptor at the endpoint
     acceptor.open( endpoint.protocol() );
@@ -122,49 +178,430 @@ void CSimulationServer::Run()
     {
         // TODO: this blocks - makes m_quit rather pointless
         // create and accept the client connection
-        boost::asio::ip::tcp::socket socket( m_service );
-        acceptor.accept(socket);
+        TSocket socket( new boost::asio::ip::tcp::socket(m_service) );
+        acceptor.accept(*socket);
         
-        // read the header of the next received packet
-        boost::asio::read( socket, boost::asio::buffer(header) );
+        // the send and receive components each hold a session of their own,
+        // detached so that clients which reconnect every step leak no threads
+        boost::thread session( boost::bind(&CSimulationServer::Session, this, socket) );
+        session.detach();
+    }
+}
 
-	//hard code the null character
-	header[3]='\0';
+void CSimulationServer::Session( TSocket p_socket )
+{
+    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    
+    boost::array<char,HEADER_SIZE> header;
+    boost::system::error_code error;
+    std::vector<double> command;
+    std::vector<double> sent;
+    std::vector<double> recorded;
+    std::vector<boost::uint32_t> index;
+    std::vector<double> value;
+    std::vector<boost::asio::const_buffer> response;
+    boost::uint32_t count;
+    
+    try
+    {
+        while( !m_quit )
+        {
+            // read the header of the next received packet
+            boost::asio::read( *p_socket, boost::asio::buffer(header), error );
+            
+            if( error == boost::asio::error::eof )
+            {
+                // the simulation closed the session
+                break;
+            }
+            else if( error )
+            {
+                throw boost::system::system_error(error);
+            }
+            
+            //hard code the null character
+            header[3]='\0';
+            
+            TRACE_POINT( PSCAD_REQUEST, 0, header[0] );
+            LOG_DEBUG << "PSCAD - received " << header.data() << std::endl;
+            
+            // message handler based on header type
+            if( strcmp( header.data(), "GET" ) == 0 )
+            {
+                if( m_options.m_lockstep )
+                {
+                    // hold the commands until the SSTs finish the last step
+                    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+                    m_barrier->Wait();
+                    m_barrierWait.RecordElapsed( start );
+                }
+                
+                // copy the command table so the socket write holds no lock
+                m_command.Snapshot( command );
+                
+                // write the command table as a response
+                boost::asio::write( *p_socket, boost::asio::buffer(command) );
+                m_commandExchanges.Increment();
+                m_commandBytes.Record( command.size() * sizeof(double) );
+                
+                if( m_log )
+                {
+                    m_log->RecordCommand( &command[0] );
+                }
+                sent.swap( command );
+            }
+            else if( strcmp( header.data(), "DGT" ) == 0 )
+            {
+                if( m_options.m_lockstep )
+                {
+                    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+                    m_barrier->Wait();
+                    m_barrierWait.RecordElapsed( start );
+                }
+                
+                m_command.Snapshot( command );
+                index.clear();
+                value.clear();
+                
+                // list the entries that changed since the last table sent
+                for( size_t i = 0; i < command.size(); i++ )
+                {
+                    if( i >= sent.size() ||
+                        std::memcmp( &command[i], &sent[i], sizeof(double) ) != 0 )
+                    {
+                        index.push_back( i );
+                        value.push_back( command[i] );
+                    }
+                }
+                count = index.size();
+                
+                // write the count, the changed entries and their values
+                response.clear();
+                response.push_back( boost::asio::buffer(&count, sizeof(count)) );
+                response.push_back( boost::asio::buffer(index) );
+                response.push_back( boost::asio::buffer(value) );
+                boost::asio::write( *p_socket, response );
+                m_commandExchanges.Increment();
+                m_commandBytes.Record( boost::asio::buffer_size(response) );
+                
+                if( m_log )
+                {
+                    m_log->RecordCommand( &command[0] );
+                }
+                sent.swap( command );
+            }
+            else if( strcmp( header.data(), "DST" ) == 0 )
+            {
+                // read the changed entries before taking the writer lock
+                boost::asio::read( *p_socket, boost::asio::buffer(&count, sizeof(count)) );
+                if( count > m_state.m_length )
+                {
+                    throw std::out_of_range("delta is larger than the state table");
+                }
+                index.resize( count );
+                value.resize( count );
+                boost::asio::read( *p_socket, boost::asio::buffer(index) );
+                boost::asio::read( *p_socket, boost::asio::buffer(value) );
+                
+                boost::unique_lock<boost::mutex> lock(m_state.m_writer);
+                boost::posix_time::ptime held = boost::posix_time::microsec_clock::universal_time();
+                m_state.ApplyDelta( index, value );
+                
+                if( m_log )
+                {
+                    recorded.assign( m_state.m_back, m_state.m_back + m_state.m_length );
+                }
+                
+                m_state.Publish();
+                m_barrier->Publish( m_state.GetVersion() );
+                lock.unlock();
+                m_writerHold.RecordElapsed( held );
+                
+                if( m_log )
+                {
+                    m_log->RecordState( &recorded[0] );
+                }
+                
+                m_stateExchanges.Increment();
+                m_stateBytes.Record( sizeof(count) + count*(sizeof(boost::uint32_t)+sizeof(double)) );
+                LOG_DEBUG << "PSCAD - published " << count << " changed states" << std::endl;
+            }
+            else if( strcmp( header.data(), "SET" ) == 0)
+            {
+                boost::unique_lock<boost::mutex> lock(m_state.m_writer);
+                boost::posix_time::ptime held = boost::posix_time::microsec_clock::universal_time();
+                size_t bytes = m_state.m_length * sizeof(double);
+                
+                // read the message body into the back buffer of the state table
+                m_state.BeginFullUpdate();
+                boost::asio::read( *p_socket, boost::asio::buffer(m_state.m_back, bytes) );
+                
+                if( m_log )
+                {
+                    recorded.assign( m_state.m_back, m_state.m_back + m_state.m_length );
+                }
+                
+                m_state.Publish();
+                m_barrier->Publish( m_state.GetVersion() );
+                lock.unlock();
+                m_writerHold.RecordElapsed( held );
+                
+                if( m_log )
+                {
+                    m_log->RecordState( &recorded[0] );
+                }
+                
+                m_stateExchanges.Increment();
+                m_stateBytes.Record( bytes );
+                LOG_DEBUG << "PSCAD - published state table" << std::endl;
+            }
+            else if( strcmp( header.data(), "QUIT" ) == 0 )
+            {
+                Stop();
+            }
+            else
+            {
+                Logger::Warn << "PSCAD - received unhandled message" << std::endl;
+                // bad header
+            }
+        }
+    }
+    catch( std::exception & e )
+    {
+        // the simulation reconnects with a new session
+        Logger::Warn << "PSCAD - session error: " << e.what() << std::endl;
+    }
+    
+    p_socket->close( error );
+    Logger::Info << "PSCAD - session closed" << std::endl;
+}
+
+void CSimulationServer::RunSharedMemory()
+{
+    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    
+    std::vector<double> command;
+    std::vector<double> recorded;
+    unsigned int seen = 0;
+    bool stepped;
+    
+    while( !m_quit )
+    {
+        stepped = m_segment->WaitForState( seen, m_options.m_sharedPoll );
+        
+        if( stepped )
+        {
+            boost::unique_lock<boost::mutex> lock(m_state.m_writer);
+            boost::posix_time::ptime held = boost::posix_time::microsec_clock::universal_time();
+            
+            // copy the step into the back buffer of the state table
+            m_state.BeginFullUpdate();
+            seen = m_segment->ReadState( m_state.m_back );
+            
+            if( m_log )
+            {
+                recorded.assign( m_state.m_back, m_state.m_back + m_state.m_length );
+            }
+            
+            m_state.Publish();
+            LOG_DEBUG << "PSCAD - published shared state " << seen << std::endl;
+            m_barrier->Publish( m_state.GetVersion() );
+            lock.unlock();
+            m_writerHold.RecordElapsed( held );
+            
+            if( m_log )
+            {
+                m_log->RecordState( &recorded[0] );
+            }
+            
+            m_stateExchanges.Increment();
+            m_stateBytes.Record( m_state.m_length * sizeof(double) );
+            
+            if( m_options.m_lockstep )
+            {
+                boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+                m_barrier->Wait();
+                m_barrierWait.RecordElapsed( start );
+            }
+        }
+        
+        // the simulation reads the command table without waiting
+        m_command.Snapshot( command );
+        m_segment->WriteCommand( &command[0] );
+        m_commandExchanges.Increment();
+        m_commandBytes.Record( command.size() * sizeof(double) );
+        
+        // record one command table per step rather than per poll
+        if( stepped && m_log )
+        {
+            m_log->RecordCommand( &command[0] );
+        }
+    }
+}
 
-        Logger::Debug << "PSCAD - received " << header.data() << std::endl;
+void CSimulationServer::RunReplay()
+{
+    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    
+    using namespace boost::posix_time;
+    
+    CExchangeLog::ERecord type;
+    boost::uint64_t time;
+    std::vector<double> table;
+    std::vector<double> command;
+    ptime start;
+    ptime held;
+    size_t steps = 0;
+    
+    // brokers that have not joined the lockstep barrier are not waited on
+    boost::this_thread::sleep( milliseconds(m_options.m_replayDelay) );
+    start = microsec_clock::universal_time();
+    
+    while( !m_quit && m_replay->Next( type, time, table ) )
+    {
+        if( type != CExchangeLog::RECORD_STATE )
+        {
+            continue;
+        }
+        
+        if( !m_options.m_replayFast )
+        {
+            // keep the recorded spacing between steps
+            boost::this_thread::sleep( start + microseconds(time) );
+        }
         
-        // message handler based on header type
-        if( strcmp( header.data(), "GET" ) == 0 )
         {
-            boost::shared_lock<boost::shared_mutex> lock(m_command.m_mutex);
-            Logger::Debug << "PSCAD - obtained mutex as reader" << std::endl;
-            size_t bytes = m_command.m_length * sizeof(double);
+            boost::unique_lock<boost::mutex> lock(m_state.m_writer);
+            held = microsec_clock::universal_time();
             
-            // write the command table as a response
-            boost::asio::write( socket, boost::asio::buffer(m_command.m_data, bytes) );
-            Logger::Debug << "PSCAD - released reader mutex" << std::endl;
+            m_state.BeginFullUpdate();
+            std::copy( table.begin(), table.end(), m_state.m_back );
+            
+            m_state.Publish();
+            m_barrier->Publish( m_state.GetVersion() );
+        }
+        m_writerHold.RecordElapsed( held );
+        steps++;
+        
+        if( m_log )
+        {
+            m_log->RecordState( &table[0] );
+        }
+        
+        m_stateExchanges.Increment();
+        m_stateBytes.Record( m_state.m_length * sizeof(double) );
+        
+        if( m_options.m_lockstep )
+        {
+            ptime wait = microsec_clock::universal_time();
+            m_barrier->Wait();
+            m_barrierWait.RecordElapsed( wait );
+        }
+        
+        if( m_log )
+        {
+            m_command.Snapshot( command );
+            m_log->RecordCommand( &command[0] );
         }
-        else if( strcmp( header.data(), "SET" ) == 0)
+    }
+    
+    time_duration elapsed = microsec_clock::universal_time() - start;
+    Logger::Notice << "Replayed " << steps << " steps in " << elapsed.total_milliseconds()
+        << " ms" << std::endl;
+    
+    Stop();
+}
+
+void CSimulationServer::RunModel()
+{
+    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    
+    using namespace boost::posix_time;
+    
+    std::vector<double> command;
+    std::vector<double> recorded;
+    time_duration period = microseconds(0);
+    ptime next = microsec_clock::universal_time();
+    ptime now;
+    ptime held;
+    
+    if( m_options.m_modelRate > 0 )
+    {
+        period = microseconds( static_cast<long>(1e6 / m_options.m_modelRate) );
+    }
+    
+    while( !m_quit )
+    {
+        // the model consumes one command table per step
+        m_command.Snapshot( command );
+        m_commandExchanges.Increment();
+        m_commandBytes.Record( command.size() * sizeof(double) );
+        
         {
-            boost::unique_lock<boost::shared_mutex> lock(m_state.m_mutex);
-            Logger::Debug << "PSCAD - obtained mutex as writer" << std::endl;
-            size_t bytes = m_state.m_length * sizeof(double);
+            boost::unique_lock<boost::mutex> lock(m_state.m_writer);
+            held = microsec_clock::universal_time();
+            
+            m_state.BeginFullUpdate();
+            m_model->Step( &command[0], m_state.m_back );
             
-            // read the message body into the state table
-            boost::asio::read( socket, boost::asio::buffer(m_state.m_data, bytes) );
-            Logger::Debug << "PSCAD - released writer mutex" << std::endl;
+            if( m_log )
+            {
+                recorded.assign( m_state.m_back, m_state.m_back + m_state.m_length );
+            }
+            
+            m_state.Publish();
+            m_barrier->Publish( m_state.GetVersion() );
         }
-        else if( strcmp( header.data(), "QUIT" ) == 0 )
+        m_writerHold.RecordElapsed( held );
+        
+        if( m_log )
         {
-            Stop();
+            m_log->RecordState( &recorded[0] );
+            m_log->RecordCommand( &command[0] );
         }
-        else
+        
+        m_stateExchanges.Increment();
+        m_stateBytes.Record( m_state.m_length * sizeof(double) );
+        
+        if( m_options.m_lockstep )
         {
-            Logger::Warn << "PSCAD - received unhandled message" << std::endl;
-            // bad header
+            ptime wait = microsec_clock::universal_time();
+            m_barrier->Wait();
+            m_barrierWait.RecordElapsed( wait );
         }
         
-        socket.close();
+        if( !period.is_zero() )
+        {
+            // a late step starts the next period from now
+            next += period;
+            now = microsec_clock::universal_time();
+            if( next > now )
+            {
+                boost::this_thread::sleep( next );
+            }
+            else
+            {
+                next = now;
+            }
+        }
+    }
+}
+
+void CSimulationServer::RunStats()
+{
+    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    
+    try
+    {
+        while( !m_quit )
+        {
+            boost::this_thread::sleep( boost::posix_time::seconds(m_options.m_statsPeriod) );
+            Logger::Notice << "Stats: " << m_metrics.Format() << std::endl;
+        }
+    }
+    catch( boost::thread_interrupted & )
+    {
+        // the server is shutting down
     }
 }
 
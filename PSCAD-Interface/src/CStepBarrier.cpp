@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CStepBarrier.cpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @see            CStepBarrier.hpp
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CStepBarrier.hpp"
+
+namespace freedm {
+namespace simulation {
+
+CStepBarrier::CStepBarrier( size_t p_count, long p_timeout )
+    : m_published(0), m_released(0), m_acked(p_count+1, 0)
+    , m_registered(p_count+1, false), m_timeout(boost::posix_time::milliseconds(p_timeout))
+{
+    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+}
+
+void CStepBarrier::Acknowledge( size_t p_index, boost::uint64_t p_version )
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    
+    if( p_index == 0 || p_index >= m_acked.size() )
+    {
+        return;
+    }
+    
+    if( !m_registered[p_index] )
+    {
+        Logger::Notice << "SST " << p_index << " joined the lockstep barrier" << std::endl;
+        m_registered[p_index] = true;
+    }
+    m_acked[p_index] = std::max( m_acked[p_index], p_version );
+    m_changed.notify_all();
+}
+
+void CStepBarrier::Publish( boost::uint64_t p_version )
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_published = std::max( m_published, p_version );
+    m_changed.notify_all();
+}
+
+bool CStepBarrier::Wait()
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    boost::system_time deadline = boost::get_system_time() + m_timeout;
+    
+    while( !Complete() )
+    {
+        if( !m_changed.timed_wait(lock, deadline) && !Complete() )
+        {
+            // drop the late SST so they cannot stall every later step
+            for( size_t i = 1; i < m_acked.size(); i++ )
+            {
+                if( m_registered[i] && m_acked[i] < m_published )
+                {
+                    Logger::Warn << "SST " << i << " missed step " << m_published
+                        << " and left the lockstep barrier" << std::endl;
+                    m_registered[i] = false;
+                }
+            }
+            m_released = m_published;
+            return false;
+        }
+    }
+    
+    m_released = m_published;
+    return true;
+}
+
+bool CStepBarrier::Complete() const
+{
+    if( m_published <= m_released )
+    {
+        return false;
+    }
+    
+    for( size_t i = 1; i < m_acked.size(); i++ )
+    {
+        if( m_registered[i] && m_acked[i] < m_published )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace simulation
+} // namespace freedm
@@ -0,0 +1,322 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CTableLayout.cpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @see            CTableLayout.hpp
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CTableLayout.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace freedm {
+namespace simulation {
+
+/// 64-bit FNV-1a hash of p_contents
+static boost::uint64_t HashContents( const std::string & p_contents )
+{
+    // the constants are built from 32-bit halves since C++98 has no long long
+    const boost::uint64_t prime = (boost::uint64_t(0x00000100u) << 32) | 0x000001B3u;
+    boost::uint64_t hash = (boost::uint64_t(0xCBF29CE4u) << 32) | 0x84222325u;
+    
+    for( size_t i = 0; i < p_contents.size(); i++ )
+    {
+        hash ^= static_cast<unsigned char>(p_contents[i]);
+        hash *= prime;
+    }
+    return hash;
+}
+
+/// copies p_bytes from the cache at p_offset, false past its end
+static bool Take( const char * p_data, size_t p_size, size_t & p_offset, void * p_out,
+    size_t p_bytes )
+{
+    if( p_bytes > p_size - p_offset )
+    {
+        return false;
+    }
+    std::memcpy( p_out, p_data + p_offset, p_bytes );
+    p_offset += p_bytes;
+    return true;
+}
+
+/// reads a length and that many characters from the cache
+static bool TakeString( const char * p_data, size_t p_size, size_t & p_offset,
+    std::string & p_out )
+{
+    boost::uint32_t length;
+    
+    if( !Take( p_data, p_size, p_offset, &length, sizeof(length) ) ||
+        length > p_size - p_offset )
+    {
+        return false;
+    }
+    p_out.assign( p_data + p_offset, length );
+    p_offset += length;
+    return true;
+}
+
+/// appends the bytes of p_value to p_out
+template <typename T>
+static void Put( std::string & p_out, T p_value )
+{
+    p_out.append( reinterpret_cast<const char *>(&p_value), sizeof(p_value) );
+}
+
+/// appends a length and the characters of p_value to p_out
+static void PutString( std::string & p_out, const std::string & p_value )
+{
+    Put( p_out, static_cast<boost::uint32_t>(p_value.size()) );
+    p_out.append( p_value );
+}
+
+CTableLayout::CTableLayout( const std::string & p_xml, const std::string & p_cache )
+    : m_SSTCount(0), m_cached(false)
+{
+    Logger::Info << __PRETTY_FUNCTION__ << std::endl;
+    
+    std::ifstream file( p_xml.c_str(), std::ios::binary );
+    if( !file )
+    {
+        throw std::runtime_error("cannot read XML input file " + p_xml);
+    }
+    
+    // the hash covers the exact bytes the layout is parsed from
+    std::string contents( (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>() );
+    boost::uint64_t hash = HashContents( contents );
+    
+    if( !p_cache.empty() && LoadCache( p_cache, hash ) )
+    {
+        m_cached = true;
+        Logger::Notice << "Read the table layout from " << p_cache << std::endl;
+        return;
+    }
+    
+    Parse( contents );
+    
+    if( !p_cache.empty() && !SaveCache( p_cache, hash ) )
+    {
+        Logger::Warn << "Cannot write the table layout cache " << p_cache << std::endl;
+    }
+}
+
+const std::vector<CTableLayout::SEntry> & CTableLayout::GetTable( const std::string & p_tag ) const
+{
+    TTableMap::const_iterator it = m_tables.find( p_tag );
+    
+    if( it == m_tables.end() )
+    {
+        throw std::out_of_range("the XML input file has no table " + p_tag);
+    }
+    return it->second;
+}
+
+void CTableLayout::Parse( const std::string & p_contents )
+{
+    using boost::property_tree::ptree;
+    
+    std::istringstream input( p_contents );
+    boost::optional<size_t> parent;
+    std::stringstream error;
+    ptree xmlTree;
+    size_t index;
+    
+    // create property tree from the XML input
+    read_xml( input, xmlTree );
+    
+    // get the number of sst for input validation
+    m_SSTCount = xmlTree.get<size_t>("SSTCount");
+    
+    // every element with entries is a table
+    BOOST_FOREACH( ptree::value_type & table, xmlTree )
+    {
+        const std::string & tag = table.first;
+        
+        if( table.second.count("entry") == 0 )
+        {
+            continue;
+        }
+        
+        std::vector<SEntry> & entries = m_tables[tag];
+        std::vector<bool> seen( table.second.size(), false );
+        entries.resize( table.second.size() );
+        
+        BOOST_FOREACH( ptree::value_type & child, table.second )
+        {
+            index   = child.second.get<size_t>("<xmlattr>.index");
+            parent  = child.second.get_optional<size_t>("parent");
+            
+            // validate the element index
+            if( index == 0 || index > entries.size() )
+            {
+                error << tag << " has an entry with index " << index;
+                throw std::out_of_range( error.str() );
+            }
+            
+            // prevent duplicate element indexes
+            if( seen[index-1] )
+            {
+                error << tag << " has multiple entries with index " << index;
+                throw std::logic_error( error.str() );
+            }
+            
+            // validate the parent index if a parent is specified
+            if( parent && (parent.get() == 0 || parent.get() > m_SSTCount) )
+            {
+                error << tag << " has a parent with index " << parent.get();
+                throw std::out_of_range( error.str() );
+            }
+            
+            SEntry & entry = entries[index-1];
+            entry.m_device = child.second.get<std::string>("device");
+            entry.m_key = child.second.get<std::string>("key");
+            entry.m_parent = parent ? parent.get() : 0;
+            seen[index-1] = true;
+        }
+    }
+}
+
+bool CTableLayout::ReadCache( const char * p_data, size_t p_size, boost::uint64_t p_hash )
+{
+    boost::uint32_t magic, version, sstCount, tableCount, entryCount, parent;
+    boost::uint64_t hash;
+    size_t offset = 0;
+    std::string tag;
+    
+    if( !Take( p_data, p_size, offset, &magic, sizeof(magic) ) || magic != MAGIC ||
+        !Take( p_data, p_size, offset, &version, sizeof(version) ) || version != VERSION ||
+        !Take( p_data, p_size, offset, &hash, sizeof(hash) ) || hash != p_hash ||
+        !Take( p_data, p_size, offset, &sstCount, sizeof(sstCount) ) ||
+        !Take( p_data, p_size, offset, &tableCount, sizeof(tableCount) ) )
+    {
+        return false;
+    }
+    
+    m_SSTCount = sstCount;
+    for( boost::uint32_t i = 0; i < tableCount; i++ )
+    {
+        if( !TakeString( p_data, p_size, offset, tag ) ||
+            !Take( p_data, p_size, offset, &entryCount, sizeof(entryCount) ) ||
+            entryCount > p_size - offset )
+        {
+            return false;
+        }
+        
+        std::vector<SEntry> & entries = m_tables[tag];
+        entries.resize( entryCount );
+        for( boost::uint32_t j = 0; j < entryCount; j++ )
+        {
+            if( !Take( p_data, p_size, offset, &parent, sizeof(parent) ) ||
+                parent > m_SSTCount ||
+                !TakeString( p_data, p_size, offset, entries[j].m_device ) ||
+                !TakeString( p_data, p_size, offset, entries[j].m_key ) )
+            {
+                return false;
+            }
+            entries[j].m_parent = parent;
+        }
+    }
+    
+    return offset == p_size;
+}
+
+bool CTableLayout::LoadCache( const std::string & p_cache, boost::uint64_t p_hash )
+{
+    struct stat status;
+    void * address;
+    bool loaded;
+    int fd;
+    
+    fd = open( p_cache.c_str(), O_RDONLY );
+    if( fd == -1 )
+    {
+        return false;
+    }
+    
+    if( fstat( fd, &status ) == -1 || status.st_size == 0 )
+    {
+        close( fd );
+        return false;
+    }
+    
+    address = mmap( 0, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close( fd );
+    if( address == MAP_FAILED )
+    {
+        return false;
+    }
+    
+    loaded = ReadCache( static_cast<const char *>(address), status.st_size, p_hash );
+    munmap( address, status.st_size );
+    
+    if( !loaded )
+    {
+        // a partial read must not leak into the parsed layout
+        m_tables.clear();
+        m_SSTCount = 0;
+        Logger::Notice << "The table layout cache " << p_cache << " is out of date"
+            << std::endl;
+    }
+    return loaded;
+}
+
+bool CTableLayout::SaveCache( const std::string & p_cache, boost::uint64_t p_hash ) const
+{
+    std::string temporary = p_cache + ".tmp";
+    TTableMap::const_iterator it;
+    std::string data;
+    
+    Put( data, MAGIC );
+    Put( data, VERSION );
+    Put( data, p_hash );
+    Put( data, static_cast<boost::uint32_t>(m_SSTCount) );
+    Put( data, static_cast<boost::uint32_t>(m_tables.size()) );
+    
+    for( it = m_tables.begin(); it != m_tables.end(); it++ )
+    {
+        PutString( data, it->first );
+        Put( data, static_cast<boost::uint32_t>(it->second.size()) );
+        for( size_t i = 0; i < it->second.size(); i++ )
+        {
+            Put( data, static_cast<boost::uint32_t>(it->second[i].m_parent) );
+            PutString( data, it->second[i].m_device );
+            PutString( data, it->second[i].m_key );
+        }
+    }
+    
+    // a rename replaces the cache at once for servers that start meanwhile
+    {
+        std::ofstream file( temporary.c_str(), std::ios::binary | std::ios::trunc );
+        if( !file || !file.write( data.data(), data.size() ) )
+        {
+            return false;
+        }
+    }
+    return std::rename( temporary.c_str(), p_cache.c_str() ) == 0;
+}
+
+} // namespace simulation
+} // namespace freedm
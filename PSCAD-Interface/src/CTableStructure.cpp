@@ -31,48 +31,31 @@ namespace simulation {
 
 CTableStructure::CTableStructure( const std::string & p_xml, const std::string & p_tag )
 {
-    using boost::property_tree::ptree;
-    
-    boost::optional<size_t> parent;
+    // a layout without a cache parses the XML input file directly
+    CTableLayout layout( p_xml, "" );
+    Build( layout, p_tag );
+}
+
+CTableStructure::CTableStructure( const CTableLayout & p_layout, const std::string & p_tag )
+{
+    Build( p_layout, p_tag );
+}
+
+void CTableStructure::Build( const CTableLayout & p_layout, const std::string & p_tag )
+{
+    const std::vector<CTableLayout::SEntry> & entries = p_layout.GetTable( p_tag );
     std::stringstream error;
-    std::string device;
-    std::string key;
-    ptree xmlTree;
-    size_t index;
-    size_t nsst;
     
-    // create property tree from the XML input
-    read_xml( p_xml, xmlTree );
+    // the layout has validated the indexes and parents
+    m_SSTCount = p_layout.GetSSTCount();
+    m_TableSize = entries.size();
     
-    // get the number of sst for input validation
-    nsst = xmlTree.get<size_t>("SSTCount");
-
-    // each child of p_tag is a table entry
-    m_TableSize = xmlTree.get_child(p_tag).size();
-    BOOST_FOREACH( ptree::value_type & child, xmlTree.get_child(p_tag) )
+    // one row of access bits per entry, one column per sst
+    m_Access.assign( m_TableSize * m_SSTCount, false );
+    for( size_t index = 0; index < m_TableSize; index++ )
     {
-        index   = child.second.get<size_t>("<xmlattr>.index");
-        device  = child.second.get<std::string>("device");
-        key     = child.second.get<std::string>("key");
-        parent  = child.second.get_optional<size_t>("parent");
-        
-        // create the data structures
-        CDeviceKey dkey( device, key );
-        std::set<size_t> plist;
-        
-        // validate the element index
-        if( index == 0 || index > m_TableSize )
-        {
-            error << p_tag << " has an entry with index " << index;
-            throw std::out_of_range( error.str() );
-        }
-        
-        // prevent duplicate element indexes
-        if( m_DeviceIndex.by<SIndex>().count(index) > 0 )
-        {
-            error << p_tag << " has multiple entries with index " << index;
-            throw std::logic_error( error.str() );
-        }
+        const CTableLayout::SEntry & entry = entries[index];
+        CDeviceKey dkey( entry.m_device, entry.m_key );
         
         // prevent duplicate device keys
         if( m_DeviceIndex.by<SDevice>().count(dkey) > 0 )
@@ -81,31 +64,23 @@ CTableStructure::CTableStructure( const std::string & p_xml, const std::string &
             throw std::logic_error( error.str() );
         }
         
-        // validate the parent index if a parent is specified
-        if( parent && (parent.get() == 0 || parent.get() > nsst) )
-        {
-            error << p_tag << " has a parent with index " << parent.get();
-            throw std::out_of_range( error.str() );
-        }
-
-        // initialize the parent list
-        if( parent )
+        // compile the parent into the access bitmap
+        if( entry.m_parent != 0 )
         {
             // if parent specified, use parent
-            plist.insert(parent.get());
+            m_Access[index * m_SSTCount + entry.m_parent - 1] = true;
         }
         else
         {
             // if parent not specified, universal access
-            for( size_t i = nsst; i > 0; i-- )
+            for( size_t i = 0; i < m_SSTCount; i++ )
             {
-                plist.insert(i);
+                m_Access[index * m_SSTCount + i] = true;
             }
         }
-
+        
         // store the table entry
-        m_DeviceIndex.insert( TBimap::value_type(dkey,index-1) );
-        m_DeviceParent.insert( std::map< CDeviceKey, std::set<size_t> >::value_type(dkey,plist) );
+        m_DeviceIndex.insert( TBimap::value_type(dkey,index) );
     }
 }
 
@@ -123,15 +98,15 @@ const CDeviceKey & CTableStructure::FindDevice( size_t p_index ) const
 
 bool CTableStructure::HasAccess( const CDeviceKey & p_dkey, size_t p_parent ) const
 {
-    std::map< CDeviceKey, std::set<size_t> >::const_iterator it;
+    TBimap::map_by<SDevice>::const_iterator it;
     
     // search the table for p_dkey
-    it = m_DeviceParent.find(p_dkey);
+    it = m_DeviceIndex.by<SDevice>().find(p_dkey);
     
-    if( it != m_DeviceParent.end() )
+    if( it != m_DeviceIndex.by<SDevice>().end() )
     {
-        // search the parent list for p_parent
-        return( it->second.count(p_parent) > 0 );
+        // test the access bit for p_parent
+        return HasAccess( it->get<SIndex>(), p_parent );
     }
     else
     {
@@ -140,5 +115,36 @@ bool CTableStructure::HasAccess( const CDeviceKey & p_dkey, size_t p_parent ) co
     }
 }
 
+bool CTableStructure::HasAccess( size_t p_index, size_t p_parent ) const
+{
+    // reject unknown entries and parents before indexing the bitmap
+    if( p_index >= m_TableSize || p_parent == 0 || p_parent > m_SSTCount )
+    {
+        return false;
+    }
+    
+    return m_Access[p_index * m_SSTCount + p_parent - 1];
+}
+
+size_t CTableStructure::FindParent( size_t p_index ) const
+{
+    size_t parent = 0;
+    
+    for( size_t i = 1; i <= m_SSTCount; i++ )
+    {
+        if( HasAccess( p_index, i ) )
+        {
+            if( parent != 0 )
+            {
+                // shared entries have no single parent
+                return 0;
+            }
+            parent = i;
+        }
+    }
+    
+    return parent;
+}
+
 } // namespace simulation
 } // namespace freedm
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           CTraceRing.cpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+/// @see            CTraceRing.hpp
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CTraceRing.hpp"
+
+#include <ctime>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace freedm {
+namespace simulation {
+
+boost::scoped_array<CTraceRing::SRecord> CTraceRing::s_records;
+size_t CTraceRing::s_capacity = 0;
+boost::uint64_t CTraceRing::s_next = 0;
+
+void CTraceRing::Enable( size_t p_capacity )
+{
+    if( p_capacity == 0 )
+    {
+        throw std::invalid_argument("trace ring must hold at least one record");
+    }
+    if( !IsEnabled() )
+    {
+        s_records.reset( new SRecord[p_capacity] );
+        s_capacity = p_capacity;
+        Logger::Notice << "Tracing the last " << p_capacity << " requests" << std::endl;
+    }
+}
+
+void CTraceRing::Record( EPoint p_point, boost::uint32_t p_index, double p_value )
+{
+    struct timespec now;
+    
+    // each thread claims its own slot, so no lock is needed
+    boost::uint64_t slot = __sync_fetch_and_add( &s_next, 1 );
+    SRecord & record = s_records[static_cast<size_t>(slot % s_capacity)];
+    
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    record.m_time = static_cast<boost::uint64_t>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+    record.m_point = p_point;
+    record.m_index = p_index;
+    record.m_value = p_value;
+}
+
+void CTraceRing::Dump( const std::string & p_filename )
+{
+    std::ofstream file( p_filename.c_str(), std::ios::binary | std::ios::trunc );
+    size_t total = static_cast<size_t>(__sync_fetch_and_add( &s_next, 0 ));
+    size_t count = std::min( total, s_capacity );
+    boost::uint32_t header[3];
+    
+    if( !file )
+    {
+        throw std::runtime_error("cannot create trace file " + p_filename);
+    }
+    
+    header[0] = MAGIC;
+    header[1] = VERSION;
+    header[2] = static_cast<boost::uint32_t>(count);
+    file.write( reinterpret_cast<const char *>(header), sizeof(header) );
+    
+    // the oldest record follows the newest once the ring has wrapped
+    for( size_t i = total - count; i < total; i++ )
+    {
+        file.write( reinterpret_cast<const char *>(&s_records[i % s_capacity]),
+            sizeof(SRecord) );
+    }
+    
+    Logger::Notice << "Wrote " << count << " of " << total << " trace records to "
+        << p_filename << std::endl;
+}
+
+} // namespace simulation
+} // namespace freedm
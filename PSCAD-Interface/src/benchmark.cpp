@@ -0,0 +1,449 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file           benchmark.cpp
+///
+/// @author         Thomas Roth <tprfh7@mst.edu>
+///
+/// @compiler       C++
+///
+/// @project        Missouri S&T Power Research Group
+///
+///     Load generator that measures the request latency of the simulation
+///     server and of its DGI-Interfaces.
+///
+/// @functions
+///     RunSession( const SSessionPlan &, SResult & )
+///     RunSimulation( const SSimulationPlan &, SResult & )
+///     PrintLatency( const string &, vector<double> &, double )
+///
+///
+/// These source code files were created at the Missouri University of Science
+/// and Technology, and are intended for use in teaching or research. They may
+/// be freely copied, modified and redistributed as long as modified versions
+/// are clearly marked as such and this notice is not removed.
+///
+/// Neither the authors nor Missouri S&T make any warranty, express or implied,
+/// nor assume any legal responsibility for the accuracy, completeness or
+/// usefulness of these files or any information distributed with these files.
+///
+/// Suggested modifications or questions about these files can be directed to
+/// Dr. Bruce McMillin, Department of Computer Science, Missouri University of
+/// Science and Technology, Rolla, MO 65401 <ff@mst.edu>.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+
+#include <boost/asio.hpp>
+#include <boost/thread.hpp>
+#include <boost/program_options.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include "logger.hpp"
+#include "CDeviceKey.hpp"
+#include "CTableStructure.hpp"
+
+using namespace freedm::simulation;
+using boost::asio::ip::tcp;
+namespace po = boost::program_options;
+namespace pt = boost::posix_time;
+
+CREATE_STD_LOGS()
+
+/// size of the header of a simulation request
+static const size_t HEADER_SIZE = 5;
+
+/// latencies in microseconds measured by one thread
+struct SResult
+{
+    std::vector<double> m_get;
+    std::vector<double> m_set;
+    size_t m_errors;
+};
+
+/// requests one line protocol session sends to an interface port
+struct SSessionPlan
+{
+    std::string m_host;
+    unsigned short m_port;
+    std::vector<CDeviceKey> m_state;    // keys the session reads
+    std::vector<CDeviceKey> m_command;  // keys the session writes
+    size_t m_setPeriod;                 // one request in m_setPeriod is a SET
+    pt::ptime m_end;
+};
+
+/// requests the synthetic simulation sends to the simulation port
+struct SSimulationPlan
+{
+    std::string m_host;
+    unsigned short m_port;
+    size_t m_state;                     // length of the state table
+    size_t m_command;                   // length of the command table
+    pt::ptime m_end;
+};
+
+/// microseconds since p_start
+double Elapsed( const pt::ptime & p_start )
+{
+    return static_cast<double>(
+        (pt::microsec_clock::universal_time() - p_start).total_microseconds() );
+}
+
+/// sends one text request and returns its response line
+std::string Request( tcp::socket & p_socket, boost::asio::streambuf & p_buffer,
+    const std::string & p_request )
+{
+    std::istream stream( &p_buffer );
+    std::string line;
+    
+    boost::asio::write( p_socket, boost::asio::buffer(p_request) );
+    boost::asio::read_until( p_socket, p_buffer, "\r\n" );
+    std::getline( stream, line );
+    return line;
+}
+
+/// connects a socket to a server port
+void Connect( tcp::socket & p_socket, const std::string & p_host, unsigned short p_port )
+{
+    tcp::endpoint endpoint( boost::asio::ip::address::from_string(p_host), p_port );
+    p_socket.connect( endpoint );
+    p_socket.set_option( tcp::no_delay(true) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// RunSession( const SSessionPlan &, SResult & )
+///
+/// @description
+///     Sends GET and SET requests on one line protocol session until the end
+///     of the plan, cycling through the device keys of the plan.
+///
+/// @Error_Handling
+///     A response other than 200 OK is counted as an error. A broken
+///     connection ends the session and is counted as an error.
+///
+/// @param
+///     p_plan lists the port, keys and request mix of the session
+///     p_result receives the latency of each request
+///
+////////////////////////////////////////////////////////////////////////////////
+void RunSession( const SSessionPlan & p_plan, SResult & p_result )
+{
+    boost::asio::io_service service;
+    tcp::socket socket( service );
+    boost::asio::streambuf buffer;
+    std::ostringstream request;
+    pt::ptime start;
+    size_t count = 0;
+    
+    try
+    {
+        Connect( socket, p_plan.m_host, p_plan.m_port );
+        
+        while( pt::microsec_clock::universal_time() < p_plan.m_end )
+        {
+            bool set = !p_plan.m_command.empty() && p_plan.m_setPeriod > 0 &&
+                count % p_plan.m_setPeriod == 0;
+            
+            request.str("");
+            if( set )
+            {
+                const CDeviceKey & dkey = p_plan.m_command[count % p_plan.m_command.size()];
+                request << "SET " << dkey.GetDevice() << " " << dkey.GetKey() << " 0\r\n";
+            }
+            else if( !p_plan.m_state.empty() )
+            {
+                const CDeviceKey & dkey = p_plan.m_state[count % p_plan.m_state.size()];
+                request << "GET " << dkey.GetDevice() << " " << dkey.GetKey() << "\r\n";
+            }
+            else
+            {
+                break;
+            }
+            
+            start = pt::microsec_clock::universal_time();
+            if( Request( socket, buffer, request.str() ).compare(0, 3, "200") != 0 )
+            {
+                p_result.m_errors++;
+            }
+            ( set ? p_result.m_set : p_result.m_get ).push_back( Elapsed(start) );
+            count++;
+        }
+        
+        Request( socket, buffer, "QUIT\r\n" );
+    }
+    catch( std::exception & e )
+    {
+        Logger::Warn << "Session on port " << p_plan.m_port << " failed: " << e.what()
+            << std::endl;
+        p_result.m_errors++;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// RunSimulation( const SSimulationPlan &, SResult & )
+///
+/// @description
+///     Acts as PSCAD: sends a full state table and requests the command table
+///     until the end of the plan, as fast as the server answers.
+///
+/// @Error_Handling
+///     A broken connection ends the simulation and is counted as an error.
+///
+/// @param
+///     p_plan lists the port and table lengths of the simulation
+///     p_result receives the latency of each SET and GET
+///
+////////////////////////////////////////////////////////////////////////////////
+void RunSimulation( const SSimulationPlan & p_plan, SResult & p_result )
+{
+    boost::asio::io_service service;
+    tcp::socket socket( service );
+    std::vector<char> set( HEADER_SIZE + p_plan.m_state*sizeof(double), 0 );
+    std::vector<char> get( HEADER_SIZE, 0 );
+    std::vector<double> command( p_plan.m_command );
+    pt::ptime start;
+    double step = 0;
+    
+    std::copy( "SET", "SET" + 3, set.begin() );
+    std::copy( "GET", "GET" + 3, get.begin() );
+    
+    try
+    {
+        Connect( socket, p_plan.m_host, p_plan.m_port );
+        
+        while( pt::microsec_clock::universal_time() < p_plan.m_end )
+        {
+            // every state value changes on every step
+            for( size_t i = 0; i < p_plan.m_state; i++ )
+            {
+                double value = step + i;
+                std::copy( reinterpret_cast<char *>(&value),
+                    reinterpret_cast<char *>(&value) + sizeof(value),
+                    set.begin() + HEADER_SIZE + i*sizeof(double) );
+            }
+            step++;
+            
+            start = pt::microsec_clock::universal_time();
+            boost::asio::write( socket, boost::asio::buffer(set) );
+            p_result.m_set.push_back( Elapsed(start) );
+            
+            start = pt::microsec_clock::universal_time();
+            boost::asio::write( socket, boost::asio::buffer(get) );
+            if( !command.empty() )
+            {
+                boost::asio::read( socket, boost::asio::buffer(command) );
+            }
+            p_result.m_get.push_back( Elapsed(start) );
+        }
+    }
+    catch( std::exception & e )
+    {
+        Logger::Warn << "Simulation on port " << p_plan.m_port << " failed: " << e.what()
+            << std::endl;
+        p_result.m_errors++;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// PrintLatency( const string &, vector<double> &, double )
+///
+/// @description
+///     Prints the throughput and latency percentiles of one request type.
+///
+/// @param
+///     p_name labels the output line
+///     p_latency lists the latencies in microseconds, sorted on return
+///     p_seconds is the length of the run
+///
+////////////////////////////////////////////////////////////////////////////////
+void PrintLatency( const std::string & p_name, std::vector<double> & p_latency,
+    double p_seconds )
+{
+    const double percentile[] = { 0.50, 0.90, 0.99, 0.999 };
+    
+    std::cout << std::left << std::setw(16) << p_name << std::right
+        << std::setw(10) << p_latency.size()
+        << std::setw(12) << std::fixed << std::setprecision(0)
+        << p_latency.size() / p_seconds;
+    
+    if( p_latency.empty() )
+    {
+        std::cout << std::endl;
+        return;
+    }
+    
+    std::sort( p_latency.begin(), p_latency.end() );
+    for( size_t i = 0; i < 4; i++ )
+    {
+        size_t rank = static_cast<size_t>( std::ceil(percentile[i] * p_latency.size()) );
+        std::cout << std::setw(10) << p_latency[std::max<size_t>(rank,1) - 1];
+    }
+    std::cout << std::setw(10) << p_latency.back() << std::endl;
+}
+
+/// appends every element of p_from to p_to
+void Merge( std::vector<double> & p_to, const std::vector<double> & p_from )
+{
+    p_to.insert( p_to.end(), p_from.begin(), p_from.end() );
+}
+
+int main( int argc, char * argv[] )
+{
+    std::string xml, host;
+    unsigned short port;
+    size_t sessions, setPeriod;
+    double seconds;
+    bool simulation;
+    int verbose;
+    
+    po::options_description desc("Options");
+    desc.add_options()
+        ("help,h", "print this message")
+        ("verbose,v", po::value<int>(&verbose)->default_value(4),
+            "logger verbosity level")
+        ("xml", po::value<std::string>(&xml)->default_value("xml"),
+            "XML table specification of the server")
+        ("host", po::value<std::string>(&host)->default_value("127.0.0.1"),
+            "address of the simulation server")
+        ("port", po::value<unsigned short>(&port)->default_value(4000),
+            "simulation port, interface i listens on port+i")
+        ("sessions", po::value<size_t>(&sessions)->default_value(4),
+            "concurrent line protocol sessions per interface")
+        ("set-period", po::value<size_t>(&setPeriod)->default_value(10),
+            "one request in this many is a SET, 0 for only GET requests")
+        ("seconds", po::value<double>(&seconds)->default_value(10),
+            "length of the run")
+        ("simulation", po::bool_switch(&simulation),
+            "also drive the simulation port as PSCAD would");
+    
+    po::variables_map vm;
+    po::store( po::parse_command_line(argc, argv, desc), vm );
+    po::notify(vm);
+    
+    if( vm.count("help") )
+    {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+    
+    Logger::Log::setLevel(verbose);
+    
+    CTableStructure state( xml, "state" );
+    CTableStructure command( xml, "command" );
+    size_t sstCount = state.GetSSTCount();
+    pt::ptime end = pt::microsec_clock::universal_time() +
+        pt::microseconds( static_cast<long>(seconds * 1e6) );
+    
+    std::vector<SSessionPlan> plans( sstCount * sessions );
+    std::vector<SResult> results( plans.size() + 1 );
+    boost::thread_group threads;
+    
+    for( size_t sst = 1; sst <= sstCount; sst++ )
+    {
+        SSessionPlan plan;
+        plan.m_host = host;
+        plan.m_port = port + sst;
+        plan.m_setPeriod = setPeriod;
+        plan.m_end = end;
+        
+        // each interface serves only the keys its sst has access to
+        for( size_t i = 0; i < state.GetSize(); i++ )
+        {
+            if( state.HasAccess(i, sst) )
+            {
+                plan.m_state.push_back( state.FindDevice(i) );
+            }
+        }
+        for( size_t i = 0; i < command.GetSize(); i++ )
+        {
+            if( command.HasAccess(i, sst) )
+            {
+                plan.m_command.push_back( command.FindDevice(i) );
+            }
+        }
+        
+        for( size_t i = 0; i < sessions; i++ )
+        {
+            size_t n = (sst-1) * sessions + i;
+            plans[n] = plan;
+            results[n].m_errors = 0;
+            threads.create_thread( boost::bind(RunSession, boost::cref(plans[n]),
+                boost::ref(results[n])) );
+        }
+    }
+    
+    SSimulationPlan simulationPlan;
+    simulationPlan.m_host = host;
+    simulationPlan.m_port = port;
+    simulationPlan.m_state = state.GetSize();
+    simulationPlan.m_command = command.GetSize();
+    simulationPlan.m_end = end;
+    results.back().m_errors = 0;
+    
+    if( simulation )
+    {
+        threads.create_thread( boost::bind(RunSimulation, boost::cref(simulationPlan),
+            boost::ref(results.back())) );
+    }
+    
+    threads.join_all();
+    
+    // the interface latencies are merged over every session
+    SResult total;
+    total.m_errors = 0;
+    for( size_t i = 0; i < plans.size(); i++ )
+    {
+        Merge( total.m_get, results[i].m_get );
+        Merge( total.m_set, results[i].m_set );
+        total.m_errors += results[i].m_errors;
+    }
+    
+    std::cout << sstCount << " interfaces, " << sessions << " sessions each, "
+        << seconds << " seconds, " << total.m_errors + results.back().m_errors
+        << " errors" << std::endl;
+    std::cout << std::left << std::setw(16) << "request" << std::right
+        << std::setw(10) << "count" << std::setw(12) << "per second"
+        << std::setw(10) << "p50 us" << std::setw(10) << "p90 us"
+        << std::setw(10) << "p99 us" << std::setw(10) << "p99.9 us"
+        << std::setw(10) << "max us" << std::endl;
+    PrintLatency( "interface GET", total.m_get, seconds );
+    PrintLatency( "interface SET", total.m_set, seconds );
+    if( simulation )
+    {
+        PrintLatency( "simulation SET", results.back().m_set, seconds );
+        PrintLatency( "simulation GET", results.back().m_get, seconds );
+    }
+    
+    // the lock waits and request counts are reported by the server itself
+    try
+    {
+        boost::asio::io_service service;
+        tcp::socket socket( service );
+        boost::asio::streambuf buffer;
+        std::string stats, pair;
+        
+        Connect( socket, host, port + 1 );
+        stats = Request( socket, buffer, "STATS\r\n" );
+        Request( socket, buffer, "QUIT\r\n" );
+        
+        // skip the status and print one metric per line
+        std::istringstream pairs( stats );
+        pairs >> pair >> pair;
+        std::cout << "server metrics:" << std::endl;
+        while( pairs >> pair )
+        {
+            std::cout << "  " << pair << std::endl;
+        }
+    }
+    catch( std::exception & e )
+    {
+        Logger::Warn << "No statistics from the server: " << e.what() << std::endl;
+    }
+    
+    return 0;
+}
@@ -26,25 +26,129 @@
 ///
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <iostream>
+#include <csignal>
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <boost/thread.hpp>
+#include <boost/program_options.hpp>
+
 #include "logger.hpp"
 #include "CSimulationServer.hpp"
 
 using namespace freedm::simulation;
+namespace po = boost::program_options;
 
 CREATE_STD_LOGS()
 
+// the server only returns at the end of a replay, so an interrupt also
+// dumps the trace before it ends the process. The server threads are still
+// running, so _exit skips the static destructors they may be using.
+void DumpOnSignal( sigset_t p_signals, std::string p_filename )
+{
+    int signal;
+    
+    if( sigwait( &p_signals, &signal ) == 0 )
+    {
+        CTraceRing::Dump(p_filename);
+        _exit(0);
+    }
+}
+
 int main(int argc, char * argv[] )
 {
-    if( argc > 1 )
+    SServerOptions options;
+    std::string trace;
+    size_t traceSize = 1<<20;
+    int verbose;
+    
+    po::options_description desc("Options");
+    desc.add_options()
+        ("help,h", "print this message")
+        ("verbose,v", po::value<int>(&verbose)->default_value(4),
+            "logger verbosity level")
+        ("xml", po::value<std::string>(&options.m_xml)->default_value(options.m_xml),
+            "XML table specification")
+        ("layout-cache", po::value<std::string>(&options.m_layoutCache),
+            "table layout cache, default <xml>.layout, empty to always parse the XML")
+        ("port", po::value<unsigned short>(&options.m_port)->default_value(options.m_port),
+            "simulation port, interface i listens on port+i")
+        ("shm", po::value<std::string>(&options.m_shm),
+            "shared memory segment for a simulation on this host, e.g. /freedm")
+        ("shm-poll", po::value<long>(&options.m_sharedPoll)->default_value(options.m_sharedPoll),
+            "microseconds between command table updates in shared memory")
+        ("lockstep", po::bool_switch(&options.m_lockstep),
+            "hold each command table until every SST has sent DONE")
+        ("lockstep-timeout", po::value<long>(&options.m_lockstepTimeout)->default_value(options.m_lockstepTimeout),
+            "milliseconds to wait for the SSTs in lockstep mode")
+        ("record", po::value<std::string>(&options.m_record),
+            "record every table exchanged with the simulation to a file")
+        ("replay", po::value<std::string>(&options.m_replay),
+            "replay a recorded file in place of the simulation")
+        ("replay-fast", po::bool_switch(&options.m_replayFast),
+            "replay without the recorded delays between steps")
+        ("replay-delay", po::value<long>(&options.m_replayDelay)->default_value(options.m_replayDelay),
+            "milliseconds to wait for the brokers before the replay starts")
+        ("model", po::bool_switch(&options.m_model),
+            "run the built-in microgrid model in place of the simulation")
+        ("model-rate", po::value<double>(&options.m_modelRate)->default_value(options.m_modelRate),
+            "model steps per second, 0 to step as fast as possible")
+        ("stats-period", po::value<long>(&options.m_statsPeriod)->default_value(options.m_statsPeriod),
+            "seconds between logged metrics, 0 to log none");
+#ifdef PSCAD_INTERFACE_TRACE
+    desc.add_options()
+        ("trace", po::value<std::string>(&trace),
+            "write the last traced requests to a binary file on exit")
+        ("trace-size", po::value<size_t>(&traceSize)->default_value(traceSize),
+            "number of trace records kept in memory");
+#endif
+    
+    // the verbosity level may also be given without its option name
+    po::positional_options_description positional;
+    positional.add("verbose", 1);
+    
+    po::variables_map vm;
+    po::store( po::command_line_parser(argc, argv).options(desc).positional(positional).run(), vm );
+    po::notify(vm);
+    
+    if( vm.count("help") )
+    {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+    
+    Logger::Log::setLevel(verbose);
+    
+    // the cache follows the XML file unless it is named explicitly
+    if( !vm.count("layout-cache") )
     {
-        Logger::Log::setLevel(boost::lexical_cast<int>(argv[1]));
+        options.m_layoutCache = options.m_xml + ".layout";
     }
-    else
+    
+    if( !trace.empty() )
     {
-        Logger::Log::setLevel(4);
+        sigset_t signals;
+        
+        // block the signals in every thread so that only one receives them
+        sigemptyset( &signals );
+        sigaddset( &signals, SIGINT );
+        sigaddset( &signals, SIGTERM );
+        pthread_sigmask( SIG_BLOCK, &signals, 0 );
+        
+        CTraceRing::Enable(traceSize);
+        boost::thread( DumpOnSignal, signals, trace ).detach();
     }
     
-    CSimulationServer bob("xml",4000);
+    {
+        CSimulationServer bob(options);
+    }
+    
+    if( !trace.empty() )
+    {
+        CTraceRing::Dump(trace);
+    }
     
     return 0;
 }